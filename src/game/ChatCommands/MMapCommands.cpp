@@ -240,6 +240,13 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
     MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
     PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
+    PathCacheStats cacheStats;
+    manager->GetPathCache().GetStats(cacheStats);
+    uint32 lookups = cacheStats.hits + cacheStats.misses;
+    PSendSysMessage(" path cache: %u/%u corridors, %u hits, %u misses (%.1f%% hit rate)", cacheStats.size, sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE),
+                    cacheStats.hits, cacheStats.misses, lookups ? cacheStats.hits * 100.0f / lookups : 0.0f);
+    PSendSysMessage(" path cache: %u evicted, %u invalidated by tile unloads", cacheStats.evicted, cacheStats.invalidated);
+
     const dtNavMesh* navmesh = manager->GetNavMesh(m_session->GetPlayer()->GetMapId());
     if (!navmesh)
     {
@@ -29,6 +29,11 @@
 #include "GitRevision.h"
 #include "SystemConfig.h"
 #include "UpdateTime.h"
+#include "MapManager.h"
+#include "Player.h"
+#include "DBCStores.h"
+#include "WorldSocket.h"
+#include "WorldSocketMgr.h"
 #include "revision_data.h"
 
  /**********************************************************************
@@ -74,6 +79,62 @@ bool ChatHandler::HandleServerInfoCommand(char* /*args*/)
     PSendSysMessage(LANG_UPTIME, str.c_str());
     PSendSysMessage("World Delay: %u", updateTime); // ToDo: move to language string
 
+    uint64 writeCalls, writePackets;
+    sWorldSocketMgr->GetWriteStats(writeCalls, writePackets);
+    PSendSysMessage("Network writes: " UI64FMTD " packets in " UI64FMTD " syscalls (%.2f per call, %s)", writePackets, writeCalls,
+                    writeCalls ? float(writePackets) / writeCalls : 0.0f, sWorldSocketMgr->IsBatchedWrites() ? "batched" : "unbatched"); // ToDo: move to language string
+
+    return true;
+}
+
+/// Display the update time of the most expensive maps, to see which one holds the map tick back
+bool ChatHandler::HandleServerMapUpdateCommand(char* args)
+{
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+    {
+        return false;
+    }
+
+    MapUpdateStatList stats;
+    sMapMgr.GetMapUpdateStats(stats);
+
+    PSendSysMessage("Last map tick: %.2f ms, %u maps updated, %u updates stolen by idle threads", // ToDo: move to language string
+                    sMapMgr.GetLastMapUpdateTime() / 1000.0f, uint32(stats.size()), sMapMgr.GetStolenMapUpdates());
+
+    for (MapUpdateStatList::const_iterator itr = stats.begin(); itr != stats.end() && limit; ++itr, --limit)
+    {
+        MapEntry const* mapEntry = sMapStore.LookupEntry(itr->mapId);
+        PSendSysMessage("Map %u (%s) instance %u: last %.2f ms, avg %.2f ms, max %.2f ms",
+                        itr->mapId, mapEntry ? mapEntry->name[GetSessionDbcLocale()] : "<unknown>", itr->instanceId,
+                        itr->lastTime / 1000.0f, itr->avgTime / 1000.0f, itr->maxTime / 1000.0f);
+    }
+
+    if (sMapMgr.GetGridPreloader().activated())
+    {
+        GridPreloadStats preload;
+        sMapMgr.GetGridPreloader().GetStats(preload);
+        uint32 used, expired;
+        TerrainInfo::GetPreloadStats(used, expired);
+
+        PSendSysMessage("Grid preload: %u queued, %u loaded, %u used, %u expired, %u already loaded, %u dropped", // ToDo: move to language string
+                        preload.queued, preload.loaded, used, expired, preload.skipped, preload.dropped);
+        PSendSysMessage("Grid preload latency: last %.2f ms, avg %.2f ms, max %.2f ms",
+                        preload.lastTime / 1000.0f, preload.avgTime / 1000.0f, preload.maxTime / 1000.0f);
+    }
+
+    if (Player* player = m_session ? m_session->GetPlayer() : NULL)
+    {
+        RelocationNotifyBatch const& batch = player->GetMap()->GetRelocationNotifyBatch();
+        RelocationNotifyStats const& last = batch.GetLastStats();
+        RelocationNotifyStats const& total = batch.GetTotalStats();
+
+        PSendSysMessage("Relocation notify on this map: last " UI64FMTD " units, " UI64FMTD " cells scanned instead of " UI64FMTD ", " UI64FMTD " pairs checked once", // ToDo: move to language string
+                        last.units, last.cellsScanned, last.cellVisits, last.pairsSkipped);
+        PSendSysMessage("Relocation notify on this map: total " UI64FMTD " units, " UI64FMTD " cell scans saved, " UI64FMTD " pairs checked once",
+                        total.units, total.cellVisits - total.cellsScanned, total.pairsSkipped);
+    }
+
     return true;
 }
 
@@ -0,0 +1,359 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "GridPreloader.h"
+#include "GridMap.h"
+#include "Map.h"
+#include "Player.h"
+#include "World.h"
+#include "MapTree.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    /// Requests beyond this are dropped, the map thread loads the grid itself then.
+    const size_t MAX_QUEUED_GRIDS = 256;
+
+    uint64 NowMicroseconds()
+    {
+        return uint64(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Reads a file once, so that the following load is served from the file cache.
+     * @param fileName File to be read, missing files are ignored.
+     */
+    void WarmFile(std::string const& fileName)
+    {
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (!file)
+        {
+            return;
+        }
+
+        char buffer[64 * 1024];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+            {}
+
+        fclose(file);
+    }
+}
+
+/**
+ * @brief Constructor for GridPreloader.
+ */
+GridPreloader::GridPreloader() :
+m_mutex(), m_workCondition(m_mutex), m_lookAhead(0), m_shutdown(false), m_activated(false)
+{
+}
+
+/**
+ * @brief Destructor for GridPreloader.
+ */
+GridPreloader::~GridPreloader()
+{
+    deactivate();
+}
+
+/**
+ * @brief Activates the preloader with the specified number of threads.
+ * @param num_threads Number of threads to activate.
+ * @param lookAhead How far ahead a moving player is predicted, in milliseconds.
+ * @return Result of the activation.
+ */
+int GridPreloader::activate(size_t num_threads, uint32 lookAhead)
+{
+    if (m_activated || num_threads < 1)
+    {
+        return -1;
+    }
+
+    m_shutdown = false;
+    m_lookAhead = lookAhead;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, (int)num_threads) == -1)
+    {
+        return -1;
+    }
+
+    m_activated = true;
+    return 0;
+}
+
+/**
+ * @brief Deactivates the preloader, queued grids are discarded.
+ * @return Result of the deactivation.
+ */
+int GridPreloader::deactivate()
+{
+    if (!m_activated)
+    {
+        return -1;
+    }
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        m_shutdown = true;
+
+        for (std::deque<Job>::const_iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+        {
+            if (itr->terrain->Release())
+            {
+                sTerrainMgr.UnloadTerrain(itr->terrain->GetMapId());
+            }
+        }
+
+        m_jobs.clear();
+        m_queued.clear();
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    m_activated = false;
+    return 0;
+}
+
+/**
+ * @brief Queues the grid a moving player will reach next, if it is not loaded yet.
+ *
+ * The player is assumed to keep its direction and speed for the look ahead
+ * time. Grids are loaded by the map once they come into visibility range,
+ * so the prediction starts at the visibility distance in front of the player.
+ * @param terrain Terrain of the map the player is on.
+ * @param player Player which has been relocated.
+ */
+void GridPreloader::predict(TerrainInfo* terrain, Player const* player)
+{
+    if (!m_activated || player->IsTaxiFlying())
+    {
+        return;
+    }
+
+    // direction of the movement relative to the orientation
+    int forward = player->HasMovementFlag(MOVEFLAG_FORWARD) ? 1 : (player->HasMovementFlag(MOVEFLAG_BACKWARD) ? -1 : 0);
+    int strafe = player->HasMovementFlag(MOVEFLAG_STRAFE_LEFT) ? 1 : (player->HasMovementFlag(MOVEFLAG_STRAFE_RIGHT) ? -1 : 0);
+    if (!forward && !strafe)
+    {
+        return;
+    }
+
+    UnitMoveType moveType = MOVE_RUN;
+    if (player->IsInWater())
+    {
+        moveType = forward < 0 ? MOVE_SWIM_BACK : MOVE_SWIM;
+    }
+    else if (player->IsWalking())
+    {
+        moveType = MOVE_WALK;
+    }
+    else if (forward < 0)
+    {
+        moveType = MOVE_RUN_BACK;
+    }
+
+    float angle = player->GetOrientation() + atan2(float(strafe), float(forward));
+    float dirX = cos(angle);
+    float dirY = sin(angle);
+
+    float start = player->GetMap()->GetVisibilityDistance();
+    float end = start + player->GetSpeed(moveType) * m_lookAhead / IN_MILLISECONDS;
+
+    // sample the path at half grid steps, fast movers may cross more than one grid
+    for (float dist = start;; dist += SIZE_OF_GRIDS / 2)
+    {
+        if (dist > end)
+        {
+            dist = end;
+        }
+
+        GridPair p = MaNGOS::ComputeGridPair(player->GetPositionX() + dirX * dist, player->GetPositionY() + dirY * dist);
+        if (p.x_coord < MAX_NUMBER_OF_GRIDS && p.y_coord < MAX_NUMBER_OF_GRIDS)
+        {
+            // terrain grids are mirrored, see Map::EnsureGridCreated
+            uint32 x = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+            uint32 y = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+            if (!terrain->IsGridMapLoaded(x, y))
+            {
+                schedule(terrain, x, y);
+            }
+        }
+
+        if (dist >= end)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Queues the terrain of a grid for preloading.
+ * @param terrain Terrain the grid belongs to.
+ * @param x Terrain grid x, as used by TerrainInfo::Load.
+ * @param y Terrain grid y, as used by TerrainInfo::Load.
+ */
+void GridPreloader::schedule(TerrainInfo* terrain, uint32 x, uint32 y)
+{
+    Job job;
+    job.terrain = terrain;
+    job.x = x;
+    job.y = y;
+    job.key = (uint64(terrain->GetMapId()) << 32) | (x * MAX_NUMBER_OF_GRIDS + y);
+    job.queueTime = NowMicroseconds();
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    if (m_shutdown || m_queued.find(job.key) != m_queued.end())
+    {
+        return;
+    }
+
+    if (m_jobs.size() >= MAX_QUEUED_GRIDS)
+    {
+        ++m_stats.dropped;
+        return;
+    }
+
+    // keep the terrain alive while the grid waits, the map may be unloaded meanwhile
+    terrain->AddRef();
+
+    m_jobs.push_back(job);
+    m_queued.insert(job.key);
+    ++m_stats.queued;
+
+    m_workCondition.signal();
+}
+
+/**
+ * @brief Returns a copy of the preload statistics.
+ * @param stats Receives the statistics.
+ */
+void GridPreloader::GetStats(GridPreloadStats& stats)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+    stats = m_stats;
+}
+
+/**
+ * @brief Reads the terrain files of one grid.
+ *
+ * The GridMap is handed to the TerrainInfo, vmap and navmesh tiles are only
+ * read into the file cache: their managers are not thread safe and are left
+ * to the map thread.
+ * @param job Grid to be read.
+ */
+void GridPreloader::load(Job const& job)
+{
+    bool loaded = job.terrain->PreloadGridMap(job.x, job.y);
+    if (loaded)
+    {
+        uint32 mapId = job.terrain->GetMapId();
+
+        // the GridMap points into its mapped file, fault the pages in here instead of in the map thread
+        char gridMap[32];
+        snprintf(gridMap, sizeof(gridMap), "maps/%03u%02u%02u.map", mapId, job.x, job.y);
+        WarmFile(sWorld.GetDataPath() + gridMap);
+
+        WarmFile(sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, job.x, job.y));
+
+        char mmapTile[32];
+        snprintf(mmapTile, sizeof(mmapTile), "mmaps/%03u%02u%02u.mmtile", mapId, job.x, job.y);
+        WarmFile(sWorld.GetDataPath() + mmapTile);
+    }
+
+    uint32 elapsed = uint32(NowMicroseconds() - job.queueTime);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    if (!loaded)
+    {
+        ++m_stats.skipped;
+        return;
+    }
+
+    if (!m_stats.loaded)
+    {
+        m_stats.avgTime = elapsed;
+    }
+    else
+    {
+        m_stats.avgTime = uint32((uint64(m_stats.avgTime) * 7 + elapsed) / 8);
+    }
+
+    ++m_stats.loaded;
+    m_stats.lastTime = elapsed;
+    m_stats.maxTime = std::max(m_stats.maxTime, elapsed);
+
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "GridPreloader: preloaded grid[%u,%u] of map %u in %u us", job.x, job.y, job.terrain->GetMapId(), elapsed);
+}
+
+/**
+ * @brief Worker thread body.
+ * @return Always returns 0.
+ */
+int GridPreloader::svc()
+{
+    for (;;)
+    {
+        Job job;
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            while (!m_shutdown && m_jobs.empty())
+            {
+                m_workCondition.wait();
+            }
+
+            if (m_shutdown)
+            {
+                break;
+            }
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        load(job);
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+            m_queued.erase(job.key);
+        }
+
+        // the map may have gone meanwhile, then the last reference is ours
+        if (job.terrain->Release())
+        {
+            sTerrainMgr.UnloadTerrain(job.terrain->GetMapId());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef _GRID_PRELOADER_H_INCLUDED
+#define _GRID_PRELOADER_H_INCLUDED
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+
+#include <deque>
+#include <set>
+
+class TerrainInfo;
+class Player;
+
+/**
+ * @brief Statistics of the grid preloader.
+ *
+ * Times are in microseconds and measured from queuing a grid until its
+ * terrain files have been read.
+ */
+struct GridPreloadStats
+{
+    GridPreloadStats() : queued(0), loaded(0), skipped(0), dropped(0), lastTime(0), avgTime(0), maxTime(0) {}
+
+    uint32 queued;      ///< Grids queued for preloading.
+    uint32 loaded;      ///< Grids whose .map file was read by a preloader thread.
+    uint32 skipped;     ///< Queued grids already loaded by the map in the meantime.
+    uint32 dropped;     ///< Requests rejected because the queue was full.
+    uint32 lastTime;    ///< Latency of the last preloaded grid.
+    uint32 avgTime;     ///< Smoothed latency of preloaded grids.
+    uint32 maxTime;     ///< Longest latency seen so far.
+};
+
+/**
+ * @brief Thread pool reading the terrain of grids a player is about to enter.
+ *
+ * Map threads predict the next grid of a moving player from its position,
+ * orientation and speed and queue it here. A preloader thread reads the
+ * .map file into a GridMap kept aside by the TerrainInfo, and pulls the
+ * vmap and navmesh tiles of the grid into the file cache. When the player
+ * arrives, Map::EnsureGridCreated picks the GridMap up instead of reading
+ * the file, and the vmap and navmesh loads are served from memory.
+ *
+ * Spawning the objects of a grid is left to the map thread, creatures and
+ * game objects can not be created outside of their map.
+ */
+class GridPreloader : protected ACE_Task_Base
+{
+    public:
+        /**
+         * @brief Constructor for GridPreloader.
+         */
+        GridPreloader();
+
+        /**
+         * @brief Destructor for GridPreloader.
+         */
+        virtual ~GridPreloader();
+
+        /**
+         * @brief Activates the preloader with the specified number of threads.
+         * @param num_threads Number of threads to activate.
+         * @param lookAhead How far ahead a moving player is predicted, in milliseconds.
+         * @return Result of the activation.
+         */
+        int activate(size_t num_threads, uint32 lookAhead);
+
+        /**
+         * @brief Deactivates the preloader, queued grids are discarded.
+         * @return Result of the deactivation.
+         */
+        int deactivate();
+
+        /**
+         * @brief Checks if the preloader is activated.
+         * @return True if activated, false otherwise.
+         */
+        bool activated() const { return m_activated; }
+
+        /**
+         * @brief Queues the grid a moving player will reach next, if it is not loaded yet.
+         * @param terrain Terrain of the map the player is on.
+         * @param player Player which has been relocated.
+         */
+        void predict(TerrainInfo* terrain, Player const* player);
+
+        /**
+         * @brief Queues the terrain of a grid for preloading.
+         * @param terrain Terrain the grid belongs to.
+         * @param x Terrain grid x, as used by TerrainInfo::Load.
+         * @param y Terrain grid y, as used by TerrainInfo::Load.
+         */
+        void schedule(TerrainInfo* terrain, uint32 x, uint32 y);
+
+        /**
+         * @brief Returns a copy of the preload statistics.
+         * @param stats Receives the statistics.
+         */
+        void GetStats(GridPreloadStats& stats);
+
+    protected:
+        /**
+         * @brief Worker thread body.
+         * @return Always returns 0.
+         */
+        virtual int svc() override;
+
+    private:
+        /**
+         * @brief A single queued grid.
+         */
+        struct Job
+        {
+            TerrainInfo* terrain;   ///< Referenced while the job is queued.
+            uint32 x;
+            uint32 y;
+            uint64 key;             ///< Map id and grid, used to drop duplicate requests.
+            uint64 queueTime;       ///< Steady clock time of queuing, in microseconds.
+        };
+
+        /**
+         * @brief Reads the terrain files of one grid.
+         * @param job Grid to be read.
+         */
+        void load(Job const& job);
+
+        ACE_Thread_Mutex m_mutex;                   ///< Protects the queue and the statistics.
+        ACE_Condition_Thread_Mutex m_workCondition; ///< Signaled when jobs are queued or on shutdown.
+        std::deque<Job> m_jobs;                     ///< Queued grids.
+        std::set<uint64> m_queued;                  ///< Keys of the queued grids.
+        GridPreloadStats m_stats;                   ///< Preload statistics.
+        uint32 m_lookAhead;                         ///< Prediction time, in milliseconds.
+        bool m_shutdown;                            ///< Set when the workers are asked to exit.
+        bool m_activated;                           ///< True while worker threads are running.
+};
+
+#endif //_GRID_PRELOADER_H_INCLUDED
@@ -0,0 +1,242 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "MapRegionUpdater.h"
+#include "Map.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+
+namespace
+{
+    /// Region being updated by the current thread.
+    thread_local MapRegionContext* t_currentContext = NULL;
+}
+
+/**
+ * @brief Constructor for MapRegionUpdater.
+ */
+MapRegionUpdater::MapRegionUpdater() :
+m_mutex(), m_workCondition(m_mutex), m_shutdown(false), m_activated(false)
+{
+}
+
+/**
+ * @brief Destructor for MapRegionUpdater.
+ */
+MapRegionUpdater::~MapRegionUpdater()
+{
+    deactivate();
+}
+
+/**
+ * @brief Activates the region updater with the specified number of threads.
+ * @param num_threads Number of threads to activate.
+ * @return Result of the activation.
+ */
+int MapRegionUpdater::activate(size_t num_threads)
+{
+    if (m_activated || num_threads < 1)
+    {
+        return -1;
+    }
+
+    m_shutdown = false;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, (int)num_threads) == -1)
+    {
+        return -1;
+    }
+
+    m_activated = true;
+    return 0;
+}
+
+/**
+ * @brief Deactivates the region updater.
+ * @return Result of the deactivation.
+ */
+int MapRegionUpdater::deactivate()
+{
+    if (!m_activated)
+    {
+        return -1;
+    }
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        m_shutdown = true;
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    m_activated = false;
+    return 0;
+}
+
+/**
+ * @brief Updates all objects in the given regions and waits for completion.
+ * @param map Map the regions belong to.
+ * @param regions Regions to be updated, none of them may be adjacent.
+ * @param diff Time difference for the update.
+ */
+void MapRegionUpdater::update_regions(Map& map, MapRegionList const& regions, uint32 diff)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    Batch batch(m_mutex);
+
+    for (MapRegionList::const_iterator itr = regions.begin(); itr != regions.end(); ++itr)
+    {
+        Job job;
+        job.map = &map;
+        job.region = *itr;
+        job.task = NULL;
+        job.batch = &batch;
+        job.diff = diff;
+        m_jobs.push_back(job);
+        ++batch.pending;
+    }
+
+    m_workCondition.broadcast();
+
+    while (batch.pending > 0)
+    {
+        batch.done.wait();
+    }
+}
+
+/**
+ * @brief Runs independent tasks on the pool and waits for completion.
+ * @param tasks Tasks to be run.
+ */
+void MapRegionUpdater::run_tasks(TaskList const& tasks)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    Batch batch(m_mutex);
+
+    for (TaskList::const_iterator itr = tasks.begin(); itr != tasks.end(); ++itr)
+    {
+        Job job;
+        job.map = NULL;
+        job.region = NULL;
+        job.task = &*itr;
+        job.batch = &batch;
+        job.diff = 0;
+        m_jobs.push_back(job);
+        ++batch.pending;
+    }
+
+    m_workCondition.broadcast();
+
+    while (batch.pending > 0)
+    {
+        batch.done.wait();
+    }
+}
+
+/**
+ * @brief Context of the region updated by the calling thread, NULL outside of region workers.
+ */
+MapRegionContext* MapRegionUpdater::current_context()
+{
+    return t_currentContext;
+}
+
+/**
+ * @brief Updates all objects in the cells of a region, in the calling thread.
+ * @param map Map the region belongs to.
+ * @param region Region to be updated.
+ * @param diff Time difference for the update.
+ */
+void MapRegionUpdater::update_region(Map& map, MapRegion& region, uint32 diff)
+{
+    MaNGOS::ObjectUpdater updater(diff);
+    // for creature
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+    // for pets
+    TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+    for (std::vector<uint32>::const_iterator itr = region.cells.begin(); itr != region.cells.end(); ++itr)
+    {
+        CellPair pair(*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP, *itr / TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        Cell cell(pair);
+        cell.SetNoCreate();
+        map.Visit(cell, grid_object_update);
+        map.Visit(cell, world_object_update);
+    }
+}
+
+/**
+ * @brief Worker thread body.
+ * @return Always returns 0.
+ */
+int MapRegionUpdater::svc()
+{
+    for (;;)
+    {
+        Job job;
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            while (!m_shutdown && m_jobs.empty())
+            {
+                m_workCondition.wait();
+            }
+
+            if (m_jobs.empty())
+            {
+                break;
+            }
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+        }
+
+        if (job.task)
+        {
+            (*job.task)();
+        }
+        else
+        {
+            job.region->context.map = job.map;
+            t_currentContext = &job.region->context;
+            update_region(*job.map, *job.region, job.diff);
+            t_currentContext = NULL;
+        }
+
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        if (--job.batch->pending == 0)
+        {
+            job.batch->done.signal();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef _MAP_REGION_UPDATER_H_INCLUDED
+#define _MAP_REGION_UPDATER_H_INCLUDED
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+class Map;
+class WorldObject;
+
+/**
+ * @brief Work deferred by a region worker until the serialized merge phase.
+ *
+ * Everything that may touch objects or grids outside of the region which
+ * is being updated is collected here and applied by the map thread once
+ * all regions of the current phase are done.
+ */
+struct MapRegionContext
+{
+    /**
+     * @brief A creature move which crosses a grid border.
+     */
+    struct Relocation
+    {
+        Relocation(ObjectGuid guid, float _x, float _y, float _z, float _o) : creatureGuid(guid), x(_x), y(_y), z(_z), o(_o) {}
+
+        ObjectGuid creatureGuid;    ///< The creature may be gone by the time the move is applied.
+        float x, y, z, o;
+    };
+
+    typedef std::vector<Relocation> RelocationList;
+    typedef std::vector<WorldObject*> ObjectList;
+    typedef std::vector<std::function<void()> > CallList;
+
+    MapRegionContext() : map(NULL) {}
+
+    Map* map;                   ///< Map the region belongs to.
+    RelocationList relocations; ///< Creature moves into another grid.
+    ObjectList removeList;      ///< Objects to be added to the map remove list.
+    CallList calls;             ///< Pool updates and linking events, which spawn and despawn anywhere on the map. Run in order, last.
+};
+
+/**
+ * @brief A group of cells inside one grid, updated by a single thread.
+ */
+struct MapRegion
+{
+    MapRegion() : gridX(0), gridY(0) {}
+
+    uint32 gridX;               ///< Grid the cells belong to.
+    uint32 gridY;
+    std::vector<uint32> cells;  ///< Marked cell ids, as used by Map::VisitNearbyCellsOf.
+    MapRegionContext context;   ///< Work deferred to the merge phase.
+};
+
+typedef std::vector<MapRegion*> MapRegionList;
+
+/**
+ * @brief Thread pool used to update the regions of a single map in parallel.
+ *
+ * A map hands over a list of regions which do not share any grid border,
+ * and blocks until every region has been updated. Several maps may use
+ * the pool at the same time.
+ */
+class MapRegionUpdater : protected ACE_Task_Base
+{
+    public:
+        /**
+         * @brief Constructor for MapRegionUpdater.
+         */
+        MapRegionUpdater();
+
+        /**
+         * @brief Destructor for MapRegionUpdater.
+         */
+        virtual ~MapRegionUpdater();
+
+        /**
+         * @brief Activates the region updater with the specified number of threads.
+         * @param num_threads Number of threads to activate.
+         * @return Result of the activation.
+         */
+        int activate(size_t num_threads);
+
+        /**
+         * @brief Deactivates the region updater.
+         * @return Result of the deactivation.
+         */
+        int deactivate();
+
+        /**
+         * @brief Checks if the region updater is activated.
+         * @return True if activated, false otherwise.
+         */
+        bool activated() const { return m_activated; }
+
+        /**
+         * @brief Updates all objects in the given regions and waits for completion.
+         * @param map Map the regions belong to.
+         * @param regions Regions to be updated, none of them may be adjacent.
+         * @param diff Time difference for the update.
+         */
+        void update_regions(Map& map, MapRegionList const& regions, uint32 diff);
+
+        typedef std::vector<std::function<void()> > TaskList;
+
+        /**
+         * @brief Runs independent tasks on the pool and waits for completion.
+         *
+         * Tasks must not touch anything shared with other tasks or the map
+         * without locking, they run outside of any region context.
+         * @param tasks Tasks to be run.
+         */
+        void run_tasks(TaskList const& tasks);
+
+        /**
+         * @brief Context of the region updated by the calling thread, NULL outside of region workers.
+         */
+        static MapRegionContext* current_context();
+
+        /**
+         * @brief Updates all objects in the cells of a region, in the calling thread.
+         * @param map Map the region belongs to.
+         * @param region Region to be updated.
+         * @param diff Time difference for the update.
+         */
+        static void update_region(Map& map, MapRegion& region, uint32 diff);
+
+    protected:
+        /**
+         * @brief Worker thread body.
+         * @return Always returns 0.
+         */
+        virtual int svc() override;
+
+    private:
+        /**
+         * @brief The set of regions of one update_regions call.
+         */
+        struct Batch
+        {
+            Batch(ACE_Thread_Mutex& mutex) : pending(0), done(mutex) {}
+
+            size_t pending;                 ///< Number of regions not yet updated.
+            ACE_Condition_Thread_Mutex done; ///< Signaled when pending drops to zero.
+        };
+
+        /**
+         * @brief A single queued region update, or a task when region is NULL.
+         */
+        struct Job
+        {
+            Map* map;
+            MapRegion* region;
+            std::function<void()> const* task;
+            Batch* batch;
+            uint32 diff;
+        };
+
+        ACE_Thread_Mutex m_mutex;                   ///< Protects the queue and all batches.
+        ACE_Condition_Thread_Mutex m_workCondition; ///< Signaled when jobs are queued or on shutdown.
+        std::deque<Job> m_jobs;                     ///< Queued region updates.
+        bool m_shutdown;                            ///< Set when the workers are asked to exit.
+        bool m_activated;                           ///< True while worker threads are running.
+};
+
+#endif //_MAP_REGION_UPDATER_H_INCLUDED
@@ -23,52 +23,33 @@
  */
 
 #include "MapUpdater.h"
-#include "DelayExecutor.h"
 #include "Map.h"
-#include "DatabaseEnv.h"
+#include "Log.h"
 
 #include <ace/Guard_T.h>
-#include <ace/Method_Request.h>
 
-/**
- * @brief A request to update a map.
- */
-class MapUpdateRequest : public ACE_Method_Request
-{
-    private:
-        Map& m_map; ///< Reference to the map to be updated.
-        MapUpdater& m_updater; ///< Reference to the map updater.
-        ACE_UINT32 m_diff; ///< Time difference for the update.
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
-    public:
-        /**
-         * @brief Constructor for MapUpdateRequest.
-         * @param m Reference to the map.
-         * @param u Reference to the map updater.
-         * @param d Time difference for the update.
-         */
-        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
-        {
-        }
+namespace
+{
+    /// Maps which were not updated for this many ticks are dropped from the statistics.
+    const uint32 MAP_UPDATE_STAT_EXPIRE_TICKS = 1000;
 
-        /**
-         * @brief Executes the map update request.
-         * @return Always returns 0.
-         */
-        virtual int call()
-        {
-            m_map.Update(m_diff);
-            m_updater.update_finished();
-            return 0;
-        }
-};
+    inline uint64 MakeStatKey(Map const& map)
+    {
+        return (uint64(map.GetId()) << 32) | map.GetInstanceId();
+    }
+}
 
 /**
  * @brief Constructor for MapUpdater.
  */
 MapUpdater::MapUpdater():
-m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
+m_mutex(), m_condition(m_mutex), m_workCondition(m_mutex), pending_requests(0),
+m_generation(0), m_shutdown(false), m_activated(false), m_nextWorker(0), m_stolenCount(0),
+m_tick(0), m_lastTickTime(0), m_inlineTime(0)
 {
 }
 
@@ -87,7 +68,30 @@ MapUpdater::~MapUpdater()
  */
 int MapUpdater::activate(size_t num_threads)
 {
-    return m_executor._activate((int)num_threads);
+    if (m_activated || num_threads < 1)
+    {
+        return -1;
+    }
+
+    m_shutdown = false;
+    m_nextWorker = 0;
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        m_queues.push_back(new WorkerQueue);
+    }
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, (int)num_threads) == -1)
+    {
+        for (size_t i = 0; i < m_queues.size(); ++i)
+        {
+            delete m_queues[i];
+        }
+        m_queues.clear();
+        return -1;
+    }
+
+    m_activated = true;
+    return 0;
 }
 
 /**
@@ -96,26 +100,63 @@ int MapUpdater::activate(size_t num_threads)
  */
 int MapUpdater::deactivate()
 {
+    if (!m_activated)
+    {
+        return -1;
+    }
+
     wait();
-    return m_executor.deactivate();
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        m_shutdown = true;
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    for (size_t i = 0; i < m_queues.size(); ++i)
+    {
+        delete m_queues[i];
+    }
+    m_queues.clear();
+
+    m_activated = false;
+    return 0;
 }
 
 /**
- * @brief Waits for all pending requests to be processed.
+ * @brief Dispatches the scheduled updates and waits for all of them to be processed.
+ *
+ * Also closes the statistics tick, so it is called once per world tick even
+ * when the maps were updated in the calling thread.
  * @return Always returns 0.
  */
 int MapUpdater::wait()
 {
+    std::chrono::steady_clock::time_point tickStart = std::chrono::steady_clock::now();
+
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
+    if (m_scheduled.empty() && pending_requests == 0)
+    {
+        end_tick(0);
+        return 0;
+    }
+
+    dispatch();
+
     while (pending_requests > 0)
+    {
         m_condition.wait();
+    }
 
+    end_tick(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count()));
     return 0;
 }
 
 /**
- * @brief Schedules a map update.
+ * @brief Schedules a map update. The update is started by the next wait() call.
  * @param map Reference to the map to be updated.
  * @param diff Time difference for the update.
  * @return Result of the scheduling.
@@ -124,26 +165,227 @@ int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
 
-    ++pending_requests;
-
-    if (m_executor.execute(new MapUpdateRequest(map, *this, diff)) == -1)
+    if (!m_activated || m_shutdown)
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
-
-        --pending_requests;
+        sLog.outError("MapUpdater: failed to schedule update of map %u (instance %u), updater is not active", map.GetId(), map.GetInstanceId());
         return -1;
     }
 
+    m_scheduled.push_back(MapUpdateTask(&map, diff));
     return 0;
 }
 
+/**
+ * @brief Updates a map in the calling thread, recording its update time.
+ * @param map Reference to the map to be updated.
+ * @param diff Time difference for the update.
+ */
+void MapUpdater::update_now(Map& map, ACE_UINT32 diff)
+{
+    m_inlineTime += run_task(MapUpdateTask(&map, diff));
+}
+
 /**
  * @brief Checks if the map updater is activated.
  * @return True if activated, false otherwise.
  */
 bool MapUpdater::activated()
 {
-    return m_executor.activated();
+    return m_activated;
+}
+
+/**
+ * @brief Sorts the scheduled updates by predicted cost and hands them to the worker queues.
+ *
+ * Uses the longest-processing-time-first rule: every task, most expensive first,
+ * goes to the queue with the smallest predicted load. Called with m_mutex held.
+ */
+void MapUpdater::dispatch()
+{
+    if (m_scheduled.empty())
+    {
+        return;
+    }
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, statsGuard, m_statsLock);
+
+        for (TaskList::iterator itr = m_scheduled.begin(); itr != m_scheduled.end(); ++itr)
+        {
+            MapUpdateStatMap::const_iterator stat = m_stats.find(MakeStatKey(*itr->map));
+            // unknown maps are assumed to be expensive, so a freshly loaded continent is not started last
+            itr->cost = stat != m_stats.end() ? stat->second.avgTime + 1 : std::numeric_limits<uint32>::max();
+        }
+    }
+
+    std::stable_sort(m_scheduled.begin(), m_scheduled.end());
+
+    std::vector<uint64> load(m_queues.size(), 0);
+    for (TaskList::const_iterator itr = m_scheduled.begin(); itr != m_scheduled.end(); ++itr)
+    {
+        size_t target = std::min_element(load.begin(), load.end()) - load.begin();
+        load[target] += itr->cost;
+
+        ACE_GUARD(ACE_Thread_Mutex, queueGuard, m_queues[target]->lock);
+        m_queues[target]->tasks.push_back(*itr);
+    }
+
+    pending_requests += m_scheduled.size();
+    m_scheduled.clear();
+
+    ++m_generation;
+    m_workCondition.broadcast();
+}
+
+/**
+ * @brief Advances the statistics tick and drops maps which were not updated for a long time.
+ * @param dispatchTime Wall time of the dispatched updates, 0 if there were none.
+ */
+void MapUpdater::end_tick(uint32 dispatchTime)
+{
+    // maps updated in the calling thread count too, else a tick without dispatch keeps the old time
+    m_lastTickTime = dispatchTime + m_inlineTime;
+    m_inlineTime = 0;
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_statsLock);
+
+    ++m_tick;
+
+    for (MapUpdateStatMap::iterator itr = m_stats.begin(); itr != m_stats.end();)
+    {
+        if (m_tick - itr->second.lastSeenTick > MAP_UPDATE_STAT_EXPIRE_TICKS)
+        {
+            m_stats.erase(itr++);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+/**
+ * @brief Takes the next task for a worker, stealing from other workers if its own queue is empty.
+ * @param worker Index of the calling worker.
+ * @param task Taken task.
+ * @return True if a task was taken.
+ */
+bool MapUpdater::take_task(size_t worker, MapUpdateTask& task)
+{
+    {
+        WorkerQueue& own = *m_queues[worker];
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, own.lock, false);
+        if (!own.tasks.empty())
+        {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        WorkerQueue& victim = *m_queues[(worker + i) % m_queues.size()];
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, victim.lock, false);
+        if (!victim.tasks.empty())
+        {
+            // the victim works its queue from the expensive end, take the cheap one
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            ++m_stolenCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Runs a map update and records how long it took.
+ * @param task Task to run.
+ * @return Wall time of the update, in microseconds.
+ */
+uint32 MapUpdater::run_task(MapUpdateTask const& task)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    task.map->Update(task.diff);
+
+    uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_statsLock, elapsed);
+
+    MapUpdateStat& stat = m_stats[MakeStatKey(*task.map)];
+    if (!stat.samples++)
+    {
+        stat.mapId = task.map->GetId();
+        stat.instanceId = task.map->GetInstanceId();
+        stat.avgTime = elapsed;
+    }
+    else
+    {
+        // exponential moving average, weight 1/4 on the newest sample
+        stat.avgTime = uint32((uint64(stat.avgTime) * 3 + elapsed) / 4);
+    }
+    stat.lastTime = elapsed;
+    stat.maxTime = std::max(stat.maxTime, elapsed);
+    stat.lastSeenTick = m_tick;
+    return elapsed;
+}
+
+/**
+ * @brief Worker thread body.
+ * @return Always returns 0.
+ */
+int MapUpdater::svc()
+{
+    size_t worker = size_t(m_nextWorker++);
+    uint32 seenGeneration = 0;
+
+    for (;;)
+    {
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+            while (!m_shutdown && seenGeneration == m_generation)
+            {
+                m_workCondition.wait();
+            }
+
+            if (m_shutdown)
+            {
+                break;
+            }
+
+            seenGeneration = m_generation;
+        }
+
+        MapUpdateTask task;
+        while (take_task(worker, task))
+        {
+            run_task(task);
+            update_finished();
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Fills the update statistics of all recently updated maps, most expensive first.
+ * @param stats List to be filled.
+ */
+void MapUpdater::GetUpdateStats(MapUpdateStatList& stats)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_statsLock);
+
+    stats.clear();
+    stats.reserve(m_stats.size());
+    for (MapUpdateStatMap::const_iterator itr = m_stats.begin(); itr != m_stats.end(); ++itr)
+    {
+        stats.push_back(itr->second);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](MapUpdateStat const& a, MapUpdateStat const& b) { return a.avgTime > b.avgTime; });
 }
 
 /**
@@ -155,11 +397,14 @@ void MapUpdater::update_finished()
 
     if (pending_requests == 0)
     {
-        ACE_ERROR((LM_ERROR, ACE_TEXT("(%t)\n"), ACE_TEXT("MapUpdater::update_finished BUG, report to devs")));
+        sLog.outError("MapUpdater::update_finished BUG, report to devs");
         return;
     }
 
     --pending_requests;
 
-    m_condition.broadcast();
+    if (pending_requests == 0)
+    {
+        m_condition.broadcast();
+    }
 }
@@ -25,17 +25,49 @@
 #ifndef _MAP_UPDATER_H_INCLUDED
 #define _MAP_UPDATER_H_INCLUDED
 
+#include <ace/Task.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Condition_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 
-#include "DelayExecutor.h"
+#include "Common.h"
+
+#include <deque>
+#include <map>
+#include <vector>
 
 class Map;
 
+/**
+ * @brief Update time statistics of a single map, as seen by the MapUpdater.
+ *
+ * All times are in microseconds.
+ */
+struct MapUpdateStat
+{
+    MapUpdateStat() : mapId(0), instanceId(0), samples(0), lastTime(0), avgTime(0), maxTime(0), lastSeenTick(0) {}
+
+    uint32 mapId;           ///< Map id of the updated map.
+    uint32 instanceId;      ///< Instance id of the updated map.
+    uint32 samples;         ///< Number of recorded updates.
+    uint32 lastTime;        ///< Duration of the last Map::Update call.
+    uint32 avgTime;         ///< Smoothed duration, used as predicted cost for the next tick.
+    uint32 maxTime;         ///< Longest Map::Update call seen so far.
+    uint32 lastSeenTick;    ///< Updater tick in which the map was last updated.
+};
+
+typedef std::vector<MapUpdateStat> MapUpdateStatList;
+
 /**
  * @brief The MapUpdater class is responsible for managing map update requests.
+ *
+ * Maps scheduled during one world tick are collected and dispatched together
+ * in wait(): the most expensive maps (by recent Map::Update cost) are handed out
+ * first, spread over per-thread queues, and idle threads steal work from the
+ * queues of busy ones. This keeps one large continent from being started last
+ * and deciding the length of the whole tick.
  */
-class MapUpdater
+class MapUpdater : protected ACE_Task_Base
 {
     public:
         /**
@@ -48,10 +80,8 @@ class MapUpdater
          */
         virtual ~MapUpdater();
 
-        friend class MapUpdateRequest;
-
         /**
-         * @brief Schedules a map update.
+         * @brief Schedules a map update. The update is started by the next wait() call.
          * @param map Reference to the map to be updated.
          * @param diff Time difference for the update.
          * @return Result of the scheduling.
@@ -59,11 +89,19 @@ class MapUpdater
         int schedule_update(Map& map, ACE_UINT32 diff);
 
         /**
-         * @brief Waits for all pending requests to be processed.
+         * @brief Dispatches the scheduled updates and waits for all of them to be processed.
+         * Must be called once per world tick, also when the updater is not activated.
          * @return Always returns 0.
          */
         int wait();
 
+        /**
+         * @brief Updates a map in the calling thread, recording its update time.
+         * @param map Reference to the map to be updated.
+         * @param diff Time difference for the update.
+         */
+        void update_now(Map& map, ACE_UINT32 diff);
+
         /**
          * @brief Activates the map updater with the specified number of threads.
          * @param num_threads Number of threads to activate.
@@ -83,16 +121,113 @@ class MapUpdater
          */
         bool activated();
 
+        /**
+         * @brief Fills the update statistics of all recently updated maps, most expensive first.
+         * @param stats List to be filled.
+         */
+        void GetUpdateStats(MapUpdateStatList& stats);
+
+        /**
+         * @brief Wall time of the map updates of the last tick, in microseconds.
+         */
+        uint32 GetLastTickTime() const { return m_lastTickTime; }
+
+        /**
+         * @brief Tick closed by the last wait(), the lastSeenTick of the maps it updated.
+         */
+        uint32 GetLastTick() const { return m_tick - 1; }
+
+        /**
+         * @brief Number of updates taken from another thread's queue since activation.
+         */
+        uint32 GetStolenCount() const { return uint32(m_stolenCount.value()); }
+
+    protected:
+        /**
+         * @brief Worker thread body.
+         * @return Always returns 0.
+         */
+        virtual int svc() override;
+
     private:
-        DelayExecutor m_executor; ///< Executor for handling delayed tasks.
-        ACE_Thread_Mutex m_mutex; ///< Mutex for synchronizing access to pending requests.
-        ACE_Condition_Thread_Mutex m_condition; ///< Condition variable for signaling when requests are processed.
-        size_t pending_requests; ///< Number of pending update requests.
+        /**
+         * @brief A single scheduled map update.
+         */
+        struct MapUpdateTask
+        {
+            MapUpdateTask() : map(NULL), diff(0), cost(0) {}
+            MapUpdateTask(Map* m, ACE_UINT32 d) : map(m), diff(d), cost(0) {}
+
+            Map* map;           ///< Map to be updated.
+            ACE_UINT32 diff;    ///< Time difference for the update.
+            uint32 cost;        ///< Predicted cost, in microseconds.
+
+            bool operator<(MapUpdateTask const& other) const { return cost > other.cost; }
+        };
+
+        typedef std::deque<MapUpdateTask> TaskQueue;
+        typedef std::vector<MapUpdateTask> TaskList;
+        typedef std::map<uint64, MapUpdateStat> MapUpdateStatMap;
+
+        /**
+         * @brief Per worker thread queue. The owner takes from the front, thieves from the back.
+         */
+        struct WorkerQueue
+        {
+            ACE_Thread_Mutex lock;
+            TaskQueue tasks;
+        };
+
+        /**
+         * @brief Sorts the scheduled updates by predicted cost and hands them to the worker queues.
+         * Called with m_mutex held.
+         */
+        void dispatch();
+
+        /**
+         * @brief Advances the statistics tick and drops maps which were not updated for a long time.
+         * @param dispatchTime Wall time of the dispatched updates, 0 if there were none.
+         */
+        void end_tick(uint32 dispatchTime);
+
+        /**
+         * @brief Takes the next task for a worker, stealing from other workers if its own queue is empty.
+         * @param worker Index of the calling worker.
+         * @param task Taken task.
+         * @return True if a task was taken.
+         */
+        bool take_task(size_t worker, MapUpdateTask& task);
+
+        /**
+         * @brief Runs a map update and records how long it took.
+         * @param task Task to run.
+         * @return Wall time of the update, in microseconds.
+         */
+        uint32 run_task(MapUpdateTask const& task);
 
         /**
          * @brief Called when a map update is finished.
          */
         void update_finished();
+
+        ACE_Thread_Mutex m_mutex;                   ///< Mutex for synchronizing access to pending requests.
+        ACE_Condition_Thread_Mutex m_condition;     ///< Condition variable for signaling when requests are processed.
+        ACE_Condition_Thread_Mutex m_workCondition; ///< Condition variable for waking idle workers.
+        size_t pending_requests;                    ///< Number of pending update requests.
+        TaskList m_scheduled;                       ///< Updates scheduled since the last dispatch.
+        uint32 m_generation;                        ///< Incremented on every dispatch, used to wake idle workers.
+        bool m_shutdown;                            ///< Set when the workers are asked to exit.
+        bool m_activated;                           ///< True while worker threads are running.
+
+        std::vector<WorkerQueue*> m_queues;         ///< One queue per worker thread.
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_nextWorker; ///< Used to assign queue indexes to starting threads.
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_stolenCount; ///< Number of stolen updates.
+
+        ACE_Thread_Mutex m_statsLock;               ///< Protects m_stats.
+        MapUpdateStatMap m_stats;                   ///< Update statistics, keyed by map id and instance id.
+        uint32 m_tick;                              ///< Number of dispatched ticks.
+        uint32 m_lastTickTime;                      ///< Wall time of the map updates of the last tick.
+        uint32 m_inlineTime;                        ///< Time of this tick's updates run by update_now().
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -0,0 +1,168 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "TerrainQueryCache.h"
+
+#include <ace/Guard_T.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /// Snaps a coordinate to the cache grid, 21 bits cover +-262144 yards.
+    uint64 Quantize(float v)
+    {
+        int32 cell = int32(floor(v / TERRAIN_QUERY_CACHE_STEP));
+        return uint64(cell + (1 << 20)) & 0x1FFFFF;
+    }
+
+    uint64 QuantizePosition(float x, float y, float z)
+    {
+        return (Quantize(x) << 42) | (Quantize(y) << 21) | Quantize(z);
+    }
+
+    uint32 FloatBits(float f)
+    {
+        uint32 bits;
+        memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    uint64 Mix(uint64 h)
+    {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+}
+
+/**
+ * @brief Constructor for TerrainQueryCache.
+ * @param size Slots per query type, rounded down to a power of two, 0 disables the cache.
+ */
+TerrainQueryCache::TerrainQueryCache(uint32 size) : m_mask(0), m_generation(1)
+{
+    if (!size)
+    {
+        return;
+    }
+
+    uint32 slots = 1;
+    while (slots * 2 <= size)
+    {
+        slots *= 2;
+    }
+
+    for (int type = 0; type < MAX_TERRAIN_QUERY_TYPES; ++type)
+    {
+        m_slots[type].resize(slots);
+    }
+
+    m_mask = slots - 1;
+}
+
+/**
+ * @brief Looks up a result.
+ * @param type Kind of query.
+ * @param key Key of the query.
+ * @param value Receives the cached result.
+ * @return True if the result was cached in the current generation.
+ */
+bool TerrainQueryCache::Find(TerrainQueryType type, Key const& key, float& value)
+{
+    if (!m_mask)
+    {
+        return false;
+    }
+
+    uint32 index = SlotIndex(key);
+    uint32 generation = m_generation.value();
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_locks[index % TERRAIN_QUERY_CACHE_LOCKS], false);
+
+    Slot const& slot = m_slots[type][index];
+    if (slot.generation != generation || slot.key.a != key.a || slot.key.b != key.b)
+    {
+        return false;
+    }
+
+    value = slot.value;
+    return true;
+}
+
+/**
+ * @brief Stores a result, replacing whatever used the slot before.
+ * @param type Kind of query.
+ * @param key Key of the query.
+ * @param generation Generation read before the result was computed.
+ * @param value The result.
+ */
+void TerrainQueryCache::Store(TerrainQueryType type, Key const& key, uint32 generation, float value)
+{
+    if (!m_mask)
+    {
+        return;
+    }
+
+    uint32 index = SlotIndex(key);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_locks[index % TERRAIN_QUERY_CACHE_LOCKS]);
+
+    Slot& slot = m_slots[type][index];
+    slot.key = key;
+    slot.generation = generation;
+    slot.value = value;
+}
+
+/**
+ * @brief Builds the key of a GetHeightStatic query.
+ */
+TerrainQueryCache::Key TerrainQueryCache::HeightKey(float x, float y, float z, bool useVmaps, float maxSearchDist)
+{
+    Key key;
+    key.a = QuantizePosition(x, y, z);
+    key.b = (uint64(useVmaps) << 32) | FloatBits(maxSearchDist);
+    return key;
+}
+
+/**
+ * @brief Builds the key of a line of sight query.
+ */
+TerrainQueryCache::Key TerrainQueryCache::LineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2)
+{
+    Key key;
+    key.a = QuantizePosition(x1, y1, z1);
+    key.b = QuantizePosition(x2, y2, z2);
+    return key;
+}
+
+uint32 TerrainQueryCache::SlotIndex(Key const& key) const
+{
+    return uint32(Mix(key.a ^ Mix(key.b))) & m_mask;
+}
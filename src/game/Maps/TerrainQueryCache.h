@@ -0,0 +1,150 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#ifndef MANGOS_TERRAIN_QUERY_CACHE_H
+#define MANGOS_TERRAIN_QUERY_CACHE_H
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+
+#include "Common.h"
+
+#include <vector>
+
+/// Grid the query positions are snapped to, in yards.
+#define TERRAIN_QUERY_CACHE_STEP    0.25f
+/// Number of locks the slots are spread over.
+#define TERRAIN_QUERY_CACHE_LOCKS   16
+
+/**
+ * @brief Kinds of cached terrain queries.
+ */
+enum TerrainQueryType
+{
+    TERRAIN_QUERY_HEIGHT,               ///< TerrainInfo::GetHeightStatic
+    TERRAIN_QUERY_LINE_OF_SIGHT,        ///< static vmap line of sight
+    MAX_TERRAIN_QUERY_TYPES
+};
+
+/**
+ * @brief Direct mapped cache of static height and line of sight results.
+ *
+ * Spell casts, AI target checks and GetNearPoint ask for the same heights
+ * and lines of sight over and over, each answer costing one or more vmap
+ * ray casts. The positions are snapped to TERRAIN_QUERY_CACHE_STEP and the
+ * result of the first query in a snapped cell is returned for all later
+ * ones. Only static geometry is cached, the dynamic tree of the map
+ * instance is still queried every time.
+ *
+ * The results depend on the vmap tiles loaded, loading or unloading a tile
+ * bumps the generation and all older slots count as empty. A TerrainInfo
+ * is shared by all instances of a map and used from map and region
+ * threads, the slots are guarded by striped locks.
+ */
+class TerrainQueryCache
+{
+    public:
+        /**
+         * @brief Key of a cached query, built by HeightKey or LineOfSightKey.
+         */
+        struct Key
+        {
+            uint64 a;
+            uint64 b;
+        };
+
+        /**
+         * @brief Constructor for TerrainQueryCache.
+         * @param size Slots per query type, rounded down to a power of two, 0 disables the cache.
+         */
+        explicit TerrainQueryCache(uint32 size);
+
+        /**
+         * @brief Checks if the cache holds any slots.
+         * @return True if queries are cached.
+         */
+        bool IsEnabled() const { return m_mask != 0; }
+
+        /**
+         * @brief Current generation, to be read before the query is computed.
+         * @return The generation results are stored with.
+         */
+        uint32 GetGeneration() const { return m_generation.value(); }
+
+        /**
+         * @brief Drops all cached results, called when vmap tiles are loaded or unloaded.
+         */
+        void Invalidate() { ++m_generation; }
+
+        /**
+         * @brief Looks up a result.
+         * @param type Kind of query.
+         * @param key Key of the query.
+         * @param value Receives the cached result.
+         * @return True if the result was cached in the current generation.
+         */
+        bool Find(TerrainQueryType type, Key const& key, float& value);
+
+        /**
+         * @brief Stores a result, replacing whatever used the slot before.
+         * @param type Kind of query.
+         * @param key Key of the query.
+         * @param generation Generation read before the result was computed.
+         * @param value The result.
+         */
+        void Store(TerrainQueryType type, Key const& key, uint32 generation, float value);
+
+        /**
+         * @brief Builds the key of a GetHeightStatic query.
+         */
+        static Key HeightKey(float x, float y, float z, bool useVmaps, float maxSearchDist);
+
+        /**
+         * @brief Builds the key of a line of sight query.
+         */
+        static Key LineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2);
+
+    private:
+        TerrainQueryCache(TerrainQueryCache const&);
+        TerrainQueryCache& operator=(TerrainQueryCache const&);
+
+        struct Slot
+        {
+            Slot() : generation(0), value(0.0f) { key.a = key.b = 0; }
+
+            Key key;
+            uint32 generation;  ///< 0 for never used slots
+            float value;
+        };
+
+        uint32 SlotIndex(Key const& key) const;
+
+        std::vector<Slot> m_slots[MAX_TERRAIN_QUERY_TYPES];
+        uint32 m_mask;                                      ///< Slots per type - 1, 0 if disabled.
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_generation;
+        ACE_Thread_Mutex m_locks[TERRAIN_QUERY_CACHE_LOCKS];
+};
+
+#endif // MANGOS_TERRAIN_QUERY_CACHE_H
@@ -0,0 +1,202 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "PathCache.h"
+#include "World.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+/**
+ * @brief Looks up a corridor, marking it as recently used.
+ * @param mapId Map of the navmesh.
+ * @param startPoly First polygon of the corridor.
+ * @param endPoly Last polygon of the corridor.
+ * @param includeFlags Include flags of the query filter.
+ * @param excludeFlags Exclude flags of the query filter.
+ * @param path Receives the corridor, at least maxLength polygons.
+ * @param length Receives the length of the corridor.
+ * @param maxLength Capacity of path.
+ * @return True if the corridor was cached.
+ */
+bool PathCache::Find(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                     dtPolyRef* path, uint32& length, uint32 maxLength)
+{
+    if (!sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE))
+    {
+        return false;
+    }
+
+    Key key;
+    key.mapId = mapId;
+    key.includeFlags = includeFlags;
+    key.excludeFlags = excludeFlags;
+    key.startPoly = startPoly;
+    key.endPoly = endPoly;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+
+    EntryMap::const_iterator itr = m_index.find(key);
+    if (itr == m_index.end() || itr->second->path.size() > maxLength)
+    {
+        ++m_stats.misses;
+        return false;
+    }
+
+    // move to the front of the LRU list, iterators stay valid
+    m_entries.splice(m_entries.begin(), m_entries, itr->second);
+
+    std::vector<dtPolyRef> const& cached = itr->second->path;
+    std::copy(cached.begin(), cached.end(), path);
+    length = uint32(cached.size());
+
+    ++m_stats.hits;
+    return true;
+}
+
+/**
+ * @brief Stores a complete corridor, evicting the least recently used ones when full.
+ * @param mapId Map of the navmesh.
+ * @param includeFlags Include flags of the query filter.
+ * @param excludeFlags Exclude flags of the query filter.
+ * @param path Corridor from its start to its end polygon.
+ * @param length Length of the corridor, at least 2.
+ */
+void PathCache::Store(uint32 mapId, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* path, uint32 length)
+{
+    uint32 capacity = sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE);
+    if (!capacity || length < 2)
+    {
+        return;
+    }
+
+    Key key;
+    key.mapId = mapId;
+    key.includeFlags = includeFlags;
+    key.excludeFlags = excludeFlags;
+    key.startPoly = path[0];
+    key.endPoly = path[length - 1];
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    EntryMap::iterator itr = m_index.find(key);
+    if (itr != m_index.end())
+    {
+        // another unit found the same corridor meanwhile
+        itr->second->path.assign(path, path + length);
+        m_entries.splice(m_entries.begin(), m_entries, itr->second);
+        return;
+    }
+
+    // the capacity may have been lowered by a config reload
+    while (m_index.size() >= capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+        ++m_stats.evicted;
+    }
+
+    m_entries.push_front(Entry());
+    Entry& entry = m_entries.front();
+    entry.key = key;
+    entry.path.assign(path, path + length);
+    m_index[key] = m_entries.begin();
+}
+
+/**
+ * @brief Drops all corridors passing through a tile, called before the tile is removed.
+ * @param mapId Map of the navmesh.
+ * @param navMesh Navmesh the tile belongs to.
+ * @param tileRef Tile to be removed.
+ */
+void PathCache::InvalidateTile(uint32 mapId, dtNavMesh const* navMesh, dtTileRef tileRef)
+{
+    // tile refs are encoded like poly refs with a zero poly index
+    unsigned int tileIndex = navMesh->decodePolyIdTile(tileRef);
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    for (EntryList::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        bool passes = false;
+        if (itr->key.mapId == mapId)
+        {
+            for (std::vector<dtPolyRef>::const_iterator poly = itr->path.begin(); poly != itr->path.end(); ++poly)
+            {
+                if (navMesh->decodePolyIdTile(*poly) == tileIndex)
+                {
+                    passes = true;
+                    break;
+                }
+            }
+        }
+
+        if (passes)
+        {
+            m_index.erase(itr->key);
+            itr = m_entries.erase(itr);
+            ++m_stats.invalidated;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+/**
+ * @brief Drops all corridors of a map, called when its navmesh is freed.
+ * @param mapId Map of the navmesh.
+ */
+void PathCache::InvalidateMap(uint32 mapId)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    for (EntryList::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->key.mapId == mapId)
+        {
+            m_index.erase(itr->key);
+            itr = m_entries.erase(itr);
+            ++m_stats.invalidated;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+/**
+ * @brief Returns a copy of the cache statistics.
+ * @param stats Receives the statistics.
+ */
+void PathCache::GetStats(PathCacheStats& stats)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    m_stats.size = uint32(m_index.size());
+    stats = m_stats;
+}
@@ -0,0 +1,167 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#ifndef MANGOS_PATH_CACHE_H
+#define MANGOS_PATH_CACHE_H
+
+#include <ace/Thread_Mutex.h>
+
+#include "DetourNavMesh.h"
+
+#include "Common.h"
+
+#include <list>
+#include <vector>
+
+/**
+ * @brief Statistics of the path cache.
+ */
+struct PathCacheStats
+{
+    PathCacheStats() : hits(0), misses(0), evicted(0), invalidated(0), size(0) {}
+
+    uint32 hits;        ///< Corridors taken from the cache.
+    uint32 misses;      ///< Corridors searched with findPath.
+    uint32 evicted;     ///< Entries dropped to stay within mmap.pathCacheSize.
+    uint32 invalidated; ///< Entries dropped because a tile of their corridor was unloaded.
+    uint32 size;        ///< Entries currently cached.
+};
+
+/**
+ * @brief Bounded LRU cache of poly corridors found by PathFinder.
+ *
+ * Units chasing the same target or following the same owner keep asking
+ * for paths between the same polygons. The corridor returned by findPath
+ * is stored by start poly, end poly and query filter, so only the
+ * smoothing of the path has to be done again. Only complete corridors are
+ * cached: tiles loaded later can not make them invalid, tiles unloaded do
+ * and drop them through InvalidateTile. The navmesh is shared by all
+ * instances of a map, so is the cache.
+ *
+ * The cache is accessed by the map threads and the region threads, all
+ * members are guarded by one lock.
+ */
+class PathCache
+{
+    public:
+        /**
+         * @brief Constructor for PathCache.
+         */
+        PathCache() {}
+
+        /**
+         * @brief Looks up a corridor, marking it as recently used.
+         * @param mapId Map of the navmesh.
+         * @param startPoly First polygon of the corridor.
+         * @param endPoly Last polygon of the corridor.
+         * @param includeFlags Include flags of the query filter.
+         * @param excludeFlags Exclude flags of the query filter.
+         * @param path Receives the corridor, at least maxLength polygons.
+         * @param length Receives the length of the corridor.
+         * @param maxLength Capacity of path.
+         * @return True if the corridor was cached.
+         */
+        bool Find(uint32 mapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                  dtPolyRef* path, uint32& length, uint32 maxLength);
+
+        /**
+         * @brief Stores a complete corridor, evicting the least recently used ones when full.
+         * @param mapId Map of the navmesh.
+         * @param includeFlags Include flags of the query filter.
+         * @param excludeFlags Exclude flags of the query filter.
+         * @param path Corridor from its start to its end polygon.
+         * @param length Length of the corridor, at least 2.
+         */
+        void Store(uint32 mapId, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* path, uint32 length);
+
+        /**
+         * @brief Drops all corridors passing through a tile, called before the tile is removed.
+         * @param mapId Map of the navmesh.
+         * @param navMesh Navmesh the tile belongs to.
+         * @param tileRef Tile to be removed.
+         */
+        void InvalidateTile(uint32 mapId, dtNavMesh const* navMesh, dtTileRef tileRef);
+
+        /**
+         * @brief Drops all corridors of a map, called when its navmesh is freed.
+         * @param mapId Map of the navmesh.
+         */
+        void InvalidateMap(uint32 mapId);
+
+        /**
+         * @brief Returns a copy of the cache statistics.
+         * @param stats Receives the statistics.
+         */
+        void GetStats(PathCacheStats& stats);
+
+    private:
+        PathCache(PathCache const&);
+        PathCache& operator=(PathCache const&);
+
+        /**
+         * @brief Identifies a corridor.
+         */
+        struct Key
+        {
+            uint32 mapId;
+            uint16 includeFlags;
+            uint16 excludeFlags;
+            dtPolyRef startPoly;
+            dtPolyRef endPoly;
+
+            bool operator==(Key const& other) const
+            {
+                return mapId == other.mapId && startPoly == other.startPoly && endPoly == other.endPoly &&
+                       includeFlags == other.includeFlags && excludeFlags == other.excludeFlags;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const
+            {
+                uint64 h = uint64(key.startPoly) * 0x9E3779B97F4A7C15ULL;
+                h ^= uint64(key.endPoly) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+                h ^= (uint64(key.mapId) << 32 | uint32(key.includeFlags) << 16 | key.excludeFlags) + (h << 6) + (h >> 2);
+                return size_t(h);
+            }
+        };
+
+        struct Entry
+        {
+            Key key;
+            std::vector<dtPolyRef> path;
+        };
+
+        typedef std::list<Entry> EntryList;
+        typedef UNORDERED_MAP<Key, EntryList::iterator, KeyHash> EntryMap;
+
+        ACE_Thread_Mutex m_lock;    ///< Guards all members.
+        EntryList m_entries;        ///< Most recently used first.
+        EntryMap m_index;           ///< Entries by key.
+        PathCacheStats m_stats;     ///< Statistics, size is kept up to date on GetStats.
+};
+
+#endif // MANGOS_PATH_CACHE_H
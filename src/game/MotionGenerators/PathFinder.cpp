@@ -29,6 +29,7 @@
 #include "Creature.h"
 #include "Map.h"
 #include "PathFinder.h"
+#include "PathFinderBatch.h"
 #include "Log.h"
 
 ////////////////// PathFinder //////////////////
@@ -40,7 +41,7 @@
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL)
+    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL), m_batch(NULL)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathFinder for %s \n", m_sourceUnit->GetGuidStr().c_str());
 
@@ -64,6 +65,11 @@ PathFinder::PathFinder(const Unit* owner) :
 PathFinder::~PathFinder()
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::~PathFinder() for %s \n", m_sourceUnit->GetGuidStr().c_str());
+
+    if (m_batch)
+    {
+        m_batch->Remove(this);
+    }
 }
 
 /**
@@ -76,6 +82,65 @@ PathFinder::~PathFinder()
  */
 bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest)
 {
+    bool buildPath;
+    if (!prepare(destX, destY, destZ, forceDest, buildPath))
+    {
+        return false;
+    }
+
+    if (buildPath)
+    {
+        BuildPolyPath(getStartPosition(), getEndPosition());
+    }
+
+    return true;
+}
+
+/**
+ * @brief Calculates the path like calculate(), the navmesh search is left to the map's PathFinderBatch.
+ * @param destX The X-coordinate of the destination.
+ * @param destY The Y-coordinate of the destination.
+ * @param destZ The Z-coordinate of the destination.
+ * @param forceDest Whether to force the destination.
+ * @return False if the coordinates are invalid, true otherwise.
+ */
+bool PathFinder::calculateBatched(float destX, float destY, float destZ, bool forceDest)
+{
+    // a newer request replaces a pending one
+    if (m_batch)
+    {
+        m_batch->Remove(this);
+        m_batch = NULL;
+    }
+
+    bool buildPath;
+    if (!prepare(destX, destY, destZ, forceDest, buildPath))
+    {
+        return false;
+    }
+
+    if (buildPath)
+    {
+        m_batch = &m_sourceUnit->GetMap()->GetPathFinderBatch();
+        m_batch->Add(this);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sets up start, destination and filter of a new path.
+ * @param destX The X-coordinate of the destination.
+ * @param destY The Y-coordinate of the destination.
+ * @param destZ The Z-coordinate of the destination.
+ * @param forceDest Whether to force the destination.
+ * @param buildPath Set if the path still needs a navmesh search.
+ * @return False if the coordinates are invalid, true otherwise.
+ */
+bool PathFinder::prepare(float destX, float destY, float destZ, bool forceDest, bool& buildPath)
+{
+    buildPath = false;
+
     float x, y, z;
     m_sourceUnit->GetPosition(x, y, z);
 
@@ -106,10 +171,32 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     updateFilter();
 
-    BuildPolyPath(start, dest);
+    buildPath = true;
     return true;
 }
 
+/**
+ * @brief Builds a queued path with the query object of the calling task.
+ * @param query Query object of the calling task, NULL if the navmesh is gone.
+ */
+void PathFinder::solveBatched(dtNavMeshQuery const* query)
+{
+    m_batch = NULL;
+
+    if (!query)
+    {
+        BuildShortcut();
+        m_type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return;
+    }
+
+    // the query of the map instance is not thread safe, use the one of the task
+    dtNavMeshQuery const* ownQuery = m_navMeshQuery;
+    m_navMeshQuery = query;
+    BuildPolyPath(getStartPosition(), getEndPosition());
+    m_navMeshQuery = ownQuery;
+}
+
 /**
  * @brief Gets the nearest polygon reference by position.
  * @param polyPath The polygon path.
@@ -436,23 +523,40 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // units chasing the same target usually search between the same polygons
+        PathCache& cache = MMAP::MMapFactory::createOrGetMMapManager()->GetPathCache();
+        uint16 includeFlags = m_filter.getIncludeFlags();
+        uint16 excludeFlags = m_filter.getExcludeFlags();
+        if (cache.Find(m_sourceUnit->GetMapId(), startPoly, endPoly, includeFlags, excludeFlags, m_pathPolyRefs, m_polyLength, MAX_PATH_LENGTH))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("Path Build failed: 0 length path for %s", m_sourceUnit->GetGuidStr().c_str());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: cached corridor of %u polys for %s\n", m_polyLength, m_sourceUnit->GetGuidStr().c_str());
+        }
+        else
+        {
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("Path Build failed: 0 length path for %s", m_sourceUnit->GetGuidStr().c_str());
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            // partial corridors may be completed by tiles loaded later, keep only complete ones
+            if (m_pathPolyRefs[m_polyLength - 1] == endPoly && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT))
+            {
+                cache.Store(m_sourceUnit->GetMapId(), includeFlags, excludeFlags, m_pathPolyRefs, m_polyLength);
+            }
         }
     }
 
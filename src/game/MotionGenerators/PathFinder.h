@@ -35,6 +35,7 @@ using Movement::Vector3;
 using Movement::PointsArray;
 
 class Unit;
+class PathFinderBatch;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -89,6 +90,25 @@ class PathFinder
          */
         bool calculate(float destX, float destY, float destZ, bool forceDest = false);
 
+        /**
+         * @brief Calculate the path like calculate(), but leave the navmesh search to the PathFinderBatch of the map.
+         *
+         * Paths which need no search are done at once. Otherwise the path is built
+         * at the end of the current map update, IsPending() is true until then.
+         * @param destX X-coordinate of the destination.
+         * @param destY Y-coordinate of the destination.
+         * @param destZ Z-coordinate of the destination.
+         * @param forceDest Whether to force the destination.
+         * @return False if the coordinates are invalid, true otherwise.
+         */
+        bool calculateBatched(float destX, float destY, float destZ, bool forceDest = false);
+
+        /**
+         * @brief Check if a batched path is still waiting to be built.
+         * @return True while the path is queued.
+         */
+        bool IsPending() const { return m_batch != NULL; }
+
         // Option setters - use optional
         /**
          * @brief Set whether to use a straight path.
@@ -140,6 +160,7 @@ class PathFinder
         PathType getPathType() const { return m_type; }
 
     private:
+        friend class PathFinderBatch;
 
         dtPolyRef      m_pathPolyRefs[MAX_PATH_LENGTH];   // Array of detour polygon references
         uint32         m_polyLength;                      // Number of polygons in the path
@@ -161,6 +182,25 @@ class PathFinder
 
         dtQueryFilter m_filter;                     // Use a single filter for all movements, update it when needed
 
+        PathFinderBatch* m_batch;                   // Batch the path is queued in, NULL when not pending
+
+        /**
+         * @brief Set up start, destination and filter of a new path.
+         * @param destX X-coordinate of the destination.
+         * @param destY Y-coordinate of the destination.
+         * @param destZ Z-coordinate of the destination.
+         * @param forceDest Whether to force the destination.
+         * @param buildPath Set if the path still needs a navmesh search.
+         * @return False if the coordinates are invalid, true otherwise.
+         */
+        bool prepare(float destX, float destY, float destZ, bool forceDest, bool& buildPath);
+
+        /**
+         * @brief Build a queued path, called by the PathFinderBatch.
+         * @param query Query object of the calling task, NULL if the navmesh is gone.
+         */
+        void solveBatched(dtNavMeshQuery const* query);
+
         /**
          * @brief Set the start position of the path.
          * @param point The start position.
@@ -0,0 +1,185 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "PathFinderBatch.h"
+#include "PathFinder.h"
+#include "MoveMap.h"
+#include "MapManager.h"
+#include "World.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+/// Paths below this count are built by the map thread itself.
+static const size_t PATHS_PER_TASK = 8;
+
+/**
+ * @brief Constructor for PathFinderBatch.
+ * @param mapId Map the paths are built on.
+ */
+PathFinderBatch::PathFinderBatch(uint32 mapId) : m_mapId(mapId), m_queriesMesh(NULL), m_lastSolved(0)
+{
+}
+
+/**
+ * @brief Destructor for PathFinderBatch, frees the query objects.
+ */
+PathFinderBatch::~PathFinderBatch()
+{
+    FreeQueries();
+}
+
+/**
+ * @brief Queues a prepared path, may be called from region workers.
+ * @param path Path to be built.
+ */
+void PathFinderBatch::Add(PathFinder* path)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    m_queued.push_back(path);
+}
+
+/**
+ * @brief Drops a queued path, called when its PathFinder is destroyed.
+ * @param path Path not to be built.
+ */
+void PathFinderBatch::Remove(PathFinder* path)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    std::replace(m_queued.begin(), m_queued.end(), path, (PathFinder*)NULL);
+}
+
+/**
+ * @brief Builds all queued paths and waits for completion.
+ *
+ * Called by the map thread once all objects are updated, so neither the
+ * units nor the navmesh tiles change while the paths are built.
+ */
+void PathFinderBatch::Solve()
+{
+    std::vector<PathFinder*> paths;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+        paths.swap(m_queued);
+    }
+
+    paths.erase(std::remove(paths.begin(), paths.end(), (PathFinder*)NULL), paths.end());
+    m_lastSolved = paths.size();
+    if (paths.empty())
+    {
+        return;
+    }
+
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    dtNavMesh const* navMesh = mmap->GetNavMesh(m_mapId);
+
+    MapRegionUpdater& pool = sMapMgr.GetRegionUpdater();
+    size_t maxTasks = pool.activated() ? std::max<uint32>(sWorld.getConfig(CONFIG_UINT32_REGION_UPDATE_THREADS), 1) : 1;
+    size_t perTask = std::max(PATHS_PER_TASK, (paths.size() + maxTasks - 1) / maxTasks);
+    size_t taskCount = (paths.size() + perTask - 1) / perTask;
+
+    if (!navMesh || !PrepareQueries(navMesh, taskCount))
+    {
+        // the mesh went away, the paths fall back to straight lines
+        for (std::vector<PathFinder*>::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+        {
+            (*itr)->solveBatched(NULL);
+        }
+        return;
+    }
+
+    if (taskCount == 1)
+    {
+        for (std::vector<PathFinder*>::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+        {
+            (*itr)->solveBatched(m_queries[0]);
+        }
+        return;
+    }
+
+    MapRegionUpdater::TaskList tasks;
+    for (size_t task = 0; task < taskCount; ++task)
+    {
+        size_t begin = task * perTask;
+        size_t end = std::min(begin + perTask, paths.size());
+        dtNavMeshQuery* query = m_queries[task];
+        tasks.push_back([&paths, query, begin, end]()
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                paths[i]->solveBatched(query);
+            }
+        });
+    }
+
+    pool.run_tasks(tasks);
+}
+
+/**
+ * @brief Makes sure there is one query object per task.
+ * @param navMesh Mesh of the map.
+ * @param count Number of query objects needed.
+ * @return False if a query could not be initialized.
+ */
+bool PathFinderBatch::PrepareQueries(dtNavMesh const* navMesh, size_t count)
+{
+    // the mesh is recreated when all maps using it were unloaded
+    if (m_queriesMesh != navMesh)
+    {
+        FreeQueries();
+        m_queriesMesh = navMesh;
+    }
+
+    while (m_queries.size() < count)
+    {
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        MANGOS_ASSERT(query);
+        if (dtStatusFailed(query->init(navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            sLog.outError("PathFinderBatch: Failed to initialize dtNavMeshQuery for mapId %03u", m_mapId);
+            return false;
+        }
+
+        m_queries.push_back(query);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Frees all query objects.
+ */
+void PathFinderBatch::FreeQueries()
+{
+    for (std::vector<dtNavMeshQuery*>::const_iterator itr = m_queries.begin(); itr != m_queries.end(); ++itr)
+    {
+        dtFreeNavMeshQuery(*itr);
+    }
+
+    m_queries.clear();
+    m_queriesMesh = NULL;
+}
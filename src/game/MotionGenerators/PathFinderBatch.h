@@ -0,0 +1,108 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_PATH_FINDER_BATCH_H
+#define MANGOS_PATH_FINDER_BATCH_H
+
+#include <ace/Thread_Mutex.h>
+
+#include "Common.h"
+
+#include <vector>
+
+class PathFinder;
+class dtNavMesh;
+class dtNavMeshQuery;
+
+/**
+ * @brief Path requests of one map, solved together at the end of the map update.
+ *
+ * Movement generators queue their PathFinder with PathFinder::calculateBatched
+ * while objects are updated. Once all objects of the map are updated, Solve()
+ * builds the poly paths, on the MapUpdateRegionThreads pool when it is running,
+ * each task with its own dtNavMeshQuery. The generators pick the paths up in
+ * their next update.
+ */
+class PathFinderBatch
+{
+    public:
+        /**
+         * @brief Constructor for PathFinderBatch.
+         * @param mapId Map the paths are built on.
+         */
+        explicit PathFinderBatch(uint32 mapId);
+
+        /**
+         * @brief Destructor for PathFinderBatch, frees the query objects.
+         */
+        ~PathFinderBatch();
+
+        /**
+         * @brief Queues a prepared path, may be called from region workers.
+         * @param path Path to be built.
+         */
+        void Add(PathFinder* path);
+
+        /**
+         * @brief Drops a queued path, called when its PathFinder is destroyed.
+         * @param path Path not to be built.
+         */
+        void Remove(PathFinder* path);
+
+        /**
+         * @brief Builds all queued paths and waits for completion.
+         */
+        void Solve();
+
+        /**
+         * @brief Number of paths built by the last Solve() call.
+         */
+        uint32 GetLastSolvedCount() const { return m_lastSolved; }
+
+    private:
+        PathFinderBatch(PathFinderBatch const&);
+        PathFinderBatch& operator=(PathFinderBatch const&);
+
+        /**
+         * @brief Makes sure there is one query object per task.
+         * @param navMesh Mesh of the map.
+         * @param count Number of query objects needed.
+         * @return False if a query could not be initialized.
+         */
+        bool PrepareQueries(dtNavMesh const* navMesh, size_t count);
+
+        /**
+         * @brief Frees all query objects.
+         */
+        void FreeQueries();
+
+        const uint32 m_mapId;
+        ACE_Thread_Mutex m_lock;                ///< Protects m_queued.
+        std::vector<PathFinder*> m_queued;      ///< Paths waiting for Solve(), NULL when removed.
+        std::vector<dtNavMeshQuery*> m_queries; ///< One query object per task, they are not thread safe.
+        dtNavMesh const* m_queriesMesh;         ///< Mesh the query objects were initialized for.
+        uint32 m_lastSolved;
+};
+
+#endif // MANGOS_PATH_FINDER_BATCH_H
@@ -96,7 +96,36 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T& owner, bool up
     // allow pets following their master to cheat while generating paths
     bool forceDest = (owner.GetTypeId() == TYPEID_UNIT && ((Creature*)&owner)->IsPet()
                       && owner.hasUnitState(UNIT_STAT_FOLLOW));
-    i_path->calculate(x, y, z, forceDest);
+
+    // creature paths are built together at the end of the map update, possibly on the region threads
+    if (owner.GetTypeId() == TYPEID_UNIT && sWorld.getConfig(CONFIG_BOOL_MMAP_BATCHED_PATHS))
+    {
+        i_path->calculateBatched(x, y, z, forceDest);
+        if (i_path->IsPending())
+        {
+            i_pathQueued = true;
+            return;
+        }
+    }
+    else
+    {
+        i_path->calculate(x, y, z, forceDest);
+    }
+
+    _launchPath(owner);
+}
+
+/**
+ * @brief Start moving the owner along the calculated path.
+ *
+ * @tparam T The type of the owner.
+ * @tparam D The type of the derived class.
+ * @param owner The owner.
+ */
+template<class T, typename D>
+void TargetedMovementGeneratorMedium<T, D>::_launchPath(T& owner)
+{
+    i_pathQueued = false;
     if (i_path->getPathType() & PATHFIND_NOPATH)
     {
         return;
@@ -171,6 +200,17 @@ bool TargetedMovementGeneratorMedium<T, D>::Update(T& owner, const uint32& time_
         return true;
     }
 
+    // the path is still waiting for the end of the map update
+    if (i_path && i_path->IsPending())
+    {
+        return true;
+    }
+
+    if (i_pathQueued)
+    {
+        _launchPath(owner);
+    }
+
     bool targetMoved = false;
     i_recheckDistance.Update(time_diff);
     if (i_recheckDistance.Passed())
@@ -73,7 +73,7 @@ class TargetedMovementGeneratorMedium
             TargetedMovementGeneratorBase(target),
             i_recheckDistance(0),
             i_offset(offset), i_angle(angle),
-            m_speedChanged(false), i_targetReached(false),
+            m_speedChanged(false), i_targetReached(false), i_pathQueued(false),
             i_path(NULL)
         {
         }
@@ -117,6 +117,12 @@ class TargetedMovementGeneratorMedium
          */
         void _setTargetLocation(T&, bool updateDestination);
 
+        /**
+         * @brief Starts moving the unit along the calculated path.
+         * @param owner Reference to the unit.
+         */
+        void _launchPath(T&);
+
         /**
          * @brief Checks if a new position is required.
          * @param owner Reference to the unit.
@@ -141,6 +147,7 @@ class TargetedMovementGeneratorMedium
         G3D::Vector3 m_prevTargetPos; ///< Previous target position.
         bool m_speedChanged : 1; ///< Indicates if the speed has changed.
         bool i_targetReached : 1; ///< Indicates if the target has been reached.
+        bool i_pathQueued : 1; ///< Indicates if the path waits in the map's PathFinderBatch.
         PathFinder* i_path; ///< Path finder for the movement.
 };
 
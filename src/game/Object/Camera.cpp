@@ -28,8 +28,38 @@
 #include "Log.h"
 #include "Errors.h"
 #include "Player.h"
+#include "World.h"
 
-Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
+namespace
+{
+    /// Longest time visibility is updated on moves only, without checking the whole range again.
+    const uint32 VISIBILITY_FULL_UPDATE_INTERVAL = 5 * IN_MILLISECONDS;
+
+    /// Lowest coordinate of a cell, cell i covers [(i - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL, (i - CENTER_GRID_CELL_ID + 1) * SIZE_OF_GRID_CELL).
+    float CellLowBound(uint32 coord)
+    {
+        return (int32(coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    }
+
+    /// Tells if any point of the cell is within radius of the position.
+    bool CellReaches(float lowX, float lowY, float x, float y, float radius)
+    {
+        float dx = std::max(std::max(lowX - x, x - (lowX + SIZE_OF_GRID_CELL)), 0.0f);
+        float dy = std::max(std::max(lowY - y, y - (lowY + SIZE_OF_GRID_CELL)), 0.0f);
+        return dx * dx + dy * dy <= radius * radius;
+    }
+
+    /// Tells if all points of the cell are within radius of the position.
+    bool CellWithin(float lowX, float lowY, float x, float y, float radius)
+    {
+        float dx = std::max(x - lowX, lowX + SIZE_OF_GRID_CELL - x);
+        float dy = std::max(y - lowY, lowY + SIZE_OF_GRID_CELL - y);
+        return dx * dx + dy * dy <= radius * radius;
+    }
+}
+
+Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl),
+    m_lastUpdateX(0.0f), m_lastUpdateY(0.0f), m_lastUpdateValid(false), m_lastFullUpdateTime(0)
 {
     m_source->GetViewPoint().Attach(this);
 }
@@ -129,6 +159,8 @@ void Camera::Event_AddedToWorld()
 
 void Camera::Event_RemovedFromWorld()
 {
+    m_lastUpdateValid = false;
+
     if (m_source == &m_owner)
     {
         m_gridRef.unlink();
@@ -156,11 +188,92 @@ void Camera::UpdateVisibilityOf(WorldObject* target, UpdateData& data, std::set<
 
 void Camera::UpdateVisibilityForOwner()
 {
+    // stored first, Notify may change the view and update it again
+    m_lastUpdateX = m_source->GetPositionX();
+    m_lastUpdateY = m_source->GetPositionY();
+    m_lastUpdateValid = true;
+    m_lastFullUpdateTime = GameTime::GetGameTimeMS();
+
     MaNGOS::VisibleNotifier notifier(*this);
     Cell::VisitAllObjects(m_source, notifier, m_source->GetMap()->GetVisibilityDistance(), false);
     notifier.Notify();
 }
 
+/**
+ * @brief Updates visibility for the owner after the viewpoint moved.
+ *
+ * A cell which was wholly within visibility range of the viewpoint at the
+ * last update and still is can't hold an object whose visibility changed by
+ * the move: objects at client are kept without any check, objects changing
+ * their own state or moving report it to the cameras around them. Only the
+ * cells crossing the edge of the range, at the old or at the new position,
+ * are checked as in a full update.
+ *
+ * Objects report moves of more than the relocation lower limit only, so the
+ * kept cells have to be within range by that much. Leaving the range keeps
+ * the grey distance of the full checks.
+ *
+ * Stealthed traps are seen at a few yards only and are always checked. In
+ * flight the range is another one, so are the first update at a viewpoint
+ * and one every VISIBILITY_FULL_UPDATE_INTERVAL, which are full updates.
+ */
+void Camera::UpdateVisibilityForOwnerMoved()
+{
+    if (!m_lastUpdateValid || m_owner.IsTaxiFlying() ||
+        getMSTimeDiff(m_lastFullUpdateTime, GameTime::GetGameTimeMS()) >= VISIBILITY_FULL_UPDATE_INTERVAL)
+    {
+        UpdateVisibilityForOwner();
+        return;
+    }
+
+    Map* map = m_source->GetMap();
+    float x = m_source->GetPositionX();
+    float y = m_source->GetPositionY();
+    float lastX = m_lastUpdateX;
+    float lastY = m_lastUpdateY;
+    float range = map->GetVisibilityDistance();
+    float radius = range + m_source->GetObjectBoundingRadius();
+    float keepRange = range - sqrt(World::GetRelocationLowerLimitSq());
+
+    m_lastUpdateX = x;
+    m_lastUpdateY = y;
+
+    MaNGOS::VisibleNotifier notifier(*this);
+    MaNGOS::VisibleKeepNotifier keeper(notifier);
+    TypeContainerVisitor<MaNGOS::VisibleNotifier, GridTypeMapContainer > gridNotifier(notifier);
+    TypeContainerVisitor<MaNGOS::VisibleNotifier, WorldTypeMapContainer > worldNotifier(notifier);
+    TypeContainerVisitor<MaNGOS::VisibleKeepNotifier, GridTypeMapContainer > gridKeeper(keeper);
+    TypeContainerVisitor<MaNGOS::VisibleKeepNotifier, WorldTypeMapContainer > worldKeeper(keeper);
+
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+    for (uint32 loopX = area.low_bound.x_coord; loopX <= area.high_bound.x_coord; ++loopX)
+    {
+        float lowX = CellLowBound(loopX);
+        for (uint32 loopY = area.low_bound.y_coord; loopY <= area.high_bound.y_coord; ++loopY)
+        {
+            float lowY = CellLowBound(loopY);
+            if (!CellReaches(lowX, lowY, x, y, radius))
+            {
+                continue;
+            }
+
+            Cell cell(CellPair(loopX, loopY));
+            if (keepRange > 0.0f && CellWithin(lowX, lowY, x, y, keepRange) && CellWithin(lowX, lowY, lastX, lastY, keepRange))
+            {
+                map->Visit(cell, gridKeeper);
+                map->Visit(cell, worldKeeper);
+            }
+            else
+            {
+                map->Visit(cell, gridNotifier);
+                map->Visit(cell, worldNotifier);
+            }
+        }
+    }
+
+    notifier.Notify();
+}
+
 //////////////////
 
 ViewPoint::~ViewPoint()
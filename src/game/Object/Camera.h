@@ -62,6 +62,9 @@ class Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner();
 
+        // same after a move of the viewpoint, only cells at the edge of visibility range are checked again
+        void UpdateVisibilityForOwnerMoved();
+
     private:
         // called when viewpoint changes visibility state
         void Event_AddedToWorld();
@@ -72,6 +75,12 @@ class Camera
         Player& m_owner;
         WorldObject* m_source;
 
+        // viewpoint position at the last visibility update, valid until the viewpoint leaves the world
+        float m_lastUpdateX;
+        float m_lastUpdateY;
+        bool m_lastUpdateValid;
+        uint32 m_lastFullUpdateTime;
+
         void UpdateForCurrentViewPoint();
 
     public:
@@ -141,6 +150,11 @@ class ViewPoint
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
         }
+
+        void Call_UpdateVisibilityForOwnerMoved()
+        {
+            CameraCall(&Camera::UpdateVisibilityForOwnerMoved);
+        }
 };
 
 #endif
@@ -0,0 +1,206 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "ClientGuidSet.h"
+
+namespace
+{
+    /// Slots allocated by the first insert, enough for a quiet zone.
+    const size_t MIN_SLOTS = 64;
+}
+
+ClientGuidSet::ClientGuidSet() : m_size(0), m_pass(0)
+{
+}
+
+ClientGuidSet::const_iterator ClientGuidSet::begin() const
+{
+    if (m_slots.empty())
+    {
+        return const_iterator();
+    }
+
+    return const_iterator(&m_slots[0], &m_slots[0] + m_slots.size());
+}
+
+ClientGuidSet::const_iterator ClientGuidSet::end() const
+{
+    if (m_slots.empty())
+    {
+        return const_iterator();
+    }
+
+    Slot const* last = &m_slots[0] + m_slots.size();
+    return const_iterator(last, last);
+}
+
+size_t ClientGuidSet::Home(ObjectGuid guid) const
+{
+    // counters of the same high guid are sequential, the multiplication spreads them over the upper bits
+    uint64 hash = guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15);
+    return size_t(hash >> 32) & (m_slots.size() - 1);
+}
+
+size_t ClientGuidSet::Find(ObjectGuid guid) const
+{
+    if (m_slots.empty() || guid.IsEmpty())
+    {
+        return NO_SLOT;
+    }
+
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = Home(guid);; i = (i + 1) & mask)
+    {
+        if (m_slots[i].guid == guid)
+        {
+            return i;
+        }
+
+        if (m_slots[i].guid.IsEmpty())
+        {
+            return NO_SLOT;
+        }
+    }
+}
+
+void ClientGuidSet::Grow()
+{
+    SlotVector slots(m_slots.empty() ? MIN_SLOTS : m_slots.size() * 2);
+    m_slots.swap(slots);
+
+    size_t mask = m_slots.size() - 1;
+    for (SlotVector::const_iterator itr = slots.begin(); itr != slots.end(); ++itr)
+    {
+        if (itr->guid.IsEmpty())
+        {
+            continue;
+        }
+
+        size_t i = Home(itr->guid);
+        while (!m_slots[i].guid.IsEmpty())
+        {
+            i = (i + 1) & mask;
+        }
+
+        m_slots[i] = *itr;
+    }
+}
+
+bool ClientGuidSet::insert(ObjectGuid guid)
+{
+    MANGOS_ASSERT(!guid.IsEmpty());
+
+    // kept at most 3/4 full, so probe runs stay short
+    if ((m_size + 1) * 4 > m_slots.size() * 3)
+    {
+        Grow();
+    }
+
+    size_t mask = m_slots.size() - 1;
+    size_t i = Home(guid);
+    for (; !m_slots[i].guid.IsEmpty(); i = (i + 1) & mask)
+    {
+        if (m_slots[i].guid == guid)
+        {
+            m_slots[i].pass = m_pass;
+            return false;
+        }
+    }
+
+    m_slots[i].guid = guid;
+    m_slots[i].pass = m_pass;
+    ++m_size;
+    return true;
+}
+
+bool ClientGuidSet::erase(ObjectGuid guid)
+{
+    size_t hole = Find(guid);
+    if (hole == NO_SLOT)
+    {
+        return false;
+    }
+
+    // shift the following guids of the run back, so no lookup stops at the freed slot
+    size_t mask = m_slots.size() - 1;
+    for (size_t i = (hole + 1) & mask; !m_slots[i].guid.IsEmpty(); i = (i + 1) & mask)
+    {
+        // a guid may fill the hole if its home slot is not between the hole and its slot
+        if (((i - Home(m_slots[i].guid)) & mask) >= ((i - hole) & mask))
+        {
+            m_slots[hole] = m_slots[i];
+            hole = i;
+        }
+    }
+
+    m_slots[hole].guid = ObjectGuid();
+    --m_size;
+    return true;
+}
+
+void ClientGuidSet::clear()
+{
+    for (SlotVector::iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+    {
+        itr->guid = ObjectGuid();
+    }
+
+    m_size = 0;
+}
+
+bool ClientGuidSet::Mark(ObjectGuid guid)
+{
+    size_t i = Find(guid);
+    if (i == NO_SLOT)
+    {
+        return false;
+    }
+
+    m_slots[i].pass = m_pass;
+    return true;
+}
+
+bool ClientGuidSet::IsUnmarked(ObjectGuid guid, uint32 pass) const
+{
+    size_t i = Find(guid);
+    return i != NO_SLOT && IsOlder(m_slots[i].pass, pass);
+}
+
+void ClientGuidSet::ExtractUnmarked(uint32 pass, GuidSet& guids)
+{
+    std::vector<ObjectGuid> unmarked;
+    for (SlotVector::const_iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+    {
+        if (!itr->guid.IsEmpty() && IsOlder(itr->pass, pass))
+        {
+            unmarked.push_back(itr->guid);
+        }
+    }
+
+    for (std::vector<ObjectGuid>::const_iterator itr = unmarked.begin(); itr != unmarked.end(); ++itr)
+    {
+        erase(*itr);
+        guids.insert(*itr);
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_CLIENTGUIDSET_H
+#define MANGOS_CLIENTGUIDSET_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+#include <vector>
+
+/**
+ * @brief Guids of the objects a player's client knows about.
+ *
+ * An open addressing hash set: lookups are a hash and a short scan of one
+ * array instead of a walk down a tree, HaveAtClient being called for every
+ * object of every visibility pass.
+ *
+ * Each guid also carries the number of the last visibility pass which saw
+ * its object (see BeginPass). A pass marks the objects it meets, whatever
+ * is left unmarked at its end is out of range. Guids added during a pass
+ * count as seen by it.
+ *
+ * Iteration order is unspecified, and the set must not be changed while it
+ * is iterated.
+ */
+class ClientGuidSet
+{
+    private:
+        struct Slot
+        {
+            ObjectGuid guid;                                // empty guid for a free slot
+            uint32 pass;
+        };
+
+        typedef std::vector<Slot> SlotVector;
+
+    public:
+        class const_iterator
+        {
+            public:
+                const_iterator() : m_slot(NULL), m_end(NULL) {}
+
+                ObjectGuid const& operator*() const { return m_slot->guid; }
+                ObjectGuid const* operator->() const { return &m_slot->guid; }
+
+                const_iterator& operator++()
+                {
+                    ++m_slot;
+                    SkipFree();
+                    return *this;
+                }
+
+                bool operator==(const_iterator const& other) const { return m_slot == other.m_slot; }
+                bool operator!=(const_iterator const& other) const { return m_slot != other.m_slot; }
+
+            private:
+                friend class ClientGuidSet;
+
+                const_iterator(Slot const* slot, Slot const* end) : m_slot(slot), m_end(end) { SkipFree(); }
+
+                void SkipFree()
+                {
+                    while (m_slot != m_end && m_slot->guid.IsEmpty())
+                    {
+                        ++m_slot;
+                    }
+                }
+
+                Slot const* m_slot;
+                Slot const* m_end;
+        };
+
+        typedef const_iterator iterator;
+
+        ClientGuidSet();
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        size_t count(ObjectGuid guid) const { return Find(guid) != NO_SLOT ? 1 : 0; }
+
+        /**
+         * @brief Adds a guid, marked as seen by the current pass.
+         * @return False if it was already stored.
+         */
+        bool insert(ObjectGuid guid);
+
+        /**
+         * @return False if the guid was not stored.
+         */
+        bool erase(ObjectGuid guid);
+
+        /**
+         * @brief Removes all guids, the allocated slots are kept.
+         */
+        void clear();
+
+        /**
+         * @brief Starts a visibility pass.
+         * @return Number of the pass, to be given to IsUnmarked and ExtractUnmarked.
+         */
+        uint32 BeginPass() { return ++m_pass; }
+
+        /**
+         * @brief Marks a stored guid as seen by the current pass.
+         * @return False if the guid is not stored.
+         */
+        bool Mark(ObjectGuid guid);
+
+        /**
+         * @brief Checks if a guid is stored and was not seen since the pass started.
+         * @param guid
+         * @param pass Number returned by BeginPass.
+         */
+        bool IsUnmarked(ObjectGuid guid, uint32 pass) const;
+
+        /**
+         * @brief Removes the guids not seen since the pass started.
+         * @param pass Number returned by BeginPass.
+         * @param guids Receives the removed guids.
+         */
+        void ExtractUnmarked(uint32 pass, GuidSet& guids);
+
+    private:
+        static const size_t NO_SLOT = size_t(-1);
+
+        size_t Home(ObjectGuid guid) const;
+        size_t Find(ObjectGuid guid) const;
+        void Grow();
+
+        // a pass started before another one is older, also once the counter wraps
+        static bool IsOlder(uint32 pass, uint32 other) { return int32(pass - other) < 0; }
+
+        SlotVector m_slots;                                 // power of two sized, or empty
+        size_t m_size;
+        uint32 m_pass;
+};
+
+#endif
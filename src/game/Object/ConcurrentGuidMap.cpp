@@ -0,0 +1,266 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "ConcurrentGuidMap.h"
+
+namespace
+{
+    /// Smallest table, also the size of an empty map.
+    const size_t MIN_ENTRIES = 64;
+
+    /// Reader slots in use by a living thread, shared by all maps.
+    std::atomic<bool> s_threadSlotUsed[ConcurrentGuidMapBase::MAX_READER_THREADS];
+
+    /// Reader slot of the calling thread, given back when the thread ends.
+    struct ThreadSlot
+    {
+        int32 index;
+
+        ThreadSlot() : index(-1)
+        {
+            for (uint32 i = 0; i < ConcurrentGuidMapBase::MAX_READER_THREADS; ++i)
+            {
+                bool used = false;
+                if (s_threadSlotUsed[i].compare_exchange_strong(used, true))
+                {
+                    index = int32(i);
+                    break;
+                }
+            }
+        }
+
+        ~ThreadSlot()
+        {
+            if (index >= 0)
+            {
+                s_threadSlotUsed[index].store(false);
+            }
+        }
+    };
+}
+
+ConcurrentGuidMapBase::Snapshot::Snapshot(size_t capacity) : m_entries(capacity), m_size(0)
+{
+}
+
+size_t ConcurrentGuidMapBase::Snapshot::Home(ObjectGuid guid) const
+{
+    // counters of the same high guid are sequential, the multiplication spreads them over the upper bits
+    uint64 hash = guid.GetRawValue() * UI64LIT(0x9E3779B97F4A7C15);
+    return size_t(hash >> 32) & (m_entries.size() - 1);
+}
+
+/**
+ * @brief Entry holding the guid, or the free entry ending its probe run.
+ */
+size_t ConcurrentGuidMapBase::Snapshot::Slot(ObjectGuid guid) const
+{
+    size_t mask = m_entries.size() - 1;
+    size_t i = Home(guid);
+    while (!m_entries[i].guid.IsEmpty() && m_entries[i].guid != guid)
+    {
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+void* ConcurrentGuidMapBase::Snapshot::Find(ObjectGuid guid) const
+{
+    if (guid.IsEmpty())
+    {
+        return NULL;
+    }
+
+    Entry const& entry = m_entries[Slot(guid)];
+    return entry.guid.IsEmpty() ? NULL : entry.object;
+}
+
+void ConcurrentGuidMapBase::Snapshot::Put(ObjectGuid guid, void* object)
+{
+    Entry& entry = m_entries[Slot(guid)];
+    if (entry.guid.IsEmpty())
+    {
+        entry.guid = guid;
+        ++m_size;
+    }
+
+    entry.object = object;
+}
+
+ConcurrentGuidMapBase::Snapshot* ConcurrentGuidMapBase::Snapshot::CopyWith(ObjectGuid guid, void* object) const
+{
+    size_t size = m_size + (object ? 1 : 0);
+
+    // kept between 1/8 and 3/4 full, the size changes by one at most
+    size_t capacity = m_entries.size();
+    if (size * 4 > capacity * 3)
+    {
+        capacity *= 2;
+    }
+    else if (capacity > MIN_ENTRIES && size * 8 < capacity)
+    {
+        capacity /= 2;
+    }
+
+    Snapshot* copy = new Snapshot(capacity);
+    for (std::vector<Entry>::const_iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    {
+        if (!itr->guid.IsEmpty() && itr->guid != guid)
+        {
+            copy->Put(itr->guid, itr->object);
+        }
+    }
+
+    if (object)
+    {
+        copy->Put(guid, object);
+    }
+
+    return copy;
+}
+
+ConcurrentGuidMapBase::ReadGuard::ReadGuard(ConcurrentGuidMapBase const& map) :
+    m_map(map), m_slot(NULL), m_overflow(false), m_snapshot(NULL)
+{
+    int32 index = GetThreadSlot();
+    if (index < 0)
+    {
+        m_overflow = true;
+        m_map.m_overflowReaders.fetch_add(1);
+    }
+    else
+    {
+        std::atomic<uint64>& slot = m_map.m_readers[index].epoch;
+
+        // only this thread writes its slot, a set slot belongs to an outer guard
+        if (!slot.load(std::memory_order_relaxed))
+        {
+            slot.store(m_map.m_epoch.load());
+            m_slot = &slot;
+        }
+    }
+
+    // loaded after the announcement, a writer retiring it will see the reader
+    m_snapshot = m_map.m_current.load();
+}
+
+ConcurrentGuidMapBase::ReadGuard::~ReadGuard()
+{
+    if (m_slot)
+    {
+        m_slot->store(0, std::memory_order_release);
+    }
+    else if (m_overflow)
+    {
+        m_map.m_overflowReaders.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+ConcurrentGuidMapBase::ConcurrentGuidMapBase() : m_current(new Snapshot(MIN_ENTRIES)), m_epoch(1), m_overflowReaders(0)
+{
+    for (uint32 i = 0; i < MAX_READER_THREADS; ++i)
+    {
+        m_readers[i].epoch.store(0, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentGuidMapBase::~ConcurrentGuidMapBase()
+{
+    for (std::vector<RetiredSnapshot>::const_iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+    {
+        delete itr->snapshot;
+    }
+
+    delete m_current.load();
+}
+
+/**
+ * @brief Publishes a copy of the current snapshot with the guid set.
+ * @param guid
+ * @param object NULL removes the guid.
+ */
+void ConcurrentGuidMapBase::Set(ObjectGuid guid, void* object)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_writeLock);
+
+    Snapshot* current = m_current.load(std::memory_order_relaxed);
+    if (current->Find(guid) == object)
+    {
+        return;
+    }
+
+    m_current.store(current->CopyWith(guid, object));
+
+    // readers announcing a later epoch started after the store and can't have the old snapshot
+    RetiredSnapshot retired;
+    retired.epoch = m_epoch.fetch_add(1);
+    retired.snapshot = current;
+    m_retired.push_back(retired);
+
+    Reclaim();
+}
+
+/**
+ * @brief Frees the retired snapshots no reader can still use.
+ */
+void ConcurrentGuidMapBase::Reclaim()
+{
+    // overflow readers don't announce an epoch, hold everything back while there are some
+    if (m_overflowReaders.load())
+    {
+        return;
+    }
+
+    uint64 oldest = m_epoch.load();
+    for (uint32 i = 0; i < MAX_READER_THREADS; ++i)
+    {
+        uint64 epoch = m_readers[i].epoch.load();
+        if (epoch && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    std::vector<RetiredSnapshot>::iterator kept = m_retired.begin();
+    for (std::vector<RetiredSnapshot>::iterator itr = m_retired.begin(); itr != m_retired.end(); ++itr)
+    {
+        if (itr->epoch < oldest)
+        {
+            delete itr->snapshot;
+        }
+        else
+        {
+            *kept++ = *itr;
+        }
+    }
+
+    m_retired.erase(kept, m_retired.end());
+}
+
+int32 ConcurrentGuidMapBase::GetThreadSlot()
+{
+    static thread_local ThreadSlot slot;
+    return slot.index;
+}
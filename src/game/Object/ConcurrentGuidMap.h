@@ -0,0 +1,202 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_CONCURRENTGUIDMAP_H
+#define MANGOS_CONCURRENTGUIDMAP_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Guid to object map read from any thread without locking.
+ *
+ * The entries live in an immutable hash table, a snapshot. Writers, which
+ * are serialized by a mutex, copy the current snapshot, change the copy and
+ * publish it. Readers load the published snapshot and search it; they never
+ * wait for a writer or for each other.
+ *
+ * Replaced snapshots are freed once no reader can still use them: a reader
+ * announces the epoch it started in, in a slot of its own thread, and a
+ * snapshot retired at an epoch is only freed when no announced epoch is at
+ * or below it. Threads beyond MAX_READER_THREADS share one counter, which
+ * only holds back freeing while they read.
+ *
+ * Writes copy the whole table and are meant to be rare (login and logout).
+ */
+class ConcurrentGuidMapBase
+{
+    public:
+        /// Threads with their own reader slot, later ones share the overflow counter.
+        static const uint32 MAX_READER_THREADS = 128;
+
+    protected:
+        struct Entry
+        {
+            ObjectGuid guid;                                // empty guid for a free entry
+            void* object;
+        };
+
+        /**
+         * @brief Immutable open addressing table of one version of the map.
+         */
+        class Snapshot
+        {
+            public:
+                explicit Snapshot(size_t capacity);
+
+                void* Find(ObjectGuid guid) const;
+                size_t Size() const { return m_size; }
+
+                Entry const* Begin() const { return &m_entries[0]; }
+                Entry const* End() const { return &m_entries[0] + m_entries.size(); }
+
+                /**
+                 * @brief Copy of the table with a guid set to an object.
+                 * @param object NULL removes the guid.
+                 */
+                Snapshot* CopyWith(ObjectGuid guid, void* object) const;
+
+            private:
+                size_t Home(ObjectGuid guid) const;
+                size_t Slot(ObjectGuid guid) const;
+                void Put(ObjectGuid guid, void* object);
+
+                std::vector<Entry> m_entries;               // power of two sized
+                size_t m_size;
+        };
+
+        /**
+         * @brief Keeps the snapshot it loaded alive until destroyed.
+         *
+         * Nested guards of a thread share the outer guard's announcement.
+         */
+        class ReadGuard
+        {
+            public:
+                explicit ReadGuard(ConcurrentGuidMapBase const& map);
+                ~ReadGuard();
+
+                Snapshot const& Get() const { return *m_snapshot; }
+
+            private:
+                ReadGuard(ReadGuard const&);
+                ReadGuard& operator=(ReadGuard const&);
+
+                ConcurrentGuidMapBase const& m_map;
+                std::atomic<uint64>* m_slot;                // announced epoch, NULL for nested or overflow readers
+                bool m_overflow;
+                Snapshot const* m_snapshot;
+        };
+
+        ConcurrentGuidMapBase();
+        ~ConcurrentGuidMapBase();
+
+        void Set(ObjectGuid guid, void* object);
+
+    private:
+        ConcurrentGuidMapBase(ConcurrentGuidMapBase const&);
+        ConcurrentGuidMapBase& operator=(ConcurrentGuidMapBase const&);
+
+        struct RetiredSnapshot
+        {
+            uint64 epoch;
+            Snapshot* snapshot;
+        };
+
+        struct alignas(64) ReaderSlot                       // one cache line each, readers of different threads don't share lines
+        {
+            std::atomic<uint64> epoch;                      // 0 while the thread does not read
+        };
+
+        void Reclaim();
+
+        static int32 GetThreadSlot();
+
+        std::atomic<Snapshot*> m_current;
+        std::atomic<uint64> m_epoch;                        // starts at 1, 0 marks an idle reader slot
+        mutable std::atomic<uint32> m_overflowReaders;
+        mutable ReaderSlot m_readers[MAX_READER_THREADS];
+
+        ACE_Thread_Mutex m_writeLock;
+        std::vector<RetiredSnapshot> m_retired;
+};
+
+/**
+ * @brief ConcurrentGuidMapBase holding pointers to T.
+ */
+template<class T>
+class ConcurrentGuidMap : public ConcurrentGuidMapBase
+{
+    public:
+        void Insert(T* o) { Set(o->GetObjectGuid(), o); }
+        void Remove(T* o) { Set(o->GetObjectGuid(), NULL); }
+
+        T* Find(ObjectGuid guid) const
+        {
+            ReadGuard guard(*this);
+            return static_cast<T*>(guard.Get().Find(guid));
+        }
+
+        /**
+         * @brief Calls f for every stored object, as stored when the call started.
+         * @param f Called with a T*, may change the map.
+         */
+        template<typename F>
+        void ForEach(F&& f) const
+        {
+            ReadGuard guard(*this);
+            for (Entry const* itr = guard.Get().Begin(); itr != guard.Get().End(); ++itr)
+            {
+                if (!itr->guid.IsEmpty())
+                {
+                    f(static_cast<T*>(itr->object));
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the first stored object f accepts.
+         * @param f Called with a T*, returns true to stop.
+         * @return T* NULL if none was accepted.
+         */
+        template<typename F>
+        T* FindIf(F&& f) const
+        {
+            ReadGuard guard(*this);
+            for (Entry const* itr = guard.Get().Begin(); itr != guard.Get().End(); ++itr)
+            {
+                if (!itr->guid.IsEmpty() && f(static_cast<T*>(itr->object)))
+                {
+                    return static_cast<T*>(itr->object);
+                }
+            }
+
+            return NULL;
+        }
+};
+
+#endif
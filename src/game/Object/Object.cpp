@@ -201,10 +201,38 @@ void Object::SendCreateUpdateToPlayer(Player* player)
     player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache* cache) const
 {
     ByteBuffer& buf = data->GetBuffer();
 
+    // all viewers but the object itself see the same fields, serialize them only once
+    if (cache && target && target != this)
+    {
+        if (!cache->built)
+        {
+            cache->block << uint8(UPDATETYPE_VALUES);
+            cache->block << GetPackGUID();
+
+            UpdateMask updateMask;
+            updateMask.SetCount(m_valuesCount);
+
+            _SetUpdateBits(&updateMask, target);
+            BuildValuesUpdate(UPDATETYPE_VALUES, &cache->block, &updateMask, target, cache);
+            cache->built = true;
+        }
+
+        size_t start = buf.wpos();
+        buf.append(cache->block);
+
+        for (ValuesUpdateCache::PatchList::const_iterator itr = cache->patches.begin(); itr != cache->patches.end(); ++itr)
+        {
+            buf.put<uint32>(start + itr->second, GetUpdateFieldValueFor(itr->first, target));
+        }
+
+        data->AddUpdateBlock();
+        return;
+    }
+
     buf << uint8(UPDATETYPE_VALUES);
     buf << GetPackGUID();
 
@@ -330,18 +358,15 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateCache* cache) const
 {
     if (!target)
     {
         return;
     }
 
-    bool IsActivateToQuest = false;
     if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
     {
-        IsActivateToQuest = ((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster();
-
         updateMask->SetBit(GAMEOBJECT_DYN_FLAGS);
         if (updatetype == UPDATETYPE_VALUES)
         {
@@ -354,178 +379,212 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
     *data << (uint8)updateMask->GetBlockCount();
     updateMask->AppendToPacket(data);
 
-    // 2 specialized loops for speed optimization in non-unit case
-    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+    // 2 specialized loops for speed optimization in non-unit/gameobject case
+    if (isType(TYPEMASK_UNIT | TYPEMASK_GAMEOBJECT))
     {
         for (uint16 index = 0; index < m_valuesCount; ++index)
         {
             if (updateMask->GetBit(index))
             {
-                if (index == UNIT_NPC_FLAGS)
+                if (!IsViewerDependentField(index))
                 {
-                    uint32 appendValue = m_uint32Values[index];
-
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                            {
-                                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                            }
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                            {
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                            }
-                        }
-                    }
-
-                    *data << uint32(appendValue);
+                    *data << GetUpdateFieldValue(index);
                 }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+                else if (cache)                             // shared block, value is patched in per viewer
                 {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+                    cache->patches.push_back(std::make_pair(index, data->wpos()));
+                    *data << uint32(0);
                 }
-
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+                else
                 {
-                    *data << uint32(m_floatValues[index]);
+                    *data << GetUpdateFieldValueFor(index, target);
                 }
+            }
+        }
+    }
+    else                                                    // other objects case (no special index checks)
+    {
+        for (uint16 index = 0; index < m_valuesCount; ++index)
+        {
+            if (updateMask->GetBit(index))
+            {
+                // send in current format (float as float, uint32 as uint32)
+                *data << m_uint32Values[index];
+            }
+        }
+    }
+}
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                /* Hide loot animation for players that aren't permitted to loot the corpse */
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    uint32 send_value = m_uint32Values[index];
+bool Object::IsViewerDependentField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+                return GetTypeId() == TYPEID_UNIT;
+            case UNIT_FIELD_FLAGS:
+                return true;
+            default:
+                return false;
+        }
+    }
 
-                    /* Initiate pointer to creature so we can check loot */
-                    if (Creature* my_creature = (Creature*)this)
-                    {
-                        /* If the creature is NOT fully looted */
-                        if (!my_creature->loot.isLooted())
-                        {
-                            /* If the lootable flag is NOT set */
-                            if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
-                            {
-                                /* Update it on the creature */
-                                my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                                /* Update it in the packet */
-                                send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
-                            }
-                        }
-                    }
-                    /* If we're not allowed to loot the target, destroy the lootable flag */
-                    if (!target->isAllowedToLoot((Creature*)this))
-                    {
-                        if (send_value & UNIT_DYNFLAG_LOOTABLE)
-                        {
-                            send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
-                        }
-                    }
+    if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        return index == GAMEOBJECT_DYN_FLAGS;
+    }
 
-                    /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
-                    bool is_tapped = target->IsTappedByMeOrMyGroup((Creature*)this);
+    return false;
+}
 
-                    /* If the creature has tapped flag but is tapped by us, remove the flag */
-                    if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
-                    {
-                        send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
-                    }
+uint32 Object::GetUpdateFieldValue(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
+    {
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
 
-                    // Checking SPELL_AURA_EMPATHY and caster
-                    if (send_value & UNIT_DYNFLAG_SPECIALINFO && ((Unit*)this)->IsAlive())
-                    {
-                        bool bIsEmpathy = false;
-                        bool bIsCaster = false;
-                        Unit::AuraList const& mAuraEmpathy = ((Unit*)this)->GetAurasByType(SPELL_AURA_EMPATHY);
-                        for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
-                        {
-                            bIsEmpathy = true; // Empathy by aura set
-                            if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
-                            {
-                                bIsCaster = true; // target is the caster of an empathy aura
-                            }
-                        }
-                        if (bIsEmpathy && !bIsCaster) // Empathy by aura, but target is not the caster
-                        {
-                            send_value &= ~UNIT_DYNFLAG_SPECIALINFO;
-                        }
-                    }
+        // there are some float values which may be negative or can't get negative due to other checks
+        if ((index >= PLAYER_FIELD_NEGSTAT0    && index <= PLAYER_FIELD_NEGSTAT4) ||
+            (index >= PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+            (index >= PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (PLAYER_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+            (index >= PLAYER_FIELD_POSSTAT0    && index <= PLAYER_FIELD_POSSTAT4))
+        {
+            return uint32(m_floatValues[index]);
+        }
+    }
 
-                    *data << send_value;
-                }
-                else                                        // Unhandled index, just send
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
-                }
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
+
+uint32 Object::GetUpdateFieldValueFor(uint16 index, Player* target) const
+{
+    if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        if (index != GAMEOBJECT_DYN_FLAGS)
+        {
+            return m_uint32Values[index];
+        }
+
+        GameObject* go = (GameObject*)this;
+        if (go->IsTransport() || (!go->ActivateToQuest(target) && !target->isGameMaster()))
+        {
+            // disable quest object
+            return 0;
+        }
+
+        switch (go->GetGoType())
+        {
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GENERIC:
+            case GAMEOBJECT_TYPE_SPELL_FOCUS:
+            case GAMEOBJECT_TYPE_GOOBER:
+                return GO_DYNFLAG_LO_ACTIVATE;
+            default:
+                return 0;                                   // unknown, not happen.
+        }
+    }
+
+    if (index == UNIT_NPC_FLAGS && GetTypeId() == TYPEID_UNIT)
+    {
+        uint32 appendValue = m_uint32Values[index];
+
+        if (appendValue & UNIT_NPC_FLAG_TRAINER)
+        {
+            if (!((Creature*)this)->IsTrainerOf(target, false))
+            {
+                appendValue &= ~UNIT_NPC_FLAG_TRAINER;
             }
         }
+
+        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+        {
+            if (target->getClass() != CLASS_HUNTER)
+            {
+                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+            }
+        }
+
+        return appendValue;
     }
-    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
+
+    // Gamemasters should be always able to select units - remove not selectable flag
+    if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+    }
+
+    /* Hide loot animation for players that aren't permitted to loot the corpse */
+    if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
+    {
+        uint32 send_value = m_uint32Values[index];
+
+        /* Initiate pointer to creature so we can check loot */
+        if (Creature* my_creature = (Creature*)this)
         {
-            if (updateMask->GetBit(index))
+            /* If the creature is NOT fully looted */
+            if (!my_creature->loot.isLooted())
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint32(0);
-                    }
-                }
-                else
+                /* If the lootable flag is NOT set */
+                if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
                 {
-                    *data << m_uint32Values[index];          // other cases
+                    /* Update it on the creature */
+                    my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+                    /* Update it in the packet */
+                    send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
                 }
             }
         }
-    }
-    else                                                    // other objects case (no special index checks)
-    {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        /* If we're not allowed to loot the target, destroy the lootable flag */
+        if (!target->isAllowedToLoot((Creature*)this))
         {
-            if (updateMask->GetBit(index))
+            if (send_value & UNIT_DYNFLAG_LOOTABLE)
             {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
+                send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
             }
         }
+
+        /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
+        bool is_tapped = target->IsTappedByMeOrMyGroup((Creature*)this);
+
+        /* If the creature has tapped flag but is tapped by us, remove the flag */
+        if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
+        {
+            send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
+        }
+
+        // Checking SPELL_AURA_EMPATHY and caster
+        if (send_value & UNIT_DYNFLAG_SPECIALINFO && ((Unit*)this)->IsAlive())
+        {
+            bool bIsEmpathy = false;
+            bool bIsCaster = false;
+            Unit::AuraList const& mAuraEmpathy = ((Unit*)this)->GetAurasByType(SPELL_AURA_EMPATHY);
+            for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
+            {
+                bIsEmpathy = true; // Empathy by aura set
+                if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
+                {
+                    bIsCaster = true; // target is the caster of an empathy aura
+                }
+            }
+            if (bIsEmpathy && !bIsCaster) // Empathy by aura, but target is not the caster
+            {
+                send_value &= ~UNIT_DYNFLAG_SPECIALINFO;
+            }
+        }
+
+        return send_value;
     }
+
+    return GetUpdateFieldValue(index);
 }
 
 void Object::ClearUpdateMask(bool remove)
@@ -863,7 +922,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -874,7 +933,7 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, cache);
 }
 
 void Object::AddToClientUpdateList()
@@ -913,6 +972,7 @@ WorldObject::WorldObject() :
 #endif /* ENABLE_ELUNA */
     m_currMap(NULL),
     m_mapId(0), m_InstanceId(0),
+    m_positionIndex(NULL), m_positionIndexSlot(0),
     m_isActiveObject(false)
 {
 }
@@ -923,6 +983,12 @@ WorldObject::~WorldObject()
     delete elunaEvents;
     elunaEvents = nullptr;
 #endif /* ENABLE_ELUNA */
+
+    // objects deleted while listed in a grid (grid unloading) leave the lists through their references
+    if (m_positionIndex)
+    {
+        m_positionIndex->Remove(this);
+    }
 }
 
 void WorldObject::CleanupsBeforeDelete()
@@ -956,6 +1022,8 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
     }
+
+    UpdatePositionIndex();
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -968,6 +1036,16 @@ void WorldObject::Relocate(float x, float y, float z)
     {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
     }
+
+    UpdatePositionIndex();
+}
+
+void WorldObject::UpdatePositionIndex()
+{
+    if (m_positionIndex)
+    {
+        m_positionIndex->Update(this);
+    }
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1999,6 +2077,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateCache i_cache;                              // values block shared by all other viewers
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2016,7 +2095,7 @@ struct WorldObjectChangeAccumulator
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
             {
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_cache);
             }
         }
     }
@@ -80,6 +80,7 @@ class Map;
 class UpdateMask;
 class InstanceData;
 class TerrainInfo;
+class CellPositionIndex;
 #ifdef ENABLE_ELUNA
 class Eluna;
 class ElunaEventProcessor;
@@ -89,6 +90,22 @@ struct MangosStringLocale;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+/**
+ * Values update block of one object, serialized once and shared by all its viewers
+ * during one BuildUpdateData call. Only the viewer dependent fields listed in
+ * patches are rewritten for each viewer.
+ */
+struct ValuesUpdateCache
+{
+    typedef std::vector<std::pair<uint16, size_t> > PatchList;  // field index, offset of the value in block
+
+    ValuesUpdateCache() : block(0), built(false) {}
+
+    ByteBuffer block;
+    PatchList patches;
+    bool built;
+};
+
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -185,7 +202,7 @@ class Object
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateCache* cache = NULL) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target) const;
@@ -451,8 +468,12 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateCache* cache = NULL) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache* cache = NULL);
+
+        bool IsViewerDependentField(uint16 index) const;
+        uint32 GetUpdateFieldValue(uint16 index) const;
+        uint32 GetUpdateFieldValueFor(uint16 index, Player* target) const;
 
         uint16 m_objectType;
 
@@ -493,6 +514,7 @@ struct WorldObjectChangeAccumulator;
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class CellPositionIndex;
 
     public:
 
@@ -528,6 +550,9 @@ class WorldObject : public Object
 
         void SetOrientation(float orientation);
 
+        // copy position and size to the position index of the current cell, called by Relocate
+        void UpdatePositionIndex();
+
         float GetPositionX() const { return m_position.x; }
         float GetPositionY() const { return m_position.y; }
         float GetPositionZ() const { return m_position.z; }
@@ -720,6 +745,8 @@ class WorldObject : public Object
         uint32 m_InstanceId;                                // in map copy with instance id
 
         Position m_position;
+        CellPositionIndex* m_positionIndex;                 // index of the cell the object is listed in
+        uint32 m_positionIndexSlot;
         ViewPoint m_viewPoint;
         WorldUpdateCounter m_updateTracker;
         bool m_isActiveObject;
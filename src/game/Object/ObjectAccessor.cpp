@@ -108,13 +108,10 @@ Player* ObjectAccessor::FindPlayer(ObjectGuid guid, bool inWorld /*= true*/)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    ACE_READ_GUARD_RETURN(HashMapHolder<Player>::LockType, guard, i_playerMap.GetLock(), nullptr)
-    for (auto& iter : i_playerMap.GetContainer())
-        if (iter.second->IsInWorld() && (::strcmp(name, iter.second->GetName()) == 0))
-        {
-            return iter.second;
-        }
-    return nullptr;
+    return i_playerMap.FindIf([name](Player* player)
+    {
+        return player->IsInWorld() && ::strcmp(name, player->GetName()) == 0;
+    });
 }
 
 //This method should not be here
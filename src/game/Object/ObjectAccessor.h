@@ -35,6 +35,7 @@
 #include "Object.h"
 #include "Player.h"
 #include "Corpse.h"
+#include "ConcurrentGuidMap.h"
 
 #include <unordered_map>
 
@@ -51,42 +52,6 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         ObjectAccessor(const ObjectAccessor&);
         ObjectAccessor& operator=(const ObjectAccessor&);
 
-        template <class T>
-        struct HashMapHolder
-        {
-            using MapType = std::unordered_map<ObjectGuid, T*>;
-            using LockType = ACE_RW_Thread_Mutex;
-
-            HashMapHolder() : i_lock(nullptr), m_objectMap() {}
-
-            void Insert(T* o)
-            {
-                ACE_WRITE_GUARD(LockType, guard, i_lock)
-                m_objectMap[o->GetObjectGuid()] = o;
-            }
-
-            void Remove(T* o)
-            {
-                ACE_WRITE_GUARD(LockType, guard, i_lock)
-                m_objectMap.erase(o->GetObjectGuid());
-            }
-
-            T* Find(ObjectGuid guid)
-            {
-                ACE_READ_GUARD_RETURN (LockType, guard, i_lock, nullptr)
-                auto itr = m_objectMap.find(guid);
-                return (itr != m_objectMap.end()) ? itr->second : nullptr;
-            }
-
-            inline MapType& GetContainer() { return m_objectMap; }
-            inline LockType& GetLock() { return i_lock; }
-
-            LockType i_lock;
-            MapType  m_objectMap;
-            char _cache_guard[512];
-
-        };
-
         using Player2CorpsesMapType = std::unordered_map<ObjectGuid, Corpse*>;
         using LockType = ACE_Recursive_Thread_Mutex;
 
@@ -119,23 +84,17 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
         void RemoveObject(Corpse* object) { i_corpseMap.Remove(object); }
         void RemoveObject(Player* object) { i_playerMap.Remove(object); }
 
+        // players online when the call started, f may log players in or out
         template<typename F>
         void DoForAllPlayers(F&& f)
         {
-            ACE_READ_GUARD(HashMapHolder<Player>::LockType, g, i_playerMap.GetLock())
-            for (auto& iter : i_playerMap.GetContainer())
-            {
-                if(iter.second != nullptr)
-                {
-                    std::forward<F>(f)(iter.second);
-                }
-            }
+            i_playerMap.ForEach(std::forward<F>(f));
         }
 
     private:
         Player2CorpsesMapType  i_player2corpse;
-        HashMapHolder<Player>  i_playerMap;
-        HashMapHolder<Corpse>  i_corpseMap;
+        ConcurrentGuidMap<Player> i_playerMap;              // read by all map threads, see ConcurrentGuidMap
+        ConcurrentGuidMap<Corpse> i_corpseMap;
         LockType i_corpseGuard;
 };
 
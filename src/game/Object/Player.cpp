@@ -470,6 +470,8 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
 
+    m_savedAurasValid = false;
+
     clearResurrectRequestData();
 
     m_SpellModRemoveCount = 0;
@@ -1540,7 +1542,7 @@ void Player::Update(uint32 update_diff, uint32 p_time)
                 e->OnSave(this);
             }
 #endif /* ENABLE_ELUNA */
-            SaveToDB();
+            SaveToDB(sWorld.getConfig(CONFIG_BOOL_PLAYER_SAVE_BATCHED));
             DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
         }
         else
@@ -3989,6 +3991,11 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
             uint32 item_id  = fields[1].GetUInt32();
             time_t db_time  = (time_t)fields[2].GetUInt64();
 
+            // remember every row, also the skipped ones, so that the next save removes them
+            SpellCooldown& saved = m_savedSpellCooldowns[spell_id];
+            saved.end = db_time;
+            saved.itemid = item_id;
+
             if (!sSpellStore.LookupEntry(spell_id))
             {
                 sLog.outError("Player %u has unknown spell %u in `character_spell_cooldown`, skipping.", GetGUIDLow(), spell_id);
@@ -4011,35 +4018,67 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
     }
 }
 
-void Player::_SaveSpellCooldowns()
+void Player::_SaveSpellCooldowns(bool batched)
 {
     static SqlStatementID deleteSpellCooldown ;
     static SqlStatementID insertSpellCooldown ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
-
     time_t curTime = time(NULL);
     time_t infTime = curTime + infinityCooldownDelayCheck;
 
-    // remove outdated and save active
+    // remove outdated and collect active, locked cooldowns are not saved, they will be reset or set at reload
+    SpellCooldowns toSave;
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
     {
         if (itr->second.end <= curTime)
         {
             m_spellCooldowns.erase(itr++);
         }
-        else if (itr->second.end <= infTime)                // not save locked cooldowns, it will be reset or set at reload
+        else
         {
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES( ?, ?, ?, ?)");
-            stmt.PExecute(GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
+            if (itr->second.end <= infTime)
+            {
+                toSave[itr->first] = itr->second;
+            }
             ++itr;
         }
+    }
+
+    // only rows that differ from what the database already has are written
+    for (SpellCooldowns::const_iterator itr = m_savedSpellCooldowns.begin(); itr != m_savedSpellCooldowns.end(); ++itr)
+    {
+        if (toSave.find(itr->first) == toSave.end())
+        {
+            SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ? AND `spell` = ?");
+            stmt.PExecute(GetGUIDLow(), itr->first);
+        }
+    }
+
+    for (SpellCooldowns::const_iterator itr = toSave.begin(); itr != toSave.end(); ++itr)
+    {
+        SpellCooldowns::const_iterator saved = m_savedSpellCooldowns.find(itr->first);
+        if (saved != m_savedSpellCooldowns.end() && saved->second.end == itr->second.end && saved->second.itemid == itr->second.itemid)
+        {
+            continue;
+        }
+
+        SqlStatement stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES (?, ?, ?, ?) "
+                            "ON DUPLICATE KEY UPDATE `item` = VALUES(`item`), `time` = VALUES(`time`)");
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt32(itr->first);
+        stmt.addUInt32(uint32(itr->second.itemid));
+        stmt.addUInt64(uint64(itr->second.end));
+        if (batched)
+        {
+            stmt.ExecuteBatched();
+        }
         else
         {
-            ++itr;
+            stmt.Execute();
         }
     }
+
+    m_savedSpellCooldowns.swap(toSave);
 }
 
 uint32 Player::resetTalentsCost() const
@@ -18241,7 +18280,7 @@ bool Player::_LoadHomeBind(QueryResult* result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
-void Player::SaveToDB()
+void Player::SaveToDB(bool batched)
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
@@ -18257,7 +18296,14 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    // rows of earlier batched saves must reach the DB before this save's rows
+    if (!batched)
+    {
+        CharacterDatabase.FlushBatchedStmts();
+    }
+
+    // saves of one character stay in order, saves of different characters may run concurrently
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
     UpdateHonor();
 
@@ -18424,13 +18470,13 @@ void Player::SaveToDB()
 
     _SaveBGData();
     _SaveInventory();
-    _SaveQuestStatus();
+    _SaveQuestStatus(batched);
     _SaveSpells();
-    _SaveSpellCooldowns();
-    _SaveActions();
+    _SaveSpellCooldowns(batched);
+    _SaveActions(batched);
     _SaveAuras();
-    _SaveSkills();
-    m_reputationMgr.SaveToDB();
+    _SaveSkills(batched);
+    m_reputationMgr.SaveToDB(batched);
     _SaveHonorCP();
     GetSession()->SaveTutorialsData();                      // changed only while character in game
 
@@ -18465,10 +18511,9 @@ void Player::SaveGoldToDB()
     stmt.PExecute(GetMoney(), GetGUIDLow());
 }
 
-void Player::_SaveActions()
+void Player::_SaveActions(bool batched)
 {
-    static SqlStatementID insertAction ;
-    static SqlStatementID updateAction ;
+    static SqlStatementID upsertAction ;
     static SqlStatementID deleteAction ;
 
     for (ActionButtonList::iterator itr = m_actionButtons.begin(); itr != m_actionButtons.end();)
@@ -18476,25 +18521,22 @@ void Player::_SaveActions()
         switch (itr->second.uState)
         {
             case ACTIONBUTTON_NEW:
+            case ACTIONBUTTON_CHANGED:
             {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insertAction, "INSERT INTO `character_action` (`guid`,`button`,`action`,`type`) VALUES (?, ?, ?, ?)");
+                SqlStatement stmt = CharacterDatabase.CreateStatement(upsertAction, "INSERT INTO `character_action` (`guid`,`button`,`action`,`type`) VALUES (?, ?, ?, ?) "
+                                    "ON DUPLICATE KEY UPDATE `action` = VALUES(`action`), `type` = VALUES(`type`)");
                 stmt.addUInt32(GetGUIDLow());
                 stmt.addUInt32(uint32(itr->first));
                 stmt.addUInt32(itr->second.GetAction());
                 stmt.addUInt32(uint32(itr->second.GetType()));
-                stmt.Execute();
-                itr->second.uState = ACTIONBUTTON_UNCHANGED;
-                ++itr;
-            }
-            break;
-            case ACTIONBUTTON_CHANGED:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updateAction, "UPDATE `character_action` SET `action` = ?, `type` = ? WHERE `guid` = ? AND `button` = ?");
-                stmt.addUInt32(itr->second.GetAction());
-                stmt.addUInt32(uint32(itr->second.GetType()));
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(uint32(itr->first));
-                stmt.Execute();
+                if (batched)
+                {
+                    stmt.ExecuteBatched();
+                }
+                else
+                {
+                    stmt.Execute();
+                }
                 itr->second.uState = ACTIONBUTTON_UNCHANGED;
                 ++itr;
             }
@@ -18520,20 +18562,9 @@ void Player::_SaveAuras()
     static SqlStatementID deleteAuras ;
     static SqlStatementID insertAuras ;
 
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
-
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-    {
-        return;
-    }
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
-            "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
+    SavedAuraRows rows;
     for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
     {
         SpellAuraHolder* holder = itr->second;
@@ -18572,29 +18603,64 @@ void Player::_SaveAuras()
                 continue;
             }
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
-
+            SavedAuraRow row;
+            row.casterGuid = holder->GetCasterGuid().GetRawValue();
+            row.itemGuid = holder->GetCastItemGuid().GetCounter();
+            row.spellId = holder->GetId();
+            row.stackAmount = holder->GetStackAmount();
+            row.charges = holder->GetAuraCharges();
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                stmt.addInt32(damage[i]);
+                row.damage[i] = damage[i];
+                row.periodicTime[i] = periodicTime[i];
             }
+            row.maxDuration = holder->GetAuraMaxDuration();
+            row.duration = holder->GetAuraDuration();
+            row.effIndexMask = effIndexMask;
+            rows.push_back(row);
+        }
+    }
 
-            for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                stmt.addUInt32(periodicTime[i]);
-            }
+    // nothing changed since the last save (e.g. no auras or only permanent ones)
+    if (m_savedAurasValid && rows == m_savedAuras)
+    {
+        return;
+    }
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
-            stmt.Execute();
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    for (SavedAuraRows::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
+                "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+        stmt.addUInt32(GetGUIDLow());
+        stmt.addUInt64(itr->casterGuid);
+        stmt.addUInt32(itr->itemGuid);
+        stmt.addUInt32(itr->spellId);
+        stmt.addUInt32(itr->stackAmount);
+        stmt.addUInt8(itr->charges);
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            stmt.addInt32(itr->damage[i]);
+        }
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            stmt.addUInt32(itr->periodicTime[i]);
         }
+
+        stmt.addInt32(itr->maxDuration);
+        stmt.addInt32(itr->duration);
+        stmt.addUInt32(itr->effIndexMask);
+        stmt.Execute();
     }
+
+    m_savedAuras.swap(rows);
+    m_savedAurasValid = true;
 }
 
 void Player::_SaveInventory()
@@ -18719,6 +18785,8 @@ void Player::_SaveInventory()
 
 void Player::_SaveHonorCP()
 {
+    static SqlStatementID insHonorCP ;
+
     HonorCPMap tempList;
 
     for (HonorCPMap::iterator itr = m_honorCP.begin(); itr != m_honorCP.end() ; ++itr)
@@ -18730,11 +18798,21 @@ void Player::_SaveHonorCP()
                 itr->state = HK_DELETED;
                 break;
             case HK_NEW:
-                CharacterDatabase.PExecute("INSERT INTO `character_honor_cp` (`guid`,`victim_type`,`victim`,`honor`,`date`,`type`) "
-                                           " VALUES (%u,%u,%u,%f,%u,%u)", GetGUIDLow(), itr->victimType, itr->victimID, itr->honorPoints , itr->date, itr->type);
+            {
+                SqlStatement stmt = CharacterDatabase.CreateStatement(insHonorCP, "INSERT INTO `character_honor_cp` (`guid`,`victim_type`,`victim`,`honor`,`date`,`type`) "
+                                    "VALUES (?, ?, ?, ?, ?, ?)");
+                stmt.addUInt32(GetGUIDLow());
+                stmt.addUInt32(uint32(itr->victimType));
+                stmt.addUInt32(itr->victimID);
+                stmt.addFloat(itr->honorPoints);
+                stmt.addUInt32(itr->date);
+                stmt.addUInt32(uint32(itr->type));
+                stmt.Execute();
+
                 itr->state = HK_UNCHANGED;
                 tempList.push_back(*itr);
                 break;
+            }
             case HK_UNCHANGED:
                 tempList.push_back(*itr);
                 break;
@@ -18824,11 +18902,9 @@ void Player::SaveMail()
     m_mailsUpdated = false;
 }
 
-void Player::_SaveQuestStatus()
+void Player::_SaveQuestStatus(bool batched)
 {
-    static SqlStatementID insertQuestStatus ;
-
-    static SqlStatementID updateQuestStatus ;
+    static SqlStatementID upsertQuestStatus ;
 
     // we don't need transactions here.
     for (QuestStatusMap::iterator i = mQuestStatus.begin(); i != mQuestStatus.end(); ++i)
@@ -18837,9 +18913,13 @@ void Player::_SaveQuestStatus()
         switch (questStatus.uState)
         {
             case QUEST_NEW :
+            case QUEST_CHANGED :
             {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insertQuestStatus, "INSERT INTO `character_queststatus` (`guid`,`quest`,`status`,`rewarded`,`explored`,`timer`,`mobcount1`,`mobcount2`,`mobcount3`,`mobcount4`,`itemcount1`,`itemcount2`,`itemcount3`,`itemcount4`) "
-                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+                SqlStatement stmt = CharacterDatabase.CreateStatement(upsertQuestStatus, "INSERT INTO `character_queststatus` (`guid`,`quest`,`status`,`rewarded`,`explored`,`timer`,`mobcount1`,`mobcount2`,`mobcount3`,`mobcount4`,`itemcount1`,`itemcount2`,`itemcount3`,`itemcount4`) "
+                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?) "
+                                    "ON DUPLICATE KEY UPDATE `status` = VALUES(`status`), `rewarded` = VALUES(`rewarded`), `explored` = VALUES(`explored`), `timer` = VALUES(`timer`), "
+                                    "`mobcount1` = VALUES(`mobcount1`), `mobcount2` = VALUES(`mobcount2`), `mobcount3` = VALUES(`mobcount3`), `mobcount4` = VALUES(`mobcount4`), "
+                                    "`itemcount1` = VALUES(`itemcount1`), `itemcount2` = VALUES(`itemcount2`), `itemcount3` = VALUES(`itemcount3`), `itemcount4` = VALUES(`itemcount4`)");
 
                 stmt.addUInt32(GetGUIDLow());
                 stmt.addUInt32(i->first);
@@ -18855,29 +18935,14 @@ void Player::_SaveQuestStatus()
                 {
                     stmt.addUInt32(questStatus.m_itemcount[k]);
                 }
-                stmt.Execute();
-            }
-            break;
-            case QUEST_CHANGED :
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updateQuestStatus, "UPDATE `character_queststatus` SET `status` = ?,`rewarded` = ?,`explored` = ?,`timer` = ?,"
-                                    "`mobcount1` = ?,`mobcount2` = ?,`mobcount3` = ?,`mobcount4` = ?,`itemcount1` = ?,`itemcount2` = ?,`itemcount3` = ?,`itemcount4` = ?  WHERE `guid` = ? AND `quest` = ?");
-
-                stmt.addUInt8(questStatus.m_status);
-                stmt.addUInt8(questStatus.m_rewarded);
-                stmt.addUInt8(questStatus.m_explored);
-                stmt.addUInt64(uint64(questStatus.m_timer / IN_MILLISECONDS + sWorld.GetGameTime()));
-                for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
+                if (batched)
                 {
-                    stmt.addUInt32(questStatus.m_creatureOrGOcount[k]);
+                    stmt.ExecuteBatched();
                 }
-                for (int k = 0; k < QUEST_OBJECTIVES_COUNT; ++k)
+                else
                 {
-                    stmt.addUInt32(questStatus.m_itemcount[k]);
+                    stmt.Execute();
                 }
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(i->first);
-                stmt.Execute();
             }
             break;
             case QUEST_UNCHANGED:
@@ -18887,11 +18952,10 @@ void Player::_SaveQuestStatus()
     }
 }
 
-void Player::_SaveSkills()
+void Player::_SaveSkills(bool batched)
 {
     static SqlStatementID delSkills ;
-    static SqlStatementID insSkills ;
-    static SqlStatementID updSkills ;
+    static SqlStatementID upsSkills ;
 
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
@@ -18917,15 +18981,22 @@ void Player::_SaveSkills()
         switch (itr->second.uState)
         {
             case SKILL_NEW:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insSkills, "INSERT INTO `character_skills` (`guid`, `skill`, `value`, `max`) VALUES (?, ?, ?, ?)");
-                stmt.PExecute(GetGUIDLow(), itr->first, value, max);
-            }
-            break;
             case SKILL_CHANGED:
             {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(updSkills, "UPDATE `character_skills` SET `value` = ?, `max` = ? WHERE `guid` = ? AND `skill` = ?");
-                stmt.PExecute(value, max, GetGUIDLow(), itr->first);
+                SqlStatement stmt = CharacterDatabase.CreateStatement(upsSkills, "INSERT INTO `character_skills` (`guid`, `skill`, `value`, `max`) VALUES (?, ?, ?, ?) "
+                                    "ON DUPLICATE KEY UPDATE `value` = VALUES(`value`), `max` = VALUES(`max`)");
+                stmt.addUInt32(GetGUIDLow());
+                stmt.addUInt32(itr->first);
+                stmt.addUInt16(value);
+                stmt.addUInt16(max);
+                if (batched)
+                {
+                    stmt.ExecuteBatched();
+                }
+                else
+                {
+                    stmt.Execute();
+                }
             }
             break;
             case SKILL_UNCHANGED:
@@ -21776,7 +21847,7 @@ void Player::UpdateForQuestWorldObjects()
         return;
     }
 
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (ClientGuidSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         if (itr->IsGameObject())
         {
@@ -44,6 +44,7 @@
 #include "SharedDefines.h"
 #include "Chat.h"
 #include "GMTicketMgr.h"
+#include "ClientGuidSet.h"
 
 #include<vector>
 
@@ -402,6 +403,41 @@ enum HonorKillState
 
 typedef std::list<HonorCP> HonorCPMap;
 
+/**
+ * One `character_aura` row as it was last written, used to skip aura saves
+ * that would write exactly the same rows again.
+ */
+struct SavedAuraRow
+{
+    uint64 casterGuid;
+    uint32 itemGuid;
+    uint32 spellId;
+    uint32 stackAmount;
+    uint8 charges;
+    int32 damage[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32 maxDuration;
+    int32 duration;
+    uint32 effIndexMask;
+
+    bool operator==(SavedAuraRow const& other) const
+    {
+        for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            if (damage[i] != other.damage[i] || periodicTime[i] != other.periodicTime[i])
+            {
+                return false;
+            }
+        }
+
+        return casterGuid == other.casterGuid && itemGuid == other.itemGuid && spellId == other.spellId &&
+               stackAmount == other.stackAmount && charges == other.charges && maxDuration == other.maxDuration &&
+               duration == other.duration && effIndexMask == other.effIndexMask;
+    }
+};
+
+typedef std::vector<SavedAuraRow> SavedAuraRows;
+
 #define NEGATIVE_HONOR_RANK_COUNT 4
 #define POSITIVE_HONOR_RANK_COUNT 15
 #define HONOR_RANK_COUNT 19 // negative + positive ranks
@@ -1940,8 +1976,9 @@ class Player : public Unit
         /***                   SAVE SYSTEM                     ***/
         /*********************************************************/
 
-        // Save the player to the database
-        void SaveToDB();
+        // Save the player to the database, batched: upserts are merged with those of other players
+        // and written by World::Update at the end of the tick (periodic saves only)
+        void SaveToDB(bool batched = false);
 
         // Save the inventory and gold to the database
         void SaveInventoryAndGoldToDB(); // fast save function for item/money cheating preventing
@@ -2302,7 +2339,7 @@ class Player : public Unit
         void _LoadSpellCooldowns(QueryResult* result);
 
         // Save spell cooldowns to the database
-        void _SaveSpellCooldowns();
+        void _SaveSpellCooldowns(bool batched = false);
 
         // Set resurrect request data
         void setResurrectRequestData(ObjectGuid guid, uint32 mapId, float X, float Y, float Z, uint32 health, uint32 mana)
@@ -3372,10 +3409,10 @@ class Player : public Unit
         Object* GetObjectByTypeMask(ObjectGuid guid, TypeMask typemask);
 
         // Currently visible objects at the player's client
-        GuidSet m_clientGUIDs;
+        ClientGuidSet m_clientGUIDs;
 
         // Check if an object is visible to the client
-        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.find(u->GetObjectGuid()) != m_clientGUIDs.end(); }
+        bool HaveAtClient(WorldObject const* u) { return u == this || m_clientGUIDs.count(u->GetObjectGuid()); }
 
         // Check if the player is visible in the grid for another player
         bool IsVisibleInGridForPlayer(Player* pl) const override;
@@ -3624,7 +3661,7 @@ class Player : public Unit
         /*********************************************************/
 
         // Save player actions to the database
-        void _SaveActions();
+        void _SaveActions(bool batched);
 
         // Save player auras to the database
         void _SaveAuras();
@@ -3633,8 +3670,8 @@ class Player : public Unit
         void _SaveInventory();
         void _SaveHonorCP();
 
-        void _SaveQuestStatus();
-        void _SaveSkills();
+        void _SaveQuestStatus(bool batched);
+        void _SaveSkills(bool batched);
 
         // Save player spells to the database
         void _SaveSpells();
@@ -3718,6 +3755,10 @@ class Player : public Unit
         PlayerMails m_mail; // Player mails
         PlayerSpellMap m_spells; // Player spells
         SpellCooldowns m_spellCooldowns; // Spell cooldowns
+        SpellCooldowns m_savedSpellCooldowns; // Spell cooldown rows currently in the database
+
+        SavedAuraRows m_savedAuras; // Aura rows written by the last aura save
+        bool m_savedAurasValid; // m_savedAuras matches the database
 
         GlobalCooldownMgr m_GlobalCooldownMgr; // Global cooldown manager
 
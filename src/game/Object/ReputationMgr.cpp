@@ -537,21 +537,29 @@ void ReputationMgr::LoadFromDB(QueryResult* result)
     }
 }
 
-void ReputationMgr::SaveToDB()
+void ReputationMgr::SaveToDB(bool batched)
 {
-    static SqlStatementID delRep ;
-    static SqlStatementID insRep ;
-
-    SqlStatement stmtDel = CharacterDatabase.CreateStatement(delRep, "DELETE FROM `character_reputation` WHERE `guid` = ? AND `faction`=?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insRep, "INSERT INTO `character_reputation` (`guid`,`faction`,`standing`,`flags`) VALUES (?, ?, ?, ?)");
+    static SqlStatementID upsRep ;
 
     for (FactionStateList::iterator itr = m_factions.begin(); itr != m_factions.end(); ++itr)
     {
         FactionState &faction = itr->second;
         if (faction.needSave)
         {
-            stmtDel.PExecute(m_player->GetGUIDLow(), faction.ID);
-            stmtIns.PExecute(m_player->GetGUIDLow(), faction.ID, faction.Standing, faction.Flags);
+            SqlStatement stmt = CharacterDatabase.CreateStatement(upsRep, "INSERT INTO `character_reputation` (`guid`,`faction`,`standing`,`flags`) VALUES (?, ?, ?, ?) "
+                                "ON DUPLICATE KEY UPDATE `standing` = VALUES(`standing`), `flags` = VALUES(`flags`)");
+            stmt.addUInt32(m_player->GetGUIDLow());
+            stmt.addUInt32(faction.ID);
+            stmt.addInt32(faction.Standing);
+            stmt.addUInt32(faction.Flags);
+            if (batched)
+            {
+                stmt.ExecuteBatched();
+            }
+            else
+            {
+                stmt.Execute();
+            }
             faction.needSave = false;
         }
     }
@@ -66,7 +66,7 @@ class ReputationMgr
         explicit ReputationMgr(Player* owner) : m_player(owner) {}
         ~ReputationMgr() {}
 
-        void SaveToDB();
+        void SaveToDB(bool batched = false);
         void LoadFromDB(QueryResult* result);
     public:                                                 // statics
         static const int32 PointsInRank[MAX_REPUTATION_RANK];
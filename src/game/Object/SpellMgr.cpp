@@ -1583,10 +1583,10 @@ void SpellMgr::LoadSpellProcEvents()
 
 struct DoSpellProcItemEnchant
 {
-    DoSpellProcItemEnchant(SpellProcItemEnchantMap& _procMap, float _ppm) : procMap(_procMap), ppm(_ppm) {}
+    DoSpellProcItemEnchant(SpellProcItemEnchantMap::Builder& _procMap, float _ppm) : procMap(_procMap), ppm(_ppm) {}
     void operator()(uint32 spell_id) { procMap[spell_id] = ppm; }
 
-    SpellProcItemEnchantMap& procMap;
+    SpellProcItemEnchantMap::Builder& procMap;
     float ppm;
 };
 
@@ -1607,6 +1607,8 @@ void SpellMgr::LoadSpellProcItemEnchant()
         return;
     }
 
+    SpellProcItemEnchantMap::Builder procItemEnchantMap;
+
     BarGoLink bar(result->GetRowCount());
 
     do
@@ -1635,10 +1637,10 @@ void SpellMgr::LoadSpellProcItemEnchant()
             continue;
         }
 
-        mSpellProcItemEnchantMap[entry] = ppmRate;
+        procItemEnchantMap[entry] = ppmRate;
 
         // also add to high ranks
-        DoSpellProcItemEnchant worker(mSpellProcItemEnchantMap, ppmRate);
+        DoSpellProcItemEnchant worker(procItemEnchantMap, ppmRate);
         doForHighRanks(entry, worker);
 
         ++count;
@@ -1647,6 +1649,8 @@ void SpellMgr::LoadSpellProcItemEnchant()
 
     delete result;
 
+    mSpellProcItemEnchantMap.Assign(procItemEnchantMap);
+
     sLog.outString(">> Loaded %u proc item enchant definitions", count);
     sLog.outString();
 }
@@ -2047,6 +2051,8 @@ void SpellMgr::LoadSpellElixirs()
         return;
     }
 
+    SpellElixirMap::Builder elixirMap;
+
     BarGoLink bar(result->GetRowCount());
 
     do
@@ -2066,7 +2072,7 @@ void SpellMgr::LoadSpellElixirs()
             continue;
         }
 
-        mSpellElixirs[entry] = mask;
+        elixirMap[entry] = mask;
 
         ++count;
     }
@@ -2074,18 +2080,20 @@ void SpellMgr::LoadSpellElixirs()
 
     delete result;
 
+    mSpellElixirs.Assign(elixirMap);
+
     sLog.outString(">> Loaded %u spell elixir definitions", count);
     sLog.outString();
 }
 
 struct DoSpellThreat
 {
-    DoSpellThreat(SpellThreatMap& _threatMap) : threatMap(_threatMap), count(0) {}
+    DoSpellThreat(SpellThreatMap::Builder& _threatMap) : threatMap(_threatMap), count(0) {}
     void operator()(uint32 spell_id)
     {
         SpellThreatEntry const& ste = state->second;
         // add ranks only for not filled data (spells adding flat threat are usually different for ranks)
-        SpellThreatMap::const_iterator spellItr = threatMap.find(spell_id);
+        SpellThreatMap::Builder::const_iterator spellItr = threatMap.find(spell_id);
         if (spellItr == threatMap.end())
         {
             threatMap[spell_id] = ste;
@@ -2132,8 +2140,8 @@ struct DoSpellThreat
     bool HasEntry(uint32 spellId) { return threatMap.count(spellId) > 0; }
     bool SetStateToEntry(uint32 spellId) { return (state = threatMap.find(spellId)) != threatMap.end(); }
 
-    SpellThreatMap& threatMap;
-    SpellThreatMap::const_iterator state;
+    SpellThreatMap::Builder& threatMap;
+    SpellThreatMap::Builder::const_iterator state;
     uint32 count;
 };
 
@@ -2152,7 +2160,8 @@ void SpellMgr::LoadSpellThreats()
         return;
     }
 
-    SpellRankHelper<SpellThreatEntry, DoSpellThreat, SpellThreatMap> rankHelper(*this, mSpellThreatMap);
+    SpellThreatMap::Builder threatMap;
+    SpellRankHelper<SpellThreatEntry, DoSpellThreat, SpellThreatMap::Builder> rankHelper(*this, threatMap);
 
     BarGoLink bar(result->GetRowCount());
 
@@ -2177,6 +2186,8 @@ void SpellMgr::LoadSpellThreats()
 
     delete result;
 
+    mSpellThreatMap.Assign(threatMap);
+
     sLog.outString(">> Loaded %u spell threat entries", rankHelper.worker.count);
     sLog.outString();
 }
@@ -3748,6 +3759,7 @@ void SpellMgr::LoadSpellChains()
     }
 
     // fill next rank cache
+    SpellChainMapNext::Builder chainsNext;
     for (SpellChainMap::const_iterator i = mSpellChains.begin(); i != mSpellChains.end(); ++i)
     {
         uint32 spell_id = i->first;
@@ -3755,15 +3767,17 @@ void SpellMgr::LoadSpellChains()
 
         if (node.prev)
         {
-            mSpellChainsNext.insert(SpellChainMapNext::value_type(node.prev, spell_id));
+            chainsNext.insert(SpellChainMapNext::Builder::value_type(node.prev, spell_id));
         }
 
         if (node.req)
         {
-            mSpellChainsNext.insert(SpellChainMapNext::value_type(node.req, spell_id));
+            chainsNext.insert(SpellChainMapNext::Builder::value_type(node.req, spell_id));
         }
     }
 
+    mSpellChainsNext.Assign(chainsNext);
+
     // check single rank redundant cases (single rank talents not added by default so this can be only custom cases)
     for (SpellChainMap::const_iterator i = mSpellChains.begin(); i != mSpellChains.end(); ++i)
     {
@@ -3789,6 +3803,7 @@ void SpellMgr::LoadSpellLearnSkills()
     mSpellLearnSkills.clear();                              // need for reload case
 
     // search auto-learned skills and add its to map also for use in unlearn spells/talents
+    SpellLearnSkillMap::Builder learnSkills;
     uint32 dbc_count = 0;
     BarGoLink bar(sSpellStore.GetNumRows());
     for (uint32 spell = 0; spell < sSpellStore.GetNumRows(); ++spell)
@@ -3818,13 +3833,15 @@ void SpellMgr::LoadSpellLearnSkills()
                 }
                 dbc_node.maxvalue = dbc_node.step * 75;
 
-                mSpellLearnSkills[spell] = dbc_node;
+                learnSkills[spell] = dbc_node;
                 ++dbc_count;
                 break;
             }
         }
     }
 
+    mSpellLearnSkills.Assign(learnSkills);
+
     sLog.outString(">> Loaded %u Spell Learn Skills from DBC", dbc_count);
     sLog.outString();
 }
@@ -3846,6 +3863,7 @@ void SpellMgr::LoadSpellLearnSpells()
         return;
     }
 
+    SpellLearnSpellMap::Builder learnSpells;
     uint32 count = 0;
 
     BarGoLink bar(result->GetRowCount());
@@ -3879,7 +3897,7 @@ void SpellMgr::LoadSpellLearnSpells()
             continue;
         }
 
-        mSpellLearnSpells.insert(SpellLearnSpellMap::value_type(spell_id, node));
+        learnSpells.insert(SpellLearnSpellMap::Builder::value_type(spell_id, node));
 
         ++count;
     }
@@ -3917,10 +3935,10 @@ void SpellMgr::LoadSpellLearnSpells()
                 // other required explicit dependent learning
                 dbc_node.autoLearned = entry->EffectImplicitTargetA[i] == TARGET_PET || GetTalentSpellCost(spell) > 0 || IsPassiveSpell(entry) || entry->HasSpellEffect(SPELL_EFFECT_SKILL_STEP);
 
-                SpellLearnSpellMapBounds db_node_bounds = GetSpellLearnSpellMapBounds(spell);
+                std::pair<SpellLearnSpellMap::Builder::const_iterator, SpellLearnSpellMap::Builder::const_iterator> db_node_bounds = learnSpells.equal_range(spell);
 
                 bool found = false;
-                for (SpellLearnSpellMap::const_iterator itr = db_node_bounds.first; itr != db_node_bounds.second; ++itr)
+                for (SpellLearnSpellMap::Builder::const_iterator itr = db_node_bounds.first; itr != db_node_bounds.second; ++itr)
                 {
                     if (itr->second.spell == dbc_node.spell)
                     {
@@ -3933,13 +3951,15 @@ void SpellMgr::LoadSpellLearnSpells()
 
                 if (!found)                                 // add new spell-spell pair if not found
                 {
-                    mSpellLearnSpells.insert(SpellLearnSpellMap::value_type(spell, dbc_node));
+                    learnSpells.insert(SpellLearnSpellMap::Builder::value_type(spell, dbc_node));
                     ++dbc_count;
                 }
             }
         }
     }
 
+    mSpellLearnSpells.Assign(learnSpells);
+
     sLog.outString(">> Loaded %u spell learn spells + %u found in DBC", count, dbc_count);
     sLog.outString();
 }
@@ -4242,6 +4262,7 @@ bool SpellMgr::IsSpellValid(SpellEntry const* spellInfo, Player* pl, bool msg)
 void SpellMgr::LoadSpellAreas()
 {
     mSpellAreaMap.clear();                                  // need for reload case
+    mSpellAreaForAreaMap.clear();
     mSpellAreaForAuraMap.clear();
 
     uint32 count = 0;
@@ -4258,6 +4279,9 @@ void SpellMgr::LoadSpellAreas()
         return;
     }
 
+    SpellAreaForAreaMap::Builder spellAreaForArea;
+    SpellAreaForAuraMap::Builder spellAreaForAura;
+
     BarGoLink bar(result->GetRowCount());
 
     do
@@ -4403,8 +4427,8 @@ void SpellMgr::LoadSpellAreas()
             if (spellArea.autocast && spellArea.auraSpell > 0)
             {
                 bool chain = false;
-                SpellAreaForAuraMapBounds saBound = GetSpellAreaForAuraMapBounds(spellArea.spellId);
-                for (SpellAreaForAuraMap::const_iterator itr = saBound.first; itr != saBound.second; ++itr)
+                std::pair<SpellAreaForAuraMap::Builder::const_iterator, SpellAreaForAuraMap::Builder::const_iterator> saBound = spellAreaForAura.equal_range(spellArea.spellId);
+                for (SpellAreaForAuraMap::Builder::const_iterator itr = saBound.first; itr != saBound.second; ++itr)
                 {
                     if (itr->second->autocast && itr->second->auraSpell > 0)
                     {
@@ -4442,13 +4466,13 @@ void SpellMgr::LoadSpellAreas()
         // for search by current zone/subzone at zone/subzone change
         if (spellArea.areaId)
         {
-            mSpellAreaForAreaMap.insert(SpellAreaForAreaMap::value_type(spellArea.areaId, sa));
+            spellAreaForArea.insert(SpellAreaForAreaMap::Builder::value_type(spellArea.areaId, sa));
         }
 
         // for search at aura apply
         if (spellArea.auraSpell)
         {
-            mSpellAreaForAuraMap.insert(SpellAreaForAuraMap::value_type(abs(spellArea.auraSpell), sa));
+            spellAreaForAura.insert(SpellAreaForAuraMap::Builder::value_type(abs(spellArea.auraSpell), sa));
         }
 
         ++count;
@@ -4457,6 +4481,9 @@ void SpellMgr::LoadSpellAreas()
 
     delete result;
 
+    mSpellAreaForAreaMap.Assign(spellAreaForArea);
+    mSpellAreaForAuraMap.Assign(spellAreaForAura);
+
     sLog.outString(">> Loaded %u spell area requirements", count);
     sLog.outString();
 }
@@ -4527,6 +4554,7 @@ void SpellMgr::LoadSkillLineAbilityMap()
 {
     mSkillLineAbilityMap.clear();
 
+    SkillLineAbilityMap::Builder skillLineAbilities;
     BarGoLink bar(sSkillLineAbilityStore.GetNumRows());
     uint32 count = 0;
 
@@ -4539,10 +4567,12 @@ void SpellMgr::LoadSkillLineAbilityMap()
             continue;
         }
 
-        mSkillLineAbilityMap.insert(SkillLineAbilityMap::value_type(SkillInfo->spellId, SkillInfo));
+        skillLineAbilities.insert(SkillLineAbilityMap::Builder::value_type(SkillInfo->spellId, SkillInfo));
         ++count;
     }
 
+    mSkillLineAbilityMap.Assign(skillLineAbilities);
+
     sLog.outString(">> Loaded %u SkillLineAbility MultiMap Data", count);
     sLog.outString();
 }
@@ -4551,6 +4581,7 @@ void SpellMgr::LoadSkillRaceClassInfoMap()
 {
     mSkillRaceClassInfoMap.clear();
 
+    SkillRaceClassInfoMap::Builder skillRaceClassInfos;
     BarGoLink bar(sSkillRaceClassInfoStore.GetNumRows());
     uint32 count = 0;
 
@@ -4569,11 +4600,13 @@ void SpellMgr::LoadSkillRaceClassInfoMap()
             continue;
         }
 
-        mSkillRaceClassInfoMap.insert(SkillRaceClassInfoMap::value_type(skillRCInfo->skillId, skillRCInfo));
+        skillRaceClassInfos.insert(SkillRaceClassInfoMap::Builder::value_type(skillRCInfo->skillId, skillRCInfo));
 
         ++count;
     }
 
+    mSkillRaceClassInfoMap.Assign(skillRaceClassInfos);
+
     sLog.outString(">> Loaded %u SkillRaceClassInfo MultiMap Data", count);
     sLog.outString();
 }
@@ -5136,6 +5169,8 @@ void SpellMgr::LoadSpellAffects()
         return;
     }
 
+    SpellAffectMap::Builder affectMap;
+
     BarGoLink bar(result->GetRowCount());
 
     do
@@ -5183,7 +5218,7 @@ void SpellMgr::LoadSpellAffects()
             }
         }
 
-        mSpellAffectMap.insert(SpellAffectMap::value_type((entry << 8) + effectId, spellAffectMask));
+        affectMap.insert(SpellAffectMap::Builder::value_type((entry << 8) + effectId, spellAffectMask));
 
         ++count;
     }
@@ -5191,6 +5226,8 @@ void SpellMgr::LoadSpellAffects()
 
     delete result;
 
+    mSpellAffectMap.Assign(affectMap);
+
     sLog.outString();
     sLog.outString(">> Loaded %u spell affect definitions", count);
 
@@ -5243,6 +5280,8 @@ void SpellMgr::LoadFacingCasterFlags()
         return;
     }
 
+    SpellFacingFlagMap::Builder facingFlagMap;
+
     BarGoLink bar(result->GetRowCount());
 
     do
@@ -5260,7 +5299,7 @@ void SpellMgr::LoadFacingCasterFlags()
             sLog.outErrorDb("Spell %u listed in `spell_facing` does not exist", entry);
             continue;
         }
-        mSpellFacingFlagMap[entry]    = FacingCasterFlags;
+        facingFlagMap[entry]    = FacingCasterFlags;
 
         ++count;
     }
@@ -5268,6 +5307,8 @@ void SpellMgr::LoadFacingCasterFlags()
 
     delete result;
 
+    mSpellFacingFlagMap.Assign(facingFlagMap);
+
     sLog.outString();
     sLog.outString(">> Loaded %u facing caster flags", count);
 }
@@ -35,6 +35,7 @@
 #include "DBCStores.h"
 
 #include "Utilities/UnorderedMapSet.h"
+#include "Utilities/FlatMap.h"
 
 #include <map>
 
@@ -714,7 +715,7 @@ bool IsDiminishingReturnsGroupDurationLimited(DiminishingGroup group);
 DiminishingReturnsType GetDiminishingReturnsGroupType(DiminishingGroup group);
 
 // Spell affects related declarations (accessed using SpellMgr functions)
-typedef std::map<uint32, uint64> SpellAffectMap;
+typedef FlatMap<uint32, uint64> SpellAffectMap;
 
 /**
  * Spell proc event related declarations (accessed using SpellMgr functions) (Taken from comments)
@@ -855,9 +856,9 @@ struct SpellThreatEntry
     float ap_bonus;
 };
 
-typedef std::map<uint32, uint8> SpellElixirMap;
-typedef std::map<uint32, float> SpellProcItemEnchantMap;
-typedef std::map<uint32, SpellThreatEntry> SpellThreatMap;
+typedef FlatMap<uint32, uint8> SpellElixirMap;
+typedef FlatMap<uint32, float> SpellProcItemEnchantMap;
+typedef FlatMap<uint32, SpellThreatEntry> SpellThreatMap;
 
 // Spell script target related declarations (accessed using SpellMgr functions)
 enum SpellTargetType
@@ -996,8 +997,8 @@ struct SpellArea
 };
 
 typedef std::multimap < uint32 /*applySpellId*/, SpellArea > SpellAreaMap;
-typedef std::multimap < uint32 /*auraSpellId*/, SpellArea const* > SpellAreaForAuraMap;
-typedef std::multimap < uint32 /*areaOrZoneId*/, SpellArea const* > SpellAreaForAreaMap;
+typedef FlatMultiMap < uint32 /*auraSpellId*/, SpellArea const* > SpellAreaForAuraMap;
+typedef FlatMultiMap < uint32 /*areaOrZoneId*/, SpellArea const* > SpellAreaForAreaMap;
 typedef std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> SpellAreaMapBounds;
 typedef std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator>  SpellAreaForAuraMapBounds;
 typedef std::pair<SpellAreaForAreaMap::const_iterator, SpellAreaForAreaMap::const_iterator>  SpellAreaForAreaMapBounds;
@@ -1013,7 +1014,7 @@ struct SpellChainNode
 };
 
 typedef UNORDERED_MAP<uint32, SpellChainNode> SpellChainMap;
-typedef std::multimap<uint32, uint32> SpellChainMapNext;
+typedef FlatMultiMap<uint32, uint32> SpellChainMapNext;
 
 // Spell learning properties (accessed using SpellMgr functions)
 struct SpellLearnSkillNode
@@ -1024,7 +1025,7 @@ struct SpellLearnSkillNode
     uint16 maxvalue;                                        // 0  - max skill value for player level
 };
 
-typedef std::map<uint32, SpellLearnSkillNode> SpellLearnSkillMap;
+typedef FlatMap<uint32, SpellLearnSkillNode> SpellLearnSkillMap;
 
 struct SpellLearnSpellNode
 {
@@ -1033,13 +1034,13 @@ struct SpellLearnSpellNode
     bool autoLearned;
 };
 
-typedef std::multimap<uint32, SpellLearnSpellNode> SpellLearnSpellMap;
+typedef FlatMultiMap<uint32, SpellLearnSpellNode> SpellLearnSpellMap;
 typedef std::pair<SpellLearnSpellMap::const_iterator, SpellLearnSpellMap::const_iterator> SpellLearnSpellMapBounds;
 
-typedef std::multimap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
+typedef FlatMultiMap<uint32, SkillLineAbilityEntry const*> SkillLineAbilityMap;
 typedef std::pair<SkillLineAbilityMap::const_iterator, SkillLineAbilityMap::const_iterator> SkillLineAbilityMapBounds;
 
-typedef std::multimap<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoMap;
+typedef FlatMultiMap<uint32, SkillRaceClassInfoEntry const*> SkillRaceClassInfoMap;
 typedef std::pair<SkillRaceClassInfoMap::const_iterator, SkillRaceClassInfoMap::const_iterator> SkillRaceClassInfoMapBounds;
 
 bool IsPrimaryProfessionSkill(uint32 skill);
@@ -1054,7 +1055,7 @@ inline bool IsProfessionOrRidingSkill(uint32 skill)
     return  IsProfessionSkill(skill) || skill == SKILL_RIDING;
 }
 
-typedef std::map<uint32, uint32> SpellFacingFlagMap;
+typedef FlatMap<uint32, uint32> SpellFacingFlagMap;
 
 class SpellMgr
 {
@@ -71,6 +71,9 @@ float baseMoveSpeed[MAX_MOVE_TYPE] =
     3.141594f,                                              // MOVE_TURN_RATE
 };
 
+/// Slots of the aura aggregate cache of a unit, few aura types are queried often enough to matter.
+static const uint32 AURA_AGGREGATE_SLOTS = 16;
+
 ////////////////////////////////////////////////////////////
 // Methods of class MovementInfo
 
@@ -182,7 +185,8 @@ Unit::Unit() :
     m_charmInfo(NULL),
     i_motionMaster(this),
     m_ThreatManager(this),
-    m_HostileRefManager(this)
+    m_HostileRefManager(this),
+    m_auraAggregates(NULL)
 {
     m_objectType |= TYPEMASK_UNIT;
     m_objectTypeId = TYPEID_UNIT;
@@ -215,6 +219,9 @@ Unit::Unit() :
 
     m_Visibility = VISIBILITY_ON;
     m_AINotifyScheduled = false;
+    m_AINotifyQueued = false;
+    m_AINotifyDelay = 0;
+    m_relocationNotifyIndex = 0;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -291,6 +298,7 @@ Unit::~Unit()
 
     delete m_charmInfo;
     delete movespline;
+    delete[] m_auraAggregates;
 
     // those should be already removed at "RemoveFromWorld()" call
     MANGOS_ASSERT(m_gameObj.size() == 0);
@@ -319,6 +327,20 @@ void Unit::Update(uint32 update_diff, uint32 p_time)
     m_Events.Update(update_diff);
     _UpdateSpells(update_diff);
 
+    // moved units are notified together by the map once their delay ran out
+    if (m_AINotifyScheduled && !m_AINotifyQueued)
+    {
+        if (update_diff >= m_AINotifyDelay)
+        {
+            m_AINotifyQueued = true;
+            GetMap()->GetRelocationNotifyBatch().Add(this);
+        }
+        else
+        {
+            m_AINotifyDelay -= update_diff;
+        }
+    }
+
     CleanupDeletedAuras();
 
     if (m_lastManaUseTimer)
@@ -2283,6 +2305,8 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         }
     }
 
+    InvalidateAuraAggregates(SPELL_AURA_SCHOOL_ABSORB);
+
     // Remove all expired absorb auras
     if (existExpired)
     {
@@ -2340,6 +2364,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* pCaster, SpellSchoolMask schoolM
         }
 
         (*i)->GetModifier()->m_amount -= currentAbsorb;
+        InvalidateAuraAggregates(SPELL_AURA_MANA_SHIELD);
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -3846,58 +3871,103 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+Unit::AuraAggregate Unit::GetAuraAggregate(AuraType auratype, AuraAggregateFilter filter, int32 key) const
 {
-    int32 modifier = 0;
+    uint32 slot = (uint32(auratype) * 7 + uint32(filter) * 3 + uint32(key)) % AURA_AGGREGATE_SLOTS;
+    if (m_auraAggregates)
+    {
+        AuraAggregate const& cached = m_auraAggregates[slot];
+        if (cached.type == uint32(auratype) && cached.filter == uint32(filter) && cached.key == key)
+        {
+            return cached;
+        }
+    }
+
+    AuraAggregate aggregate;
+    aggregate.type = auratype;
+    aggregate.filter = filter;
+    aggregate.key = key;
+    aggregate.total = 0;
+    aggregate.multiplier = 1.0f;
+    aggregate.maxPositive = 0;
+    aggregate.maxNegative = 0;
 
     AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+
+    // nothing to keep for a type without auras
+    if (mTotalAuraList.empty())
     {
-        modifier += (*i)->GetModifier()->m_amount;
+        return aggregate;
     }
 
-    return modifier;
-}
+    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    {
+        Modifier const* mod = (*i)->GetModifier();
+        if ((filter == AURA_AGGREGATE_BY_MISC_MASK && !(mod->m_miscvalue & key)) ||
+            (filter == AURA_AGGREGATE_BY_MISC_VALUE && mod->m_miscvalue != key))
+        {
+            continue;
+        }
 
-float Unit::GetTotalAuraMultiplier(AuraType auratype) const
-{
-    float multiplier = 1.0f;
+        aggregate.total += mod->m_amount;
+        aggregate.multiplier *= (100.0f + mod->m_amount) / 100.0f;
+        if (mod->m_amount > aggregate.maxPositive)
+        {
+            aggregate.maxPositive = mod->m_amount;
+        }
+        if (mod->m_amount < aggregate.maxNegative)
+        {
+            aggregate.maxNegative = mod->m_amount;
+        }
+    }
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    if (!m_auraAggregates)
     {
-        multiplier *= (100.0f + (*i)->GetModifier()->m_amount) / 100.0f;
+        m_auraAggregates = new AuraAggregate[AURA_AGGREGATE_SLOTS];
+        for (uint32 i = 0; i < AURA_AGGREGATE_SLOTS; ++i)
+        {
+            m_auraAggregates[i].type = TOTAL_AURAS;
+        }
     }
 
-    return multiplier;
+    m_auraAggregates[slot] = aggregate;
+    return aggregate;
 }
 
-int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
+void Unit::InvalidateAuraAggregates(AuraType auratype)
 {
-    int32 modifier = 0;
+    if (!m_auraAggregates)
+    {
+        return;
+    }
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount > modifier)
+    for (uint32 i = 0; i < AURA_AGGREGATE_SLOTS; ++i)
+    {
+        if (m_auraAggregates[i].type == uint32(auratype))
         {
-            modifier = (*i)->GetModifier()->m_amount;
+            m_auraAggregates[i].type = TOTAL_AURAS;
         }
+    }
+}
 
-    return modifier;
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+{
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_ALL, 0).total;
 }
 
-int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_ALL, 0).multiplier;
+}
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetModifier()->m_amount < modifier)
-        {
-            modifier = (*i)->GetModifier()->m_amount;
-        }
+int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
+{
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_ALL, 0).maxPositive;
+}
 
-    return modifier;
+int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
+{
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_ALL, 0).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -3907,18 +3977,7 @@ int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask)
         return 0;
     }
 
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask)
-        {
-            modifier += mod->m_amount;
-        }
-    }
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_MASK, int32(misc_mask)).total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -3928,18 +3987,7 @@ float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask
         return 1.0f;
     }
 
-    float multiplier = 1.0f;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask)
-        {
-            multiplier *= (100.0f + mod->m_amount) / 100.0f;
-        }
-    }
-    return multiplier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_MASK, int32(misc_mask)).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -3949,19 +3997,7 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
         return 0;
     }
 
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask && mod->m_amount > modifier)
-        {
-            modifier = mod->m_amount;
-        }
-    }
-
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_MASK, int32(misc_mask)).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
@@ -3971,85 +4007,27 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
         return 0;
     }
 
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue & misc_mask && mod->m_amount < modifier)
-        {
-            modifier = mod->m_amount;
-        }
-    }
-
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_MASK, int32(misc_mask)).maxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value)
-        {
-            modifier += mod->m_amount;
-        }
-    }
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_VALUE, misc_value).total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value)
-        {
-            multiplier *= (100.0f + mod->m_amount) / 100.0f;
-        }
-    }
-    return multiplier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_VALUE, misc_value).multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value && mod->m_amount > modifier)
-        {
-            modifier = mod->m_amount;
-        }
-    }
-
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_VALUE, misc_value).maxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
-    for (AuraList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        Modifier* mod = (*i)->GetModifier();
-        if (mod->m_miscvalue == misc_value && mod->m_amount < modifier)
-        {
-            modifier = mod->m_amount;
-        }
-    }
-
-    return modifier;
+    return GetAuraAggregate(auratype, AURA_AGGREGATE_BY_MISC_VALUE, misc_value).maxNegative;
 }
 
 bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
@@ -4248,6 +4226,7 @@ void Unit::AddAuraToModList(Aura* aura)
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraAggregates(aura->GetModifier()->m_auraname);
     }
 }
 
@@ -4858,6 +4837,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        InvalidateAuraAggregates(Aur->GetModifier()->m_auraname);
     }
 
     // Set remove mode
@@ -9412,6 +9392,9 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    // a queued notification stays with the old map, the unit is scheduled again when added to a map
+    _SetAINotifyScheduled(false);
+
 #ifdef ENABLE_ELUNA
     // if multistate, delete elunaEvents and set to nullptr. events shouldn't move across states.
     // in single state, the timed events should move across maps
@@ -10393,6 +10376,7 @@ void Unit::UpdateModelData()
     {
         // we expect values in database to be relative to scale = 1.0
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
+        UpdatePositionIndex();
 
         // never actually update combat_reach for player, it's always the same. Below player case is for initialization
         if (GetTypeId() == TYPEID_PLAYER)
@@ -11034,45 +11018,12 @@ SpellAuraHolder* Unit::GetSpellAuraHolder(uint32 spellid, ObjectGuid casterGuid)
     return NULL;
 }
 
-class RelocationNotifyEvent : public BasicEvent
-{
-    public:
-        RelocationNotifyEvent(Unit& owner) : BasicEvent(), m_owner(owner)
-        {
-            m_owner._SetAINotifyScheduled(true);
-        }
-
-        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
-        {
-            float radius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
-            if (m_owner.GetTypeId() == TYPEID_PLAYER)
-            {
-                MaNGOS::PlayerRelocationNotifier notify((Player&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            else // if(m_owner.GetTypeId() == TYPEID_UNIT)
-            {
-                MaNGOS::CreatureRelocationNotifier notify((Creature&)m_owner);
-                Cell::VisitAllObjects(&m_owner, notify, radius);
-            }
-            m_owner._SetAINotifyScheduled(false);
-            return true;
-        }
-
-        void Abort(uint64)
-        {
-            m_owner._SetAINotifyScheduled(false);
-        }
-
-    private:
-        Unit& m_owner;
-};
-
 void Unit::ScheduleAINotify(uint32 delay)
 {
     if (!IsAINotifyScheduled())
     {
-        m_Events.AddEvent(new RelocationNotifyEvent(*this), m_Events.CalculateTime(delay));
+        m_AINotifyScheduled = true;
+        m_AINotifyDelay = delay;
     }
 }
 
@@ -11089,7 +11040,7 @@ void Unit::OnRelocated()
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
+        GetViewPoint().Call_UpdateVisibilityForOwnerMoved();
         UpdateObjectVisibility();
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
@@ -3580,6 +3580,14 @@ class Unit : public WorldObject
         int32 GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const;
         int32 GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const;
 
+        /**
+         * Drops the cached aggregates of an aura type, to be called whenever the
+         * list of the type or the amount of one of its listed auras changes.
+         * @param auratype the aura type whose aggregates are outdated
+         * \see Unit::GetAuraAggregate
+         */
+        void InvalidateAuraAggregates(AuraType auratype);
+
         Aura* GetDummyAura(uint32 spell_id) const;
 
         uint32 m_AuraFlags;
@@ -3751,7 +3759,10 @@ class Unit : public WorldObject
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
-        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
+        bool IsAINotifyQueued() const { return m_AINotifyQueued; }
+        void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on; m_AINotifyQueued = false; } // only for call from RelocationNotifyBatch code
+        uint32 GetRelocationNotifyIndex() const { return m_relocationNotifyIndex; }
+        void _SetRelocationNotifyIndex(uint32 index) { m_relocationNotifyIndex = index; } // only for call from RelocationNotifyBatch code
         void OnRelocated();
 
         bool IsLinkingEventTrigger() { return m_isCreatureLinkingTrigger; }
@@ -3854,6 +3865,9 @@ protected:
         UnitVisibility m_Visibility;
         Position m_last_notified_position;
         bool m_AINotifyScheduled;
+        bool m_AINotifyQueued;                              // delay ran out, waiting in the RelocationNotifyBatch of the map
+        uint32 m_AINotifyDelay;
+        uint32 m_relocationNotifyIndex;                     // position + 1 in the RelocationNotifyBatch pass running, 0 otherwise
         TimeTracker m_movesplineTimer;
 
         Diminishing m_Diminishing;
@@ -3872,6 +3886,46 @@ protected:
 
         ObjectGuid m_fixateTargetGuid;                      //< Stores the Guid of a fixated target
 
+        /**
+         * Selects the auras of a type an aggregate is computed over.
+         */
+        enum AuraAggregateFilter
+        {
+            AURA_AGGREGATE_ALL            = 0,              ///< all auras of the type
+            AURA_AGGREGATE_BY_MISC_MASK   = 1,              ///< auras whose misc value shares a bit with the key
+            AURA_AGGREGATE_BY_MISC_VALUE  = 2               ///< auras whose misc value equals the key
+        };
+
+        /**
+         * Sum, product and extremes of the amounts of the auras of one type.
+         */
+        struct AuraAggregate
+        {
+            uint32 type;                                    ///< TOTAL_AURAS for an unused slot
+            uint32 filter;                                  ///< \ref AuraAggregateFilter
+            int32 key;                                      ///< misc mask or misc value of the filter
+            int32 total;
+            float multiplier;
+            int32 maxPositive;
+            int32 maxNegative;
+        };
+
+        /**
+         * Computes the aggregates of the auras of a type, or takes them from the cache.
+         *
+         * The cache is a small direct mapped table allocated at the first use, so
+         * the getters called on every attack and stat update only walk the
+         * \ref Unit::m_modAuras list again after it or one of its amounts changed.
+         * The amounts are combined in list order, as the uncached loops did.
+         * @param auratype the aura type
+         * @param filter which auras of the type are aggregated
+         * @param key misc mask or misc value used by the filter
+         * @return the aggregates
+         */
+        AuraAggregate GetAuraAggregate(AuraType auratype, AuraAggregateFilter filter, int32 key) const;
+
+        mutable AuraAggregate* m_auraAggregates;            // NULL until the first aggregate is cached
+
     private:                                                // Error traps for some wrong args using
         // this will catch and prevent build for any cases when all optional args skipped and instead triggered used non boolean type
         // no bodies expected for this declarations
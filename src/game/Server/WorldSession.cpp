@@ -162,6 +162,14 @@ char const* WorldSession::GetPlayerName() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
+    SendPacket(SharedWorldPacket(*packet));
+}
+
+/// Send a packet to the client, the payload is shared with the other receivers of the same broadcast
+void WorldSession::SendPacket(SharedWorldPacket const& sharedPacket)
+{
+    WorldPacket const* packet = &sharedPacket.Get();
+
 #ifdef ENABLE_PLAYERBOTS
     if (GetPlayer()) {
         if (GetPlayer()->GetPlayerbotAI())
@@ -222,7 +230,7 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
 #endif                                                  // !MANGOS_DEBUG
 
-    if (m_Socket->SendPacket(*packet) == -1)
+    if (m_Socket->SendPacket(sharedPacket) == -1)
     {
         m_Socket->CloseSocket();
     }
@@ -30,6 +30,7 @@
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
 #include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
 
@@ -78,6 +79,46 @@ struct ClientPktHeader
 #pragma pack(pop)
 #endif
 
+/// Max packets written with one gather write, well below IOV_MAX everywhere
+#define MAX_BATCH_IOV 64
+
+int WorldSockAcceptor::open(const ACE_Addr& local_sap, int reuse_addr, int protocol_family, int backlog, int protocol)
+{
+    // same steps as ACE_SOCK_Acceptor::open, with SO_REUSEPORT set before the bind
+    if (local_sap != ACE_Addr::sap_any)
+    {
+        protocol_family = local_sap.get_type();
+    }
+    else if (protocol_family == PF_UNSPEC)
+    {
+        protocol_family = PF_INET;
+    }
+
+    if (ACE_SOCK::open(SOCK_STREAM, protocol_family, protocol, reuse_addr) == -1)
+    {
+        return -1;
+    }
+
+    if (m_ReusePort)
+    {
+#ifdef SO_REUSEPORT
+        int one = 1;
+        if (set_option(SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) == -1)
+        {
+            sLog.outError("WorldSockAcceptor::open: set_option SO_REUSEPORT errno = %s", ACE_OS::strerror(errno));
+            close();
+            return -1;
+        }
+#else
+        close();
+        errno = ENOTSUP;
+        return -1;
+#endif
+    }
+
+    return shared_open(local_sap, protocol_family, backlog);
+}
+
 WorldSocket::WorldSocket(void) :
     WorldHandler(),
     m_LastPingTime(ACE_Time_Value::zero),
@@ -89,6 +130,11 @@ WorldSocket::WorldSocket(void) :
     m_OutBufferLock(),
     m_OutBuffer(0),
     m_OutBufferSize(65536),
+    m_BatchSent(0),
+    m_BufferedPackets(0),
+    m_BatchedWrites(false),
+    m_FlushScheduled(false),
+    m_WakeupScheduled(false),
     m_Seed(rand32())
 {
     reference_counting_policy().value(ACE_Event_Handler::Reference_Counting_Policy::ENABLED);
@@ -107,11 +153,8 @@ WorldSocket::~WorldSocket(void)
 
     peer().close();
 
-    WorldPacket* pct;
-    while (m_PacketQueue.dequeue_head(pct) == 0)
-    {
-        delete pct;
-    }
+    m_PacketQueue.reset();
+    m_BatchQueue.clear();
 }
 
 bool WorldSocket::IsClosed(void) const
@@ -140,6 +183,11 @@ const std::string& WorldSocket::GetRemoteAddress(void) const
 }
 
 int WorldSocket::SendPacket(const WorldPacket& pkt)
+{
+    return SendPacket(SharedWorldPacket(pkt));
+}
+
+int WorldSocket::SendPacket(const SharedWorldPacket& pkt)
 {
     ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
 
@@ -148,19 +196,19 @@ int WorldSocket::SendPacket(const WorldPacket& pkt)
         return -1;
     }
 
-    WorldPacket pct = pkt;
-
-    if (iSendPacket(pct) == -1)
+    if (m_BatchedWrites)
     {
-        WorldPacket* npct;
-
-        ACE_NEW_RETURN(npct, WorldPacket(pct), -1);
+        return iQueueBatched(pkt);
+    }
 
+    // keep the order, nothing may overtake already queued packets; iSendPacket copies
+    // the payload into m_OutBuffer, only the batched path sends from the shared packet
+    if (!m_PacketQueue.is_empty() || iSendPacket(pkt.Get()) == -1)
+    {
         // NOTE maybe check of the size of the queue can be good ?
         // to make it bounded instead of unbounded
-        if (m_PacketQueue.enqueue_tail(npct) == -1)
+        if (m_PacketQueue.enqueue_tail(pkt.Share()) == -1)
         {
-            delete npct;
             sLog.outError("WorldSocket::SendPacket: m_PacketQueue.enqueue_tail failed");
             return -1;
         }
@@ -185,6 +233,35 @@ long WorldSocket::RemoveReference(void)
     return static_cast<long>(remove_reference());
 }
 
+int WorldSocket::FlushBatch(void)
+{
+    ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
+
+    m_FlushScheduled = false;
+
+    if (closing_ || m_WakeupScheduled)
+    {
+        return 0;
+    }
+
+    const int ret = iFlushBatch();
+
+    // kernel buffer is full or the write failed, let the reactor take over,
+    // handle_output will continue or close the socket
+    if (ret != 0)
+    {
+        m_WakeupScheduled = true;
+
+        if (reactor()->schedule_wakeup(this, ACE_Event_Handler::WRITE_MASK) == -1)
+        {
+            sLog.outError("WorldSocket::FlushBatch failed setting WRITE mask, peer = %s", GetRemoteAddress().c_str());
+            return -1;
+        }
+    }
+
+    return ret == -1 ? -1 : 0;
+}
+
 int WorldSocket::open(void* a)
 {
     ACE_UNUSED_ARG(a);
@@ -229,7 +306,12 @@ int WorldSocket::open(void* a)
     WorldPacket packet(SMSG_AUTH_CHALLENGE, 4);
     packet << m_Seed;
 
-    return SendPacket(packet);
+    if (SendPacket(packet) == -1)
+    {
+        return -1;
+    }
+
+    return m_BatchedWrites ? FlushBatch() : 0;
 }
 
 int WorldSocket::close(u_long)
@@ -250,7 +332,19 @@ int WorldSocket::handle_input(ACE_HANDLE)
         return -1;
     }
 
-    switch (handle_input_missing_data())
+    const int ret = handle_input_missing_data();
+
+    // answers to pings and auth are sent from the network thread,
+    // don't let them wait for the next world tick
+    if (m_BatchedWrites && ret != 0)
+    {
+        // the send may change errno, the read result is checked below
+        const int readErrno = errno;
+        FlushBatch();
+        errno = readErrno;
+    }
+
+    switch (ret)
     {
         case -1 :
         {
@@ -280,6 +374,21 @@ int WorldSocket::handle_output(ACE_HANDLE)
         return -1;
     }
 
+    if (m_BatchedWrites)
+    {
+        switch (iFlushBatch())
+        {
+            case -1:
+                return -1;
+            case 0:
+                m_WakeupScheduled = false;
+                reactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK);
+                return 0;
+            default:
+                return 0;
+        }
+    }
+
     const size_t send_len = m_OutBuffer->length();
 
     if (send_len == 0)
@@ -312,6 +421,8 @@ int WorldSocket::handle_output(ACE_HANDLE)
     {
         m_OutBuffer->rd_ptr(static_cast<size_t>(n));
 
+        sWorldSocketMgr->CountWrite(0);
+
         // move the data to the base of the buffer
         m_OutBuffer->crunch();
 
@@ -321,6 +432,9 @@ int WorldSocket::handle_output(ACE_HANDLE)
     {
         m_OutBuffer->reset();
 
+        sWorldSocketMgr->CountWrite(m_BufferedPackets);
+        m_BufferedPackets = 0;
+
         if(!iFlushPacketQueue()) //no more packets in queue
         {
             reactor()->cancel_wakeup(this, ACE_Event_Handler::WRITE_MASK);
@@ -923,12 +1037,141 @@ int WorldSocket::iSendPacket(const WorldPacket& pct)
             ACE_ASSERT(false);
         }
 
+    ++m_BufferedPackets;
+
+    return 0;
+}
+
+int WorldSocket::iQueueBatched(const SharedWorldPacket& pct)
+{
+    WorldPacket const& packet = pct.Get();
+
+    ServerPktHeader header;
+
+    header.cmd = packet.GetOpcode();
+
+    header.size = (uint16) packet.size() + 2;
+
+    EndianConvertReverse(header.size);
+    EndianConvert(header.cmd);
+
+    // headers have to be encrypted in the order they go out, which is the queue order
+    m_Crypt.EncryptSend((uint8*) & header, sizeof(header));
+
+    m_BatchQueue.push_back(BatchedPacket());
+
+    BatchedPacket& batched = m_BatchQueue.back();
+    memcpy(batched.header, &header, sizeof(header));
+    batched.packet = pct.Share();
+
+    if (!m_FlushScheduled && !m_WakeupScheduled)
+    {
+        m_FlushScheduled = true;
+        sWorldSocketMgr->ScheduleFlush(this);
+    }
+
+    return 0;
+}
+
+int WorldSocket::iFlushBatch()
+{
+    while (!m_BatchQueue.empty())
+    {
+        iovec iov[MAX_BATCH_IOV * 2];
+        int iovcnt = 0;
+        size_t total = 0;
+        size_t skip = m_BatchSent;
+
+        // a packet takes up to two entries, header and payload
+        for (std::deque<BatchedPacket>::const_iterator itr = m_BatchQueue.begin(); itr != m_BatchQueue.end() && iovcnt + 2 <= MAX_BATCH_IOV * 2; ++itr)
+        {
+            const size_t header_len = sizeof(itr->header);
+
+            if (skip < header_len)
+            {
+                iov[iovcnt].iov_base = (char*) itr->header + skip;
+                iov[iovcnt].iov_len = header_len - skip;
+                total += iov[iovcnt].iov_len;
+                ++iovcnt;
+                skip = 0;
+            }
+            else
+            {
+                skip -= header_len;
+            }
+
+            if (!itr->packet->empty())
+            {
+                iov[iovcnt].iov_base = (char*) itr->packet->contents() + skip;
+                iov[iovcnt].iov_len = itr->packet->size() - skip;
+                total += iov[iovcnt].iov_len;
+                ++iovcnt;
+            }
+
+            skip = 0;
+        }
+
+#ifdef MSG_NOSIGNAL
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iovcnt;
+
+        ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
+#else
+        ssize_t n = peer().sendv(iov, iovcnt);
+#endif // MSG_NOSIGNAL
+
+        if (n == 0)
+        {
+            return -1;
+        }
+        else if (n == -1)
+        {
+            if (errno == EWOULDBLOCK || errno == EAGAIN)
+            {
+                sWorldSocketMgr->CountWrite(0);
+                return 1;
+            }
+
+            return -1;
+        }
+
+        // drop everything which went out completely
+        uint32 written = 0;
+        size_t left = static_cast<size_t>(n) + m_BatchSent;
+
+        while (!m_BatchQueue.empty())
+        {
+            const size_t len = sizeof(m_BatchQueue.front().header) + m_BatchQueue.front().packet->size();
+
+            if (left < len)
+            {
+                break;
+            }
+
+            left -= len;
+            m_BatchQueue.pop_front();
+            ++written;
+        }
+
+        m_BatchSent = left;
+
+        sWorldSocketMgr->CountWrite(written);
+
+        // kernel buffer is full, wait for the reactor
+        if (static_cast<size_t>(n) < total)
+        {
+            return 1;
+        }
+    }
+
     return 0;
 }
 
 bool WorldSocket::iFlushPacketQueue()
 {
-    WorldPacket* pct;
+    SharedWorldPacket::PacketPtr pct;
     bool haveone = false;
 
     while (m_PacketQueue.dequeue_head(pct) == 0)
@@ -937,7 +1180,6 @@ bool WorldSocket::iFlushPacketQueue()
         {
             if (m_PacketQueue.enqueue_head(pct) == -1)
             {
-                delete pct;
                 sLog.outError("WorldSocket::iFlushPacketQueue m_PacketQueue->enqueue_head");
                 return false;
             }
@@ -947,7 +1189,6 @@ bool WorldSocket::iFlushPacketQueue()
         else
         {
             haveone = true;
-            delete pct;
         }
     }
 
@@ -42,20 +42,47 @@
 #include <ace/Unbounded_Queue.h>
 #include <ace/Message_Block.h>
 
+#include <deque>
+
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 #include "Common.h"
 #include "Auth/AuthCrypt.h"
+#include "WorldPacket.h"
 
 class ACE_Message_Block;
-class WorldPacket;
 class WorldSession;
 class WorldSocket;
 
 typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
-typedef ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR > WorldAcceptor;
+
+/**
+ * Listening socket of the world server.
+ *
+ * Same as ACE_SOCK_Acceptor, but can set SO_REUSEPORT between creating
+ * the socket and binding it. With Network.MultiReactor every reactor
+ * opens its own listener on the world port this way, and the kernel
+ * spreads the incoming connections over them.
+ */
+class WorldSockAcceptor : public ACE_SOCK_Acceptor
+{
+    public:
+        WorldSockAcceptor() : m_ReusePort(false) {}
+
+        /// Set SO_REUSEPORT on the next open(), before the bind.
+        void SetReusePort(bool reusePort) { m_ReusePort = reusePort; }
+
+        /// Hides ACE_SOCK_Acceptor::open, ACE_Acceptor calls it on the template type.
+        int open(const ACE_Addr& local_sap, int reuse_addr = 0, int protocol_family = PF_UNSPEC,
+                 int backlog = ACE_DEFAULT_BACKLOG, int protocol = 0);
+
+    private:
+        bool m_ReusePort;
+};
+
+typedef ACE_Acceptor< WorldSocket, WorldSockAcceptor > WorldAcceptor;
 
 /**
  * WorldSocket.
@@ -103,8 +130,9 @@ class WorldSocket : protected WorldHandler
         /// Mutex type used for various synchronizations.
         typedef ACE_Thread_Mutex LockType;
 
-        /// Queue for storing packets for which there is no space.
-        typedef ACE_Unbounded_Queue< WorldPacket* > PacketQueueT;
+        /// Queue for storing packets for which there is no space,
+        /// the payloads are shared with other receivers of the same packet.
+        typedef ACE_Unbounded_Queue< SharedWorldPacket::PacketPtr > PacketQueueT;
 
         /// Check if socket is closed.
         bool IsClosed(void) const;
@@ -120,12 +148,23 @@ class WorldSocket : protected WorldHandler
         /// @return -1 of failure
         int SendPacket(const WorldPacket& pct);
 
+        /// Send a packet which is broadcast to several sockets, this function is reentrant.
+        /// Unbatched, the payload is copied into m_OutBuffer when it fits; if it has to be
+        /// queued instead, one copy is made for all sockets. Batched, it is never copied.
+        /// @param pct packet to send
+        /// @return -1 of failure
+        int SendPacket(const SharedWorldPacket& pct);
+
         /// Add reference to this object.
         long AddReference(void);
 
         /// Remove reference to this object.
         long RemoveReference(void);
 
+        /// Write out the packets collected in batched mode, called once per world tick.
+        /// @return -1 on failure
+        int FlushBatch(void);
+
     protected:
         /// things called by ACE framework.
         WorldSocket(void);
@@ -173,6 +212,17 @@ class WorldSocket : protected WorldHandler
         /// to mark the socket for output ).
         bool iFlushPacketQueue();
 
+        /// Batched mode: encrypt the header and append the packet to m_BatchQueue,
+        /// the socket is handed to WorldSocketMgr to be flushed at the end of the tick.
+        /// Need to be called with m_OutBufferLock lock held
+        int iQueueBatched(const SharedWorldPacket& pct);
+
+        /// Batched mode: write as much of m_BatchQueue as the socket takes with one
+        /// gather write per MAX_BATCH_IOV chunks.
+        /// Need to be called with m_OutBufferLock lock held
+        /// @return -1 on failure, 1 if data is left over, 0 if the queue is empty
+        int iFlushBatch();
+
     private:
         /// Time in which the last ping was received
         ACE_Time_Value m_LastPingTime;
@@ -213,6 +263,31 @@ class WorldSocket : protected WorldHandler
         /// this allows not-to kick player if its buffer is overflowed.
         PacketQueueT m_PacketQueue;
 
+        /// Packet waiting in batched mode, the header is already encrypted.
+        struct BatchedPacket
+        {
+            uint8 header[4];
+            SharedWorldPacket::PacketPtr packet;
+        };
+
+        /// Packets collected in batched mode, written with writev/sendmsg.
+        std::deque<BatchedPacket> m_BatchQueue;
+
+        /// Bytes of m_BatchQueue.front() already written.
+        size_t m_BatchSent;
+
+        /// Packets copied to m_OutBuffer since the last send.
+        uint32 m_BufferedPackets;
+
+        /// Collect packets and flush them once per tick instead of waking up the reactor per packet.
+        bool m_BatchedWrites;
+
+        /// Socket is already in the flush list of WorldSocketMgr.
+        bool m_FlushScheduled;
+
+        /// WRITE_MASK is set because the kernel buffer filled up during a flush.
+        bool m_WakeupScheduled;
+
         const uint32 m_Seed;
 };
 
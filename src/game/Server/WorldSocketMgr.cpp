@@ -36,6 +36,9 @@
 
 #include <ace/ACE.h>
 #include <ace/TP_Reactor.h>
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+#include <ace/Dev_Poll_Reactor.h>
+#endif
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -44,21 +47,21 @@
 #include <set>
 
 WorldSocketMgr::WorldSocketMgr()
-  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_UseNoDelay(true),
-    reactor_(NULL), acceptor_(NULL)
+  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_UseNoDelay(true), m_UseBatchedWrites(false),
+    m_WriteCalls(0), m_WritePackets(0), m_NextReactor(0), m_NextThread(0)
 {
     InitializeOpcodes();
 }
 
 WorldSocketMgr::~WorldSocketMgr()
 {
-    if (reactor_)
+    for (ReactorList::const_iterator itr = m_Reactors.begin(); itr != m_Reactors.end(); ++itr)
     {
-        delete reactor_;
+        delete *itr;
     }
-    if (acceptor_)
+    for (AcceptorList::const_iterator itr = m_Acceptors.begin(); itr != m_Acceptors.end(); ++itr)
     {
-        delete acceptor_;
+        delete *itr;
     }
 }
 
@@ -67,7 +70,9 @@ int WorldSocketMgr::svc()
 {
     DEBUG_LOG("Starting Network Thread");
 
-    reactor_->run_reactor_event_loop();
+    // with a single reactor all threads share it, else each thread runs its own
+    ACE_Reactor* reactor = m_Reactors[(m_NextThread++) % m_Reactors.size()];
+    reactor->run_reactor_event_loop();
 
     DEBUG_LOG("Network Thread Exitting");
     return 0;
@@ -94,19 +99,63 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
     // -1 means use default
     m_SockOutKBuff = sConfig.GetIntDefault("Network.OutKBuff", -1);
     m_UseNoDelay = sConfig.GetBoolDefault("Network.TcpNodelay", true);
+    m_UseBatchedWrites = sConfig.GetBoolDefault("Network.BatchedWrites", false);
 
 
-    ACE_Reactor_Impl* imp = 0;
-    imp = new ACE_TP_Reactor();
-    imp->max_notify_iterations(128);
-    reactor_ = new ACE_Reactor(imp, 1);
+    bool multiReactor = sConfig.GetBoolDefault("Network.MultiReactor", false);
 
-    acceptor_ = new WorldAcceptor;
+#if !defined (ACE_HAS_EVENT_POLL) && !defined (ACE_HAS_DEV_POLL)
+    if (multiReactor)
+    {
+        sLog.outError("Network.MultiReactor requires epoll support in ACE, using a single reactor");
+        multiReactor = false;
+    }
+#endif
 
-    if (acceptor_->open(addr, reactor_, ACE_NONBLOCK) == -1)
+    // Every reactor is run by exactly one thread in multi reactor mode, so a socket
+    // is only ever handled by one thread and no reactor lock is shared between them.
+    int num_reactors = multiReactor ? num_threads : 1;
+
+    for (int i = 0; i < num_reactors; ++i)
     {
-        sLog.outError("Failed to open acceptor, check if the port is free");
-        return -1;
+        ACE_Reactor_Impl* imp = 0;
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+        if (multiReactor)
+        {
+            // level triggered: ACE sets no EPOLLET, and handle_input reads one buffer per
+            // event where edge triggering would need every socket drained to EAGAIN
+            imp = new ACE_Dev_Poll_Reactor();
+        }
+        else
+#endif
+        {
+            imp = new ACE_TP_Reactor();
+        }
+        imp->max_notify_iterations(128);
+        m_Reactors.push_back(new ACE_Reactor(imp, 1));
+    }
+
+#ifdef SO_REUSEPORT
+    // Every reactor gets its own listener bound with SO_REUSEPORT. The kernel spreads
+    // new connections over the listeners and a socket stays on the reactor that accepted it.
+    int num_acceptors = num_reactors;
+#else
+    // new connections are accepted on the first reactor and then spread over all of them
+    int num_acceptors = 1;
+#endif
+
+    for (int i = 0; i < num_acceptors; ++i)
+    {
+        WorldAcceptor* acceptor = new WorldAcceptor;
+        m_Acceptors.push_back(acceptor);
+
+        acceptor->acceptor().SetReusePort(num_acceptors > 1);
+
+        if (acceptor->open(addr, m_Reactors[i], ACE_NONBLOCK) == -1)
+        {
+            sLog.outError("Failed to open acceptor, check if the port is free");
+            return -1;
+        }
     }
 
     if (activate(THR_NEW_LWP | THR_JOINABLE, num_threads) == -1)
@@ -115,20 +164,83 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
     }
 
     sLog.outString("Max allowed socket connections: %d", ACE::max_handles());
+
+    if (multiReactor)
+    {
+        sLog.outString("Network: using %d epoll reactors and %d listeners", num_reactors, num_acceptors);
+    }
+
+    if (m_UseBatchedWrites)
+    {
+        sLog.outString("Network: outgoing packets are batched and flushed once per world tick");
+    }
     return 0;
 }
 
 void WorldSocketMgr::StopNetwork()
 {
-    if (acceptor_)
+    for (AcceptorList::const_iterator itr = m_Acceptors.begin(); itr != m_Acceptors.end(); ++itr)
     {
-        acceptor_->close();
+        (*itr)->close();
     }
-    if (reactor_)
+    for (ReactorList::const_iterator itr = m_Reactors.begin(); itr != m_Reactors.end(); ++itr)
     {
-        reactor_->end_reactor_event_loop();
+        (*itr)->end_reactor_event_loop();
     }
     wait();
+
+    // drop the references of sockets which were never flushed
+    FlushBatchedSockets();
+}
+
+void WorldSocketMgr::FlushBatchedSockets()
+{
+    SocketList sockets;
+
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_FlushLock);
+        sockets.swap(m_FlushList);
+    }
+
+    for (SocketList::const_iterator itr = sockets.begin(); itr != sockets.end(); ++itr)
+    {
+        (*itr)->FlushBatch();
+        (*itr)->RemoveReference();
+    }
+}
+
+void WorldSocketMgr::ScheduleFlush(WorldSocket* sock)
+{
+    sock->AddReference();
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_FlushLock);
+    m_FlushList.push_back(sock);
+}
+
+void WorldSocketMgr::CountWrite(uint32 packets)
+{
+    ++m_WriteCalls;
+
+    if (packets)
+    {
+        m_WritePackets += packets;
+    }
+}
+
+ACE_Reactor* WorldSocketMgr::NextReactor()
+{
+    if (m_Reactors.size() == 1)
+    {
+        return m_Reactors[0];
+    }
+
+    return m_Reactors[(m_NextReactor++) % m_Reactors.size()];
+}
+
+void WorldSocketMgr::GetWriteStats(uint64& calls, uint64& packets) const
+{
+    calls = m_WriteCalls.value();
+    packets = m_WritePackets.value();
 }
 
 int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
@@ -156,7 +268,13 @@ int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
     }
 
     sock->m_OutBufferSize = static_cast<size_t>(m_SockOutUBuff);
-    sock->reactor(reactor_);
+    sock->m_BatchedWrites = m_UseBatchedWrites;
+
+    // with a listener per reactor the acceptor already gave the socket its own reactor
+    if (m_Acceptors.size() < m_Reactors.size())
+    {
+        sock->reactor(NextReactor());
+    }
 
     return 0;
 }
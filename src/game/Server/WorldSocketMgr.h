@@ -37,10 +37,15 @@
 #include <ace/INET_Addr.h>
 #include <ace/Task.h>
 #include <ace/Acceptor.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+#include <vector>
 
 class WorldSocket;
 
-/// This is a pool of threads designed to be used by an ACE_TP_Reactor.
+/// This is a pool of threads designed to be used by an ACE_TP_Reactor,
+/// or with Network.MultiReactor by one epoll reactor and listener per thread.
 /// Manages all sockets connected to peers
 
 class WorldSocketMgr : public ACE_Task_Base
@@ -51,8 +56,26 @@ class WorldSocketMgr : public ACE_Task_Base
         int StartNetwork(ACE_INET_Addr& addr);
         void StopNetwork();
 
+        /// Write out everything the sockets collected in batched mode during this tick.
+        /// Called by the world thread after each world update.
+        void FlushBatchedSockets();
+
+        /// Socket write syscalls and the packets they completed, for packets per syscall.
+        void GetWriteStats(uint64& calls, uint64& packets) const;
+
+        bool IsBatchedWrites() const { return m_UseBatchedWrites; }
+
     private:
         int OnSocketOpen(WorldSocket* sock);
+
+        /// Queue a socket with batched packets for the next FlushBatchedSockets().
+        void ScheduleFlush(WorldSocket* sock);
+
+        /// Count one write syscall which completed packets packets.
+        void CountWrite(uint32 packets);
+
+        /// Reactor for a new socket accepted by the single listener, round robin over m_Reactors.
+        ACE_Reactor* NextReactor();
         virtual int svc();
 
         WorldSocketMgr();
@@ -62,9 +85,25 @@ class WorldSocketMgr : public ACE_Task_Base
         int m_SockOutKBuff;
         int m_SockOutUBuff;
         bool m_UseNoDelay;
+        bool m_UseBatchedWrites;
+
+        typedef std::vector<WorldSocket*> SocketList;
+
+        ACE_Thread_Mutex m_FlushLock;
+        SocketList m_FlushList;                             ///< sockets with batched packets, referenced
+
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_WriteCalls;
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint64> m_WritePackets;
+
+        typedef std::vector<ACE_Reactor*> ReactorList;
+
+        ReactorList m_Reactors;                             ///< one shared reactor, or one per network thread
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_NextReactor;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_NextThread;
+
+        typedef std::vector<WorldAcceptor*> AcceptorList;
 
-        ACE_Reactor   *reactor_;
-        WorldAcceptor *acceptor_;
+        AcceptorList m_Acceptors;                           ///< one listener, or one per reactor bound with SO_REUSEPORT
 };
 
 #define sWorldSocketMgr ACE_Singleton<WorldSocketMgr, ACE_Thread_Mutex>::instance()
@@ -123,6 +123,9 @@ struct Cell
         template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
         template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
+        // calls func(WorldObject*) for the objects of loaded cells whose bounding circle reaches within radius + centerSize of the point
+        template<class F> static void VisitPositionIndex(float x, float y, Map* map, float radius, float centerSize, uint16 typeMask, F& func);
+
     private:
         template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map&, const CellPair& , const CellPair&) const;
 };
@@ -265,4 +265,38 @@ inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float
     cell.Visit(p, wnotifier, *map, x, y, radius);
 }
 
+/**
+ * Sweeps the position indexes of the cells a radius around a point covers.
+ *
+ * The cells are the ones Cell::Visit would walk for the same radius, but
+ * objects far from the point are rejected from the coordinate arrays
+ * instead of being visited one by one. Grids which are not loaded are
+ * skipped and never loaded, as with dont_load.
+ * @param x
+ * @param y
+ * @param map
+ * @param radius Distance to the point, also used to select the cells.
+ * @param centerSize Bounding radius of the object at the point, if the exact check adds it.
+ * @param typeMask TypeMask of the wanted objects.
+ * @param func Called with the WorldObject* of each match.
+ */
+template<class F>
+inline void Cell::VisitPositionIndex(float x, float y, Map* map, float radius, float centerSize, uint16 typeMask, F& func)
+{
+    // same limit as Cell::Visit
+    CellArea area = Cell::CalculateCellArea(x, y, std::min(radius, 333.0f));
+
+    for (uint32 loopX = area.low_bound.x_coord; loopX <= area.high_bound.x_coord; ++loopX)
+    {
+        for (uint32 loopY = area.low_bound.y_coord; loopY <= area.high_bound.y_coord; ++loopY)
+        {
+            Cell cell(CellPair(loopX, loopY));
+            if (CellPositionIndex const* index = map->GetPositionIndex(cell))
+            {
+                index->Sweep(x, y, radius + centerSize, typeMask, func);
+            }
+        }
+    }
+}
+
 #endif
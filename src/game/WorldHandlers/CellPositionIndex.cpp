@@ -0,0 +1,103 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#include "CellPositionIndex.h"
+#include "Object.h"
+
+CellPositionIndex::~CellPositionIndex()
+{
+    // objects still registered outlive their grid, they must not update freed memory
+    for (std::vector<WorldObject*>::const_iterator itr = m_objects.begin(); itr != m_objects.end(); ++itr)
+    {
+        (*itr)->m_positionIndex = NULL;
+    }
+}
+
+void CellPositionIndex::Insert(WorldObject* obj)
+{
+    // like a grid reference, an object is only listed in one cell
+    if (obj->m_positionIndex)
+    {
+        obj->m_positionIndex->Remove(obj);
+    }
+
+    static const TypeMask indexedTypes[] = { TYPEMASK_UNIT, TYPEMASK_PLAYER, TYPEMASK_GAMEOBJECT, TYPEMASK_DYNAMICOBJECT, TYPEMASK_CORPSE };
+
+    uint16 typeMask = 0;
+    for (size_t i = 0; i < countof(indexedTypes); ++i)
+    {
+        if (obj->isType(indexedTypes[i]))
+        {
+            typeMask |= indexedTypes[i];
+        }
+    }
+
+    obj->m_positionIndex = this;
+    obj->m_positionIndexSlot = uint32(m_objects.size());
+
+    m_x.push_back(obj->GetPositionX());
+    m_y.push_back(obj->GetPositionY());
+    m_reach.push_back(obj->GetObjectBoundingRadius());
+    m_typeMask.push_back(typeMask);
+    m_objects.push_back(obj);
+}
+
+void CellPositionIndex::Remove(WorldObject* obj)
+{
+    if (obj->m_positionIndex != this)
+    {
+        return;
+    }
+
+    uint32 slot = obj->m_positionIndexSlot;
+    uint32 last = uint32(m_objects.size() - 1);
+
+    if (slot != last)
+    {
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_reach[slot] = m_reach[last];
+        m_typeMask[slot] = m_typeMask[last];
+        m_objects[slot] = m_objects[last];
+        m_objects[slot]->m_positionIndexSlot = slot;
+    }
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_reach.pop_back();
+    m_typeMask.pop_back();
+    m_objects.pop_back();
+
+    obj->m_positionIndex = NULL;
+}
+
+void CellPositionIndex::Update(WorldObject* obj)
+{
+    uint32 slot = obj->m_positionIndexSlot;
+
+    m_x[slot] = obj->GetPositionX();
+    m_y[slot] = obj->GetPositionY();
+    m_reach[slot] = obj->GetObjectBoundingRadius();
+}
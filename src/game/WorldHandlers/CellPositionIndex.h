@@ -0,0 +1,124 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#ifndef MANGOS_CELLPOSITIONINDEX_H
+#define MANGOS_CELLPOSITIONINDEX_H
+
+#include "Common.h"
+
+#include <algorithm>
+#include <vector>
+
+class Camera;
+class WorldObject;
+
+/**
+ * @brief Positions of the objects of one grid cell, kept as parallel arrays.
+ *
+ * Every world object added to a cell is registered here by the cell's Grid,
+ * and WorldObject::Relocate keeps its entry up to date. A range query sweeps
+ * the coordinate arrays in blocks, which the compiler turns into vector
+ * instructions, and only touches the objects which pass the distance and
+ * type checks. Cameras are part of the cell lists but have no position of
+ * their own, they are not indexed.
+ *
+ * The entries are unordered, removal moves the last entry into the freed
+ * slot. Objects remember their slot to be updated and removed directly.
+ */
+class CellPositionIndex
+{
+    public:
+        CellPositionIndex() {}
+        ~CellPositionIndex();
+
+        void Insert(WorldObject* obj);
+        void Insert(Camera* /*camera*/) {}
+
+        void Remove(WorldObject* obj);
+        void Remove(Camera* /*camera*/) {}
+
+        /**
+         * @brief Copies the current position and bounding radius of an indexed object.
+         * @param obj Object registered in this index.
+         */
+        void Update(WorldObject* obj);
+
+        size_t Size() const { return m_objects.size(); }
+
+        /**
+         * @brief Calls a functor for the objects which may be within a distance of a point.
+         *
+         * An object is passed if its type matches the mask and its bounding
+         * circle reaches into the circle around the point, the distance is
+         * measured in 2d. Exact checks are left to the functor.
+         * The functor must not add, remove or move objects of this cell.
+         * @param x
+         * @param y
+         * @param radius Distance to the point.
+         * @param typeMask TypeMask of the wanted objects.
+         * @param func Called with the WorldObject* of each match.
+         */
+        template<class F>
+        void Sweep(float x, float y, float radius, uint16 typeMask, F& func) const
+        {
+            size_t const count = m_objects.size();
+            for (size_t begin = 0; begin < count; begin += SWEEP_BLOCK)
+            {
+                size_t const end = std::min(count, begin + SWEEP_BLOCK);
+
+                // no branches in this loop, every entry of the block is tested
+                uint8 hits[SWEEP_BLOCK];
+                for (size_t i = begin; i < end; ++i)
+                {
+                    float const dx = m_x[i] - x;
+                    float const dy = m_y[i] - y;
+                    float const reach = radius + m_reach[i];
+                    hits[i - begin] = uint8(dx * dx + dy * dy <= reach * reach) & uint8((m_typeMask[i] & typeMask) != 0);
+                }
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (hits[i - begin])
+                    {
+                        func(m_objects[i]);
+                    }
+                }
+            }
+        }
+
+    private:
+        CellPositionIndex(CellPositionIndex const&);
+        CellPositionIndex& operator=(CellPositionIndex const&);
+
+        static const size_t SWEEP_BLOCK = 64;
+
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_reach;                         // bounding radius
+        std::vector<uint16> m_typeMask;
+        std::vector<WorldObject*> m_objects;
+};
+
+#endif
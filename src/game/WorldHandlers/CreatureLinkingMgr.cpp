@@ -46,6 +46,7 @@
 #include "SharedDefines.h"
 #include "Creature.h"
 #include "CreatureAI.h"
+#include "MapRegionUpdater.h"
 
 INSTANTIATE_SINGLETON_1(CreatureLinkingMgr);
 
@@ -451,6 +452,26 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
         return;
     }
 
+    // linked creatures may be in other grids, a region worker leaves the event to the merge
+    if (MapRegionContext* context = MapRegionUpdater::current_context())
+    {
+        Map* map = pSource->GetMap();
+        ObjectGuid sourceGuid = pSource->GetObjectGuid();
+        ObjectGuid enemyGuid = pEnemy ? pEnemy->GetObjectGuid() : ObjectGuid();
+        context->calls.push_back([this, map, eventType, sourceGuid, enemyGuid]()
+        {
+            Unit* enemy = enemyGuid.IsEmpty() ? NULL : map->GetUnit(enemyGuid);
+            if (Creature* source = map->GetAnyTypeCreature(sourceGuid))
+            {
+                if (eventType != LINKING_EVENT_AGGRO || enemy)
+                {
+                    DoCreatureLinkingEvent(eventType, source, enemy);
+                }
+            }
+        });
+        return;
+    }
+
     uint32 eventFlagFilter = 0;
     uint32 reverseEventFlagFilter = 0;
 
@@ -34,6 +34,11 @@
 #include "Policies/Singleton.h"
 #include "Util.h"
 
+#include <ace/OS_NS_unistd.h>
+#include <G3D/Vector3.h>
+
+#include <memory>
+
 char const* MAP_MAGIC         = "MAPS";
 char const* MAP_VERSION_MAGIC = "z1.5";
 char const* MAP_AREA_MAGIC    = "AREA";
@@ -68,6 +73,8 @@ GridMap::GridMap()
     m_liquidFlags = NULL;
     m_liquidEntry = NULL;
     m_liquid_map  = NULL;
+
+    m_file = NULL;
 }
 
 GridMap::~GridMap()
@@ -80,68 +87,82 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (ACE_OS::access(filename, R_OK) != 0)
     {
         return true;
     }
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    // the file is mapped read only and the arrays point into it, so reloading a grid
+    // is served from the page cache which is shared with other processes
+    m_file = new ACE_Mem_Map();
+    if (m_file->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, MAP_SHARED) == -1)
+    {
+        sLog.outError("Error mapping map file '%s'", filename);
+        unloadData();
+        return false;
+    }
+
+    // the mapping stays valid without the descriptor, don't hold one per loaded grid
+    m_file->close_handle();
+
+    GridMapFileHeader header;
+    if (readData(&header, 0, sizeof(header)) &&
+            header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)) &&
             IsAcceptableClientBuild(header.buildMagic))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesOffset && !loadHolesData(header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version created with a different map-extractor version.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    // arrays point into the mapped file, only misaligned ones were copied
+    for (std::vector<uint8*>::const_iterator itr = m_copies.begin(); itr != m_copies.end(); ++itr)
+    {
+        delete[] *itr;
+    }
+    m_copies.clear();
+
+    delete m_file;
+    m_file = NULL;
 
     m_area_map = NULL;
     m_V9 = NULL;
@@ -152,12 +173,42 @@ void GridMap::unloadData()
     m_gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::readData(void* dest, uint32 offset, uint32 size) const
+{
+    if (!m_file || uint64(offset) + size > m_file->size())
+    {
+        return false;
+    }
+
+    memcpy(dest, static_cast<uint8 const*>(m_file->addr()) + offset, size);
+    return true;
+}
+
+template<typename T>
+T* GridMap::mapArray(uint32 offset, uint32 count)
+{
+    if (!m_file || uint64(offset) + uint64(count) * sizeof(T) > m_file->size())
+    {
+        return NULL;
+    }
+
+    uint8* data = static_cast<uint8*>(m_file->addr()) + offset;
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+    {
+        return reinterpret_cast<T*>(data);
+    }
+
+    // sections following 8 bit height data are not aligned
+    uint8* copy = new uint8[count * sizeof(T)];
+    memcpy(copy, data, count * sizeof(T));
+    m_copies.push_back(copy);
+    return reinterpret_cast<T*>(copy);
+}
+
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    size_t file_read = fread(&header, sizeof(header), 1, in);
-    if (file_read <= 0)
+    if (!readData(&header, offset, sizeof(header)))
     {
         return false;
     }
@@ -169,9 +220,8 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        file_read = fread(m_area_map, sizeof(uint16), 16 * 16, in);
-        if (file_read <= 0)
+        m_area_map = mapArray<uint16>(offset + sizeof(header), 16 * 16);
+        if (!m_area_map)
         {
             return false;
         }
@@ -180,12 +230,10 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    size_t file_read = fread(&header, sizeof(header), 1, in);
-    if (file_read <= 0)
+    if (!readData(&header, offset, sizeof(header)))
     {
         return false;
     }
@@ -195,19 +243,15 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     }
 
     m_gridHeight = header.gridHeight;
+    offset += sizeof(header);
+
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            file_read = fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            if (file_read <= 0)
-            {
-                return false;
-            }
-            file_read = fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
-            if (file_read <= 0)
+            m_uint16_V9 = mapArray<uint16>(offset, 129 * 129);
+            m_uint16_V8 = mapArray<uint16>(offset + sizeof(uint16) * 129 * 129, 128 * 128);
+            if (!m_uint16_V9 || !m_uint16_V8)
             {
                 return false;
             }
@@ -216,15 +260,9 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            file_read = fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            if (file_read <= 0)
-            {
-                return false;
-            }
-            file_read = fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
-            if (file_read <= 0)
+            m_uint8_V9 = mapArray<uint8>(offset, 129 * 129);
+            m_uint8_V8 = mapArray<uint8>(offset + sizeof(uint8) * 129 * 129, 128 * 128);
+            if (!m_uint8_V9 || !m_uint8_V8)
             {
                 return false;
             }
@@ -233,15 +271,9 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            file_read = fread(m_V9, sizeof(float), 129 * 129, in);
-            if (file_read <= 0)
-            {
-                return false;
-            }
-            file_read = fread(m_V8, sizeof(float), 128 * 128, in);
-            if (file_read <= 0)
+            m_V9 = mapArray<float>(offset, 129 * 129);
+            m_V8 = mapArray<float>(offset + sizeof(float) * 129 * 129, 128 * 128);
+            if (!m_V9 || !m_V8)
             {
                 return false;
             }
@@ -256,26 +288,15 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-    {
-        return false;
-    }
-
-    if (fread(&m_holes, sizeof(m_holes), 1, in) != 1)
-    {
-        return false;
-    }
-    return true;
+    return readData(&m_holes, offset, sizeof(m_holes));
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    size_t file_read = fread(&header, sizeof(header), 1, in);
-    if (file_read <= 0)
+    if (!readData(&header, offset, sizeof(header)))
     {
         return false;
     }
@@ -291,28 +312,23 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     m_liquid_height = header.height;
     m_liquidLevel   = header.liquidLevel;
 
+    offset += sizeof(header);
+
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        file_read = fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
-        if (file_read <= 0)
-        {
-            return false;
-        }
-
-        m_liquidFlags = new uint8[16 * 16];
-        file_read = fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
-        if (file_read <= 0)
+        m_liquidEntry = mapArray<uint16>(offset, 16 * 16);
+        m_liquidFlags = mapArray<uint8>(offset + sizeof(uint16) * 16 * 16, 16 * 16);
+        if (!m_liquidEntry || !m_liquidFlags)
         {
             return false;
         }
+        offset += (sizeof(uint16) + sizeof(uint8)) * 16 * 16;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        file_read = fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
-        if (file_read <= 0)
+        m_liquid_map = mapArray<float>(offset, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
         {
             return false;
         }
@@ -806,7 +822,10 @@ bool GridMap::ExistVMap(uint32 mapid, int gx, int gy)
 }
 
 //////////////////////////////////////////////////////////////////////////
-TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid), m_refMutex(), m_mutex()
+AtomicLong TerrainInfo::s_preloadUsed(0);
+AtomicLong TerrainInfo::s_preloadExpired(0);
+
+TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid), m_queryCache(sWorld.getConfig(CONFIG_UINT32_TERRAIN_QUERY_CACHE_SIZE)), m_refMutex(), m_mutex()
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
     {
@@ -834,6 +853,11 @@ TerrainInfo::~TerrainInfo()
             delete m_GridMaps[i][k];
         }
 
+    for (PreloadedGridMaps::iterator itr = m_PreloadedMaps.begin(); itr != m_PreloadedMaps.end(); ++itr)
+    {
+        delete itr->second.map;
+    }
+
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
 }
@@ -881,6 +905,26 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
         return;
     }
 
+    // drop preloaded data no map asked for, the prediction was wrong
+    {
+        ACE_GUARD(LOCK_TYPE, lock, m_mutex)
+
+        const uint32 now = getMSTime();
+        for (PreloadedGridMaps::iterator itr = m_PreloadedMaps.begin(); itr != m_PreloadedMaps.end();)
+        {
+            if (getMSTimeDiff(itr->second.loadTime, now) > GRID_PRELOAD_EXPIRY)
+            {
+                delete itr->second.map;
+                m_PreloadedMaps.erase(itr++);
+                ++s_preloadExpired;
+            }
+            else
+            {
+                ++itr;
+            }
+        }
+    }
+
     for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
@@ -898,6 +942,7 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
 
                 // unload VMAPS...
                 VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId, x, y);
+                m_queryCache.Invalidate();
 
                 // unload mmap...
                 MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
@@ -934,6 +979,87 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 }
 
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    if (!m_queryCache.IsEnabled())
+    {
+        return CalculateHeightStatic(x, y, z, useVmaps, maxSearchDist);
+    }
+
+    TerrainQueryCache::Key key = TerrainQueryCache::HeightKey(x, y, z, useVmaps, maxSearchDist);
+    float height;
+    if (m_queryCache.Find(TERRAIN_QUERY_HEIGHT, key, height))
+    {
+        return height;
+    }
+
+    // read before the vmap may be loaded by the query itself
+    uint32 generation = m_queryCache.GetGeneration();
+    height = CalculateHeightStatic(x, y, z, useVmaps, maxSearchDist);
+    m_queryCache.Store(TERRAIN_QUERY_HEIGHT, key, generation, height);
+    return height;
+}
+
+bool TerrainInfo::IsInLineOfSightStatic(float x1, float y1, float z1, float x2, float y2, float z2) const
+{
+    if (!m_queryCache.IsEnabled())
+    {
+        return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetMapId(), x1, y1, z1, x2, y2, z2);
+    }
+
+    TerrainQueryCache::Key key = TerrainQueryCache::LineOfSightKey(x1, y1, z1, x2, y2, z2);
+    float inSight;
+    if (m_queryCache.Find(TERRAIN_QUERY_LINE_OF_SIGHT, key, inSight))
+    {
+        return inSight != 0.0f;
+    }
+
+    uint32 generation = m_queryCache.GetGeneration();
+    bool result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetMapId(), x1, y1, z1, x2, y2, z2);
+    m_queryCache.Store(TERRAIN_QUERY_LINE_OF_SIGHT, key, generation, result ? 1.0f : 0.0f);
+    return result;
+}
+
+void TerrainInfo::IsInLineOfSightStatic(G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) const
+{
+    // lines answered by the cache are left out of the ray packets
+    std::vector<G3D::Vector3> missFrom;
+    std::vector<G3D::Vector3> missTo;
+    std::vector<uint32> missIndex;
+    std::vector<TerrainQueryCache::Key> missKey;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        TerrainQueryCache::Key key = TerrainQueryCache::LineOfSightKey(from[i].x, from[i].y, from[i].z, to[i].x, to[i].y, to[i].z);
+        float inSight;
+        if (m_queryCache.Find(TERRAIN_QUERY_LINE_OF_SIGHT, key, inSight))
+        {
+            results[i] = inSight != 0.0f;
+            continue;
+        }
+
+        missFrom.push_back(from[i]);
+        missTo.push_back(to[i]);
+        missIndex.push_back(i);
+        missKey.push_back(key);
+    }
+
+    if (missIndex.empty())
+    {
+        return;
+    }
+
+    uint32 generation = m_queryCache.GetGeneration();
+    std::unique_ptr<bool[]> missResults(new bool[missIndex.size()]);
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetMapId(), &missFrom[0], &missTo[0], missResults.get(), uint32(missIndex.size()));
+
+    for (size_t i = 0; i < missIndex.size(); ++i)
+    {
+        results[missIndex[i]] = missResults[i];
+        m_queryCache.Store(TERRAIN_QUERY_LINE_OF_SIGHT, missKey[i], generation, missResults[i] ? 1.0f : 0.0f);
+    }
+}
+
+float TerrainInfo::CalculateHeightStatic(float x, float y, float z, bool useVmaps, float maxSearchDist) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
     float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
@@ -1291,21 +1417,35 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
         if (!m_GridMaps[x][y])
         {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+            GridMap* map = NULL;
 
-            if (!map->loadData(tmp))
+            // the grid preloader may have read the map file already
+            PreloadedGridMaps::iterator preloaded = m_PreloadedMaps.find(x * MAX_NUMBER_OF_GRIDS + y);
+            if (preloaded != m_PreloadedMaps.end())
             {
-                sLog.outError("Error load map file: \n %s\n", tmp);
-                // ASSERT(false);
+                map = preloaded->second.map;
+                m_PreloadedMaps.erase(preloaded);
+                ++s_preloadUsed;
+            }
+            else
+            {
+                map = new GridMap();
+
+                // map file name
+                int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+                char* tmp = new char[len];
+                snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+                if (!map->loadData(tmp))
+                {
+                    sLog.outError("Error load map file: \n %s\n", tmp);
+                    // ASSERT(false);
+                }
+
+                delete[] tmp;
             }
 
-            delete[] tmp;
             m_GridMaps[x][y] = map;
 
             // load VMAPs for current map/grid...
@@ -1317,6 +1457,7 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
             {
                 case VMAP::VMAP_LOAD_RESULT_OK:
                     DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMAP loaded name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", mapName, m_mapId, x, y, x, y);
+                    m_queryCache.Invalidate();
                     break;
                 case VMAP::VMAP_LOAD_RESULT_ERROR:
                     DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Could not load VMAP name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", mapName, m_mapId, x, y, x, y);
@@ -1334,6 +1475,54 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
     return  m_GridMaps[x][y];
 }
 
+bool TerrainInfo::PreloadGridMap(const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    const uint32 key = x * MAX_NUMBER_OF_GRIDS + y;
+
+    {
+        ACE_GUARD_RETURN(LOCK_TYPE, lock, m_mutex, false)
+        if (m_GridMaps[x][y] || m_PreloadedMaps.find(key) != m_PreloadedMaps.end())
+        {
+            return false;
+        }
+    }
+
+    // read the file without holding the lock, map threads keep loading other grids meanwhile
+    GridMap* map = new GridMap();
+
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Preloading map %s", tmp);
+
+    // leave broken files to LoadMapAndVMap, which reports them
+    bool loaded = map->loadData(tmp);
+    delete[] tmp;
+
+    ACE_GUARD_RETURN(LOCK_TYPE, lock, m_mutex, false)
+
+    // the map thread may have been faster
+    if (!loaded || m_GridMaps[x][y] || m_PreloadedMaps.find(key) != m_PreloadedMaps.end())
+    {
+        delete map;
+        return false;
+    }
+
+    PreloadedGridMap& preloaded = m_PreloadedMaps[key];
+    preloaded.map = map;
+    preloaded.loadTime = getMSTime();
+    return true;
+}
+
+void TerrainInfo::GetPreloadStats(uint32& used, uint32& expired)
+{
+    used = uint32(s_preloadUsed.value());
+    expired = uint32(s_preloadExpired.value());
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= NULL*/) const
 {
     if (const_cast<TerrainInfo*>(this)->GetGrid(x, y))
@@ -1415,6 +1604,9 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
 
 void TerrainManager::Update(const uint32 diff)
 {
+    // the grid preloader thread may unload a terrain it held the last reference of
+    ACE_GUARD(LOCK_TYPE, _guard, m_mutex)
+
     // global garbage collection for GridMap objects and VMaps
     for (TerrainDataMap::iterator iter = i_TerrainMap.begin(); iter != i_TerrainMap.end(); ++iter)
     {
@@ -1422,6 +1614,16 @@ void TerrainManager::Update(const uint32 diff)
     }
 }
 
+void TerrainManager::InvalidateQueryCaches()
+{
+    ACE_GUARD(LOCK_TYPE, _guard, m_mutex)
+
+    for (TerrainDataMap::const_iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
+    {
+        it->second->InvalidateQueryCache();
+    }
+}
+
 void TerrainManager::UnloadAll()
 {
     for (TerrainDataMap::iterator it = i_TerrainMap.begin(); it != i_TerrainMap.end(); ++it)
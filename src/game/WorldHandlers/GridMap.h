@@ -28,9 +28,13 @@
 #include "Platform/Define.h"
 #include "Policies/Singleton.h"
 #include "GridDefines.h"
+#include "TerrainQueryCache.h"
+
+#include <ace/Mem_Map.h>
 
 #include <bitset>
 #include <list>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -40,6 +44,11 @@ class Group;
 class BattleGround;
 class Map;
 
+namespace G3D
+{
+    class Vector3;
+}
+
 struct GridMapFileHeader
 {
     uint32 mapMagic;
@@ -158,10 +167,18 @@ class GridMap
         uint8* m_liquidFlags;
         float* m_liquid_map;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        // mapped .map file, the data arrays point into it
+        ACE_Mem_Map* m_file;
+        // arrays which had to be copied out of the file as they are not aligned
+        std::vector<uint8*> m_copies;
+
+        bool readData(void* dest, uint32 offset, uint32 size) const;
+        template<typename T> T* mapArray(uint32 offset, uint32 count);
+
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
+        bool loadHolesData(uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -215,6 +232,7 @@ typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> AtomicLong;
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     10.0f                     // default search distance to find height at nearby locations
 #define DEFAULT_WATER_SEARCH      50.0f                     // default search distance to case detection water level
+#define GRID_PRELOAD_EXPIRY      120000                     // preloaded GridMap objects not used by a map within this time (ms) are dropped
 
 // class for sharing and managin GridMap objects
 class TerrainInfo : public Referencable<AtomicLong>
@@ -228,6 +246,10 @@ class TerrainInfo : public Referencable<AtomicLong>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // line of sight through static geometry only, the dynamic tree belongs to the map instance
+        bool IsInLineOfSightStatic(float x1, float y1, float z1, float x2, float y2, float z2) const;
+        // several lines at once, traced through the vmap tree in ray packets
+        void IsInLineOfSightStatic(G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = NULL) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = NULL, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = 0) const;
@@ -253,6 +275,19 @@ class TerrainInfo : public Referencable<AtomicLong>
         // THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
         void CleanUpGrids(const uint32 diff);
 
+        // read the .map file of a grid ahead of time, used by the GridPreloader threads
+        // the data is kept aside without a reference until the map loads the grid,
+        // returns false if the grid was already loaded or preloaded
+        bool PreloadGridMap(const uint32 x, const uint32 y);
+        // unlocked check, only a hint when called outside of the map update
+        bool IsGridMapLoaded(const uint32 x, const uint32 y) const { return m_GridMaps[x][y] != NULL; }
+
+        // number of preloaded GridMap objects picked up by a map / dropped unused
+        static void GetPreloadStats(uint32& used, uint32& expired);
+
+        // drop cached height and line of sight results, e.g. when the vmap settings changed
+        void InvalidateQueryCache() { m_queryCache.Invalidate(); }
+
     protected:
         friend class Map;
         // load/unload terrain data
@@ -264,6 +299,7 @@ class TerrainInfo : public Referencable<AtomicLong>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y);
+        float CalculateHeightStatic(float x, float y, float z, bool useVmaps, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
 
         int RefGrid(const uint32& x, const uint32& y);
@@ -271,6 +307,22 @@ class TerrainInfo : public Referencable<AtomicLong>
 
         const uint32 m_mapId;
 
+        struct PreloadedGridMap
+        {
+            GridMap* map;
+            uint32 loadTime;
+        };
+        typedef UNORDERED_MAP<uint32, PreloadedGridMap> PreloadedGridMaps;
+
+        // GridMap objects read by the preloader, guarded by m_mutex
+        PreloadedGridMaps m_PreloadedMaps;
+
+        static AtomicLong s_preloadUsed;
+        static AtomicLong s_preloadExpired;
+
+        // quantized static height and line of sight results, dropped when vmap tiles change
+        mutable TerrainQueryCache m_queryCache;
+
         GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
@@ -295,6 +347,7 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
 
         void Update(const uint32 diff);
         void UnloadAll();
+        void InvalidateQueryCaches();
 
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
@@ -45,13 +45,13 @@ void VisibleChangesNotifier::Visit(CameraMapType& m)
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    // at this moment guids not marked by the pass are the ones not iterated at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = player.GetTransport())
     {
         for (UnitSet::const_iterator itr = transport->GetPassengers().begin(); itr != transport->GetPassengers().end(); ++itr)
         {
-            if (i_clientGUIDs.find((*itr)->GetObjectGuid()) != i_clientGUIDs.end())
+            if (player.m_clientGUIDs.IsUnmarked((*itr)->GetObjectGuid(), i_pass))
             {
                 // ignore far sight case
                 if(Player* p = (*itr)->ToPlayer())
@@ -59,17 +59,17 @@ void VisibleNotifier::Notify()
                     p->UpdateVisibilityOf(p, &player);
                 }
                 player.UpdateVisibilityOf(&player, (WorldObject*)(*itr), i_data, i_visibleNow);
-                i_clientGUIDs.erase((*itr)->GetObjectGuid());
+                player.m_clientGUIDs.Mark((*itr)->GetObjectGuid());
             }
         }
     }
 
     // generate outOfRange for not iterate objects
-    i_data.AddOutOfRangeGUID(i_clientGUIDs);
-    for (GuidSet::iterator itr = i_clientGUIDs.begin(); itr != i_clientGUIDs.end(); ++itr)
+    GuidSet outOfRange;
+    player.m_clientGUIDs.ExtractUnmarked(i_pass, outOfRange);
+    i_data.AddOutOfRangeGUID(outOfRange);
+    for (GuidSet::const_iterator itr = outOfRange.begin(); itr != outOfRange.end(); ++itr)
     {
-        player.m_clientGUIDs.erase(*itr);
-
         DEBUG_FILTER_LOG(LOG_FILTER_VISIBILITY_CHANGES, "%s is out of range (no in active cells set) now for %s",
                          itr->GetString().c_str(), player.GetGuidStr().c_str());
     }
@@ -40,15 +40,26 @@ namespace MaNGOS
     {
         Camera& i_camera;
         UpdateData i_data;
-        GuidSet i_clientGUIDs;
+        uint32 i_pass;                                      // objects of the client not marked by this pass are out of range at Notify
         std::set<WorldObject*> i_visibleNow;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->m_clientGUIDs) {}
+        explicit VisibleNotifier(Camera& c) : i_camera(c), i_pass(c.GetOwner()->m_clientGUIDs.BeginPass()) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
     };
 
+    // for cells which were and still are wholly in visibility range: objects at client are only marked, their distance can't have changed the result
+    struct VisibleKeepNotifier
+    {
+        VisibleNotifier& i_notifier;
+
+        explicit VisibleKeepNotifier(VisibleNotifier& notifier) : i_notifier(notifier) {}
+        template<class T> void Visit(GridRefManager<T>& m);
+        void Visit(GameObjectMapType& m);
+        void Visit(CameraMapType& /*m*/) {}
+    };
+
     struct VisibleChangesNotifier
     {
         WorldObject& i_object;
@@ -61,20 +72,20 @@ namespace MaNGOS
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
-        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
+        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(*msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
     struct MessageDelivererExcept
     {
-        WorldPacket*  i_message;
+        SharedWorldPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldPacket* msg, Player const* skipped)
-            : i_message(msg), i_skipped_receiver(skipped) {}
+            : i_message(*msg), i_skipped_receiver(skipped) {}
 
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
@@ -82,8 +93,8 @@ namespace MaNGOS
 
     struct ObjectMessageDeliverer
     {
-        WorldPacket* i_message;
-        explicit ObjectMessageDeliverer(WorldPacket* msg) : i_message(msg) {}
+        SharedWorldPacket i_message;
+        explicit ObjectMessageDeliverer(WorldPacket* msg) : i_message(*msg) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -91,13 +102,13 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
 
         MessageDistDeliverer(Player const& pl, WorldPacket* msg, float dist, bool to_self, bool ownTeamOnly)
-            : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
+            : i_player(pl), i_message(*msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -105,9 +116,9 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         float i_dist;
-        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
+        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(*msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
@@ -123,24 +134,6 @@ namespace MaNGOS
         void Visit(CreatureMapType&);
     };
 
-    struct PlayerRelocationNotifier
-    {
-        Player& i_player;
-        PlayerRelocationNotifier(Player& pl) : i_player(pl) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
-        void Visit(CreatureMapType&);
-    };
-
-    struct CreatureRelocationNotifier
-    {
-        Creature& i_creature;
-        CreatureRelocationNotifier(Creature& c) : i_creature(c) {}
-        template<class T> void Visit(GridRefManager<T>&) {}
-#ifdef WIN32
-        template<> void Visit(PlayerMapType&);
-#endif
-    };
-
     struct DynamicObjectUpdater
     {
         DynamicObject& i_dynobject;
@@ -1344,9 +1337,6 @@ namespace MaNGOS
     };
 
 #ifndef WIN32
-    template<> void PlayerRelocationNotifier::Visit<Creature>(CreatureMapType&);
-    template<> void CreatureRelocationNotifier::Visit<Player>(PlayerMapType&);
-    template<> void CreatureRelocationNotifier::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Creature>(CreatureMapType&);
     template<> inline void DynamicObjectUpdater::Visit<Player>(PlayerMapType&);
 #endif
@@ -40,7 +40,34 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
-        i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
+        i_camera.GetOwner()->m_clientGUIDs.Mark(iter->getSource()->GetObjectGuid());
+    }
+}
+
+template<class T>
+inline void MaNGOS::VisibleKeepNotifier::Visit(GridRefManager<T>& m)
+{
+    ClientGuidSet& clientGUIDs = i_notifier.i_camera.GetOwner()->m_clientGUIDs;
+    for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        clientGUIDs.Mark(iter->getSource()->GetObjectGuid());
+    }
+}
+
+inline void MaNGOS::VisibleKeepNotifier::Visit(GameObjectMapType& m)
+{
+    ClientGuidSet& clientGUIDs = i_notifier.i_camera.GetOwner()->m_clientGUIDs;
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        GameObject* go = iter->getSource();
+
+        // stealthed traps are seen at a few yards only
+        if (go->GetGoType() == GAMEOBJECT_TYPE_TRAP)
+        {
+            i_notifier.i_camera.UpdateVisibilityOf(go, i_notifier.i_data, i_notifier.i_visibleNow);
+        }
+
+        clientGUIDs.Mark(go->GetObjectGuid());
     }
 }
 
@@ -84,59 +111,6 @@ inline void CreatureCreatureRelocationWorker(Creature* c1, Creature* c2)
     }
 }
 
-inline void MaNGOS::PlayerRelocationNotifier::Visit(CreatureMapType& m)
-{
-    if (!i_player.IsAlive() || i_player.IsTaxiFlying())
-    {
-        return;
-    }
-
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Creature* c = iter->getSource();
-        if (c->IsAlive())
-        {
-            PlayerCreatureRelocationWorker(&i_player, c);
-        }
-    }
-}
-
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(PlayerMapType& m)
-{
-    if (!i_creature.IsAlive())
-    {
-        return;
-    }
-
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Player* player = iter->getSource();
-        if (player->IsAlive() && !player->IsTaxiFlying())
-        {
-            PlayerCreatureRelocationWorker(player, &i_creature);
-        }
-    }
-}
-
-template<>
-inline void MaNGOS::CreatureRelocationNotifier::Visit(CreatureMapType& m)
-{
-    if (!i_creature.IsAlive())
-    {
-        return;
-    }
-
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
-    {
-        Creature* c = iter->getSource();
-        if (c != &i_creature && c->IsAlive())
-        {
-            CreatureCreatureRelocationWorker(c, &i_creature);
-        }
-    }
-}
-
 inline void MaNGOS::DynamicObjectUpdater::VisitHelper(Unit* target)
 {
     if (!target->IsAlive() || target->IsTaxiFlying())
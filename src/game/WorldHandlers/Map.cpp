@@ -24,6 +24,7 @@
 
 #include "Map.h"
 #include "MapManager.h"
+#include "MapRegionUpdater.h"
 #include "Player.h"
 #include "GridNotifiers.h"
 #include "Log.h"
@@ -51,6 +52,9 @@
 #include "ElunaLoader.h"
 #endif /* ENABLE_ELUNA */
 
+/// Players whose update packets one pool task builds with Compression.Parallel
+static const size_t UPDATE_PACKETS_PER_TASK = 16;
+
 Map::~Map()
 {
 #ifdef ENABLE_ELUNA
@@ -124,6 +128,8 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
+      m_regionUpdateEnabled(!InstanceId && sWorld.isRegionUpdateMap(id)), m_regionCollect(false), m_regionUpdateActive(false),
+      m_pathFinderBatch(id),
       i_data(NULL)
 {
 #ifdef ENABLE_ELUNA
@@ -399,6 +405,8 @@ Map::Add(T* obj)
 {
     MANGOS_ASSERT(obj);
 
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -558,6 +566,14 @@ void Map::VisitNearbyCellsOf(WorldObject* obj,
             if (!isCellMarked(cell_id))
             {
                 markCell(cell_id);
+
+                // cells are updated later, grouped by grid
+                if (m_regionCollect)
+                {
+                    m_regionCells.push_back(cell_id);
+                    continue;
+                }
+
                 CellPair pair(x, y);
                 Cell cell(pair);
                 cell.SetNoCreate();
@@ -568,6 +584,98 @@ void Map::VisitNearbyCellsOf(WorldObject* obj,
     }
 }
 
+/**
+ * Region update is possible if an object can not reach from one grid over the next grid into a third one,
+ * so grids of the same parity (see UpdateRegions) never touch the same objects or cells.
+ */
+bool Map::CanUpdateInRegions() const
+{
+    if (!m_regionUpdateEnabled || !sMapMgr.GetRegionUpdater().activated())
+    {
+        return false;
+    }
+
+    return 2 * (GetVisibilityDistance() + SIZE_OF_GRID_CELL) < SIZE_OF_GRIDS;
+}
+
+/**
+ * Update the cells collected by VisitNearbyCellsOf grid by grid. The grids are split into four phases by the
+ * parity of their coordinates, grids in one phase are at least one grid apart and are updated in parallel.
+ * Work which can reach into another grid is deferred by the workers and applied here between the phases.
+ */
+void Map::UpdateRegions(uint32 t_diff)
+{
+    m_regionCollect = false;
+
+    typedef std::map<uint32, MapRegion> RegionMap;
+    RegionMap regions;
+
+    for (std::vector<uint32>::const_iterator itr = m_regionCells.begin(); itr != m_regionCells.end(); ++itr)
+    {
+        uint32 gridX = (*itr % TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+        uint32 gridY = (*itr / TOTAL_NUMBER_OF_CELLS_PER_MAP) / MAX_NUMBER_OF_CELLS;
+
+        MapRegion& region = regions[gridX * MAX_NUMBER_OF_GRIDS + gridY];
+        region.gridX = gridX;
+        region.gridY = gridY;
+        region.cells.push_back(*itr);
+    }
+    m_regionCells.clear();
+
+    for (uint32 phase = 0; phase < 4; ++phase)
+    {
+        MapRegionList phaseRegions;
+        for (RegionMap::iterator itr = regions.begin(); itr != regions.end(); ++itr)
+        {
+            if (((itr->second.gridX & 1) | ((itr->second.gridY & 1) << 1)) == phase)
+            {
+                phaseRegions.push_back(&itr->second);
+            }
+        }
+
+        if (phaseRegions.empty())
+        {
+            continue;
+        }
+
+        // nothing to run in parallel with
+        if (phaseRegions.size() == 1)
+        {
+            MapRegionUpdater::update_region(*this, *phaseRegions.front(), t_diff);
+            continue;
+        }
+
+        m_regionUpdateActive = true;
+        sMapMgr.GetRegionUpdater().update_regions(*this, phaseRegions, t_diff);
+        m_regionUpdateActive = false;
+
+        // merge phase
+        for (MapRegionList::const_iterator itr = phaseRegions.begin(); itr != phaseRegions.end(); ++itr)
+        {
+            MapRegionContext& context = (*itr)->context;
+
+            for (MapRegionContext::RelocationList::const_iterator reloc = context.relocations.begin(); reloc != context.relocations.end(); ++reloc)
+            {
+                Creature* creature = GetAnyTypeCreature(reloc->creatureGuid);
+                if (creature && creature->IsInWorld())
+                {
+                    CreatureRelocation(creature, reloc->x, reloc->y, reloc->z, reloc->o);
+                }
+            }
+
+            for (MapRegionContext::ObjectList::const_iterator obj = context.removeList.begin(); obj != context.removeList.end(); ++obj)
+            {
+                AddObjectToRemoveList(*obj);
+            }
+
+            for (MapRegionContext::CallList::const_iterator call = context.calls.begin(); call != context.calls.end(); ++call)
+            {
+                (*call)();
+            }
+        }
+    }
+}
+
 void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
@@ -606,6 +714,9 @@ void Map::Update(const uint32& t_diff)
     /// update active cells around players and active objects
     resetMarkedCells();
 
+    // with region update the loops below only collect the cells, which are then updated per grid
+    m_regionCollect = CanUpdateInRegions();
+
     MaNGOS::ObjectUpdater updater(t_diff);
     // for creature
     TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
@@ -678,6 +789,17 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    if (m_regionCollect)
+    {
+        UpdateRegions(t_diff);
+    }
+
+    // units which moved, their reactions may request paths below
+    m_relocationNotifyBatch.Process(*this);
+
+    // paths requested by the movement generators above, picked up in their next update
+    m_pathFinderBatch.Solve();
+
     // Send world objects and item update field changes
     SendObjectUpdates();
 
@@ -799,6 +921,7 @@ template<class T>
 void
 Map::Remove(T* obj, bool remove)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -877,6 +1000,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 
         NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
         player->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(), new_cell.CellY()));
+
+        // read the terrain of the grid the player is heading to in the background
+        sMapMgr.GetGridPreloader().predict(m_TerrainData, player);
     }
 
     player->OnRelocated();
@@ -895,6 +1021,16 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
+    // moves into another grid may touch cells of other regions, keep them for the merge phase
+    if (m_regionUpdateActive && creature->GetCurrentCell().DiffGrid(new_cell))
+    {
+        if (MapRegionContext* context = MapRegionUpdater::current_context())
+        {
+            context->relocations.push_back(MapRegionContext::Relocation(creature->GetObjectGuid(), x, y, z, ang));
+            return;
+        }
+    }
+
     // do move or do move to respawn or remove creature if previous all fail
     if (CreatureCellRelocation(creature, new_cell))
     {
@@ -1190,6 +1326,16 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     MANGOS_ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    // cleanups break links to objects in other regions, do them in the merge phase
+    if (m_regionUpdateActive)
+    {
+        if (MapRegionContext* context = MapRegionUpdater::current_context())
+        {
+            context->removeList.push_back(obj);
+            return;
+        }
+    }
+
 #ifdef ENABLE_ELUNA
     if (Eluna* e = GetEluna())
     {
@@ -1335,6 +1481,7 @@ bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 
 void Map::AddToActive(WorldObject* obj)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     m_activeNonPlayers.insert(obj);
     Cell cell = Cell(MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY()));
     EnsureGridLoaded(cell);
@@ -1365,6 +1512,7 @@ void Map::AddToActive(WorldObject* obj)
 
 void Map::RemoveFromActive(WorldObject* obj)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     // Map::Update for active object in proccess
     if (m_activeNonPlayersIter != m_activeNonPlayers.end())
     {
@@ -1925,6 +2073,8 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
 {
     MANGOS_ASSERT(source);
 
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
+
     ///- Find the script chain map
     ScriptChainMap const *scm = sScriptMgr.GetScriptChainMap(type);
     if (!scm)
@@ -1973,6 +2123,7 @@ bool Map::ScriptsStart(DBScriptType type, uint32 id, Object* source, Object* tar
 
 void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* source, Object* target)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     // NOTE: script record _must_ exist until command executed
 
     // prepare static data
@@ -2053,6 +2204,7 @@ Player* Map::GetPlayer(ObjectGuid guid)
  */
 Creature* Map::GetCreature(ObjectGuid guid)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     return m_objectsStore.find<Creature>(guid, (Creature*)NULL);
 }
 
@@ -2063,6 +2215,7 @@ Creature* Map::GetCreature(ObjectGuid guid)
  */
 Pet* Map::GetPet(ObjectGuid guid)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     return m_objectsStore.find<Pet>(guid, (Pet*)NULL);
 }
 
@@ -2103,6 +2256,7 @@ Creature* Map::GetAnyTypeCreature(ObjectGuid guid)
  */
 GameObject* Map::GetGameObject(ObjectGuid guid)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     return m_objectsStore.find<GameObject>(guid, (GameObject*)NULL);
 }
 
@@ -2113,6 +2267,7 @@ GameObject* Map::GetGameObject(ObjectGuid guid)
  */
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     return m_objectsStore.find<DynamicObject>(guid, (DynamicObject*)NULL);
 }
 
@@ -2171,6 +2326,49 @@ void Map::SendObjectUpdates()
         obj->BuildUpdateData(update_players);
     }
 
+    MapRegionUpdater& pool = sMapMgr.GetRegionUpdater();
+
+    // compress the packets of crowded maps in parallel, sending stays in this thread
+    if (sWorld.getConfig(CONFIG_BOOL_PARALLEL_COMPRESSION) && pool.activated() && update_players.size() > UPDATE_PACKETS_PER_TASK)
+    {
+        typedef std::vector<std::pair<Player*, UpdateData*> > UpdateList;
+
+        UpdateList updates;
+        updates.reserve(update_players.size());
+        for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+        {
+            updates.push_back(std::make_pair(iter->first, &iter->second));
+        }
+
+        std::vector<WorldPacket> packets(updates.size());
+        std::vector<uint8> built(updates.size());
+
+        MapRegionUpdater::TaskList tasks;
+        for (size_t begin = 0; begin < updates.size(); begin += UPDATE_PACKETS_PER_TASK)
+        {
+            size_t end = std::min(begin + UPDATE_PACKETS_PER_TASK, updates.size());
+            tasks.push_back([&updates, &packets, &built, begin, end]()
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    built[i] = updates[i].second->BuildPacket(&packets[i]);
+                }
+            });
+        }
+
+        pool.run_tasks(tasks);
+
+        for (size_t i = 0; i < updates.size(); ++i)
+        {
+            if (built[i])
+            {
+                updates[i].first->GetSession()->SendPacket(&packets[i]);
+            }
+        }
+
+        return;
+    }
+
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
@@ -2182,6 +2380,9 @@ void Map::SendObjectUpdates()
 
 uint32 Map::GenerateLocalLowGuid(HighGuid guidhigh)
 {
+    // summons and dynamic objects are created by region workers in parallel
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
+
     // TODO: for map local guid counters possible force reload map instead shutdown server at guid counter overflow
     switch (guidhigh)
     {
@@ -2308,10 +2509,28 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
+    return m_TerrainData->IsInLineOfSightStatic(srcX, srcY, srcZ, destX, destY, destZ)
            && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ);
 }
 
+/**
+ * Function to check several lines of sight at once, the static geometry is traced in ray packets
+ */
+void Map::IsInLineOfSight(G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) const
+{
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
+    m_TerrainData->IsInLineOfSightStatic(from, to, results, count);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (results[i])
+        {
+            results[i] = m_dyn_tree.isInLineOfSight(from[i].x, from[i].y, from[i].z, to[i].x, to[i].y, to[i].z);
+        }
+    }
+}
+
 /**
  * get the hit position and return true if we hit something (in this case the dest position will hold the hit-position)
  * otherwise the result pos will be the dest pos
@@ -2329,6 +2548,7 @@ bool Map::GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float
         destZ = tempZ;
     }
     // at second all dynamic objects, if static check has an hit, then we can calculate only to this closer point
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     bool result1 = m_dyn_tree.getObjectHitPos(srcX, srcY, srcZ, destX, destY, destZ, tempX, tempY, tempZ, modifyDist);
     if (result1)
     {
@@ -2402,12 +2622,14 @@ bool Map::GetHeightInRange(float x, float y, float& z, float maxSearchDist /*= 4
         }
     }
 
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     z = std::max<float>(height, m_dyn_tree.getHeight(x, y, height + 1.0f, maxSearchDist));
     return true;
 }
 
 float Map::GetHeight(float x, float y, float z) const
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     float staticHeight = m_TerrainData->GetHeightStatic(x, y, z);
 
     // Get Dynamic Height around static Height (if valid)
@@ -2417,16 +2639,19 @@ float Map::GetHeight(float x, float y, float z) const
 
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     m_dyn_tree.insert(mdl);
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     m_dyn_tree.remove(mdl);
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
 {
+    MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
     return m_dyn_tree.contains(mdl);
 }
 
@@ -30,6 +30,7 @@
 #include "Policies/ThreadingModel.h"
 #include <ace/RW_Thread_Mutex.h>
 #include <ace/Thread_Mutex.h>
+#include <ace/Recursive_Thread_Mutex.h>
 
 #include "DBCStructure.h"
 #include "GridDefines.h"
@@ -42,6 +43,8 @@
 #include "ScriptMgr.h"
 #include "CreatureLinkingMgr.h"
 #include "DynamicTree.h"
+#include "PathFinderBatch.h"
+#include "RelocationNotifyBatch.h"
 #ifdef ENABLE_ELUNA
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
@@ -70,6 +73,32 @@ class Transport;
 
 namespace MaNGOS { struct ObjectUpdater; }
 
+/**
+ * @brief Locks the map while its regions are updated by several threads, does nothing otherwise.
+ */
+class MapRegionGuard
+{
+    public:
+        MapRegionGuard(ACE_Recursive_Thread_Mutex& lock, bool active) : m_lock(active ? &lock : NULL)
+        {
+            if (m_lock)
+            {
+                m_lock->acquire();
+            }
+        }
+
+        ~MapRegionGuard()
+        {
+            if (m_lock)
+            {
+                m_lock->release();
+            }
+        }
+
+    private:
+        ACE_Recursive_Thread_Mutex* m_lock;
+};
+
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
 #pragma pack(1)
@@ -150,6 +179,17 @@ class Map : public GridRefManager<NGridType>
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
+        // position index of a cell, NULL if its grid is not loaded (never loads it)
+        CellPositionIndex const* GetPositionIndex(const Cell& cell) const
+        {
+            if (!loaded(cell.gridPair()))
+            {
+                return NULL;
+            }
+
+            return &(*getNGrid(cell.GridX(), cell.GridY()))(cell.CellX(), cell.CellY()).GetPositionIndex();
+        }
+
         bool IsRemovalGrid(float x, float y) const
         {
             GridPair p = MaNGOS::ComputeGridPair(x, y);
@@ -249,17 +289,28 @@ class Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
+            MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
             i_objectsToClientUpdate.insert(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
+            MapRegionGuard guard(m_regionLock, m_regionUpdateActive);
             i_objectsToClientUpdate.erase(obj);
         }
 
+        // true while grid regions of this map are updated by several threads (MapUpdateRegionMaps)
+        bool IsRegionUpdateActive() const { return m_regionUpdateActive; }
+
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
 
+        // path requests queued with PathFinder::calculateBatched
+        PathFinderBatch& GetPathFinderBatch() { return m_pathFinderBatch; }
+
+        // units queued with Unit::ScheduleAINotify
+        RelocationNotifyBatch& GetRelocationNotifyBatch() { return m_relocationNotifyBatch; }
+
         // get corresponding TerrainData object for this particular map
         const TerrainInfo* GetTerrain() const { return m_TerrainData; }
 
@@ -275,6 +326,8 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2) const;
+        // checks several lines at once, e.g. from the targets of an area spell to its caster
+        void IsInLineOfSight(G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
@@ -342,6 +395,9 @@ class Map : public GridRefManager<NGridType>
                                 TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor,
                                 TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
 
+        bool CanUpdateInRegions() const;
+        void UpdateRegions(uint32 t_diff);
+
         bool isGridObjectDataLoaded(uint32 x, uint32 y) const { return getNGrid(x, y)->isGridObjectDataLoaded(); }
         void setGridObjectDataLoaded(bool pLoaded, uint32 x, uint32 y) { getNGrid(x, y)->setGridObjectDataLoaded(pLoaded); }
 
@@ -378,6 +434,19 @@ class Map : public GridRefManager<NGridType>
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
+        // parallel grid region update, see MapRegionUpdater
+        bool m_regionUpdateEnabled;
+        bool m_regionCollect;                               // VisitNearbyCellsOf only collects cells into m_regionCells
+        bool m_regionUpdateActive;                          // region workers are running, map wide containers need m_regionLock
+        std::vector<uint32> m_regionCells;
+        mutable ACE_Recursive_Thread_Mutex m_regionLock;
+
+        // paths of chasing and following units, built at the end of the update
+        PathFinderBatch m_pathFinderBatch;
+
+        // MoveInLineOfSight checks of moved units, run at the end of the update
+        RelocationNotifyBatch m_relocationNotifyBatch;
+
         std::set<WorldObject*> i_objectsToRemove;
         std::set<Transport*> i_transports;
 
@@ -82,6 +82,30 @@ MapManager::Initialize()
         abort();
     }
 
+    // Start grid region workers for the maps listed in MapUpdateRegionMaps
+    int region_threads(sWorld.getConfig(CONFIG_UINT32_REGION_UPDATE_THREADS));
+
+#ifdef ENABLE_ELUNA
+    if (sElunaConfig->IsElunaEnabled() && region_threads > 0)
+    {
+        // Lua states are per map, they can not be entered from several region workers at once
+        sLog.outError("Map region update threads set to %i, not supported with Eluna enabled, changing to 0", region_threads);
+        region_threads = 0;
+    }
+#endif /* ENABLE_ELUNA */
+
+    if (region_threads > 0 && m_regionUpdater.activate(region_threads) == -1)
+    {
+        abort();
+    }
+
+    // Start terrain preloading for moving players
+    int preload_threads(sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS));
+    if (preload_threads > 0 && m_gridPreloader.activate(preload_threads, sWorld.getConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD)) == -1)
+    {
+        abort();
+    }
+
     InitStateMachine();
     InitMaxInstanceId();
 }
@@ -224,13 +248,32 @@ void MapManager::Update(uint32 diff)
         }
         else
         {
-            iter->second->Update((uint32)i_timer.GetCurrent());
+            m_updater.update_now(*iter->second, (uint32)i_timer.GetCurrent());
         }
     }
 
-    if (m_updater.activated())
+    m_updater.wait();
+
+    if (m_updater.GetLastTickTime() > i_timer.GetInterval() * IN_MILLISECONDS)
     {
-        m_updater.wait();
+        // report the map which held the tick back, the stats of maps not updated in it are old
+        MapUpdateStatList stats;
+        m_updater.GetUpdateStats(stats);
+        uint32 tick = m_updater.GetLastTick();
+        MapUpdateStatList::const_iterator slowest = stats.end();
+        for (MapUpdateStatList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+        {
+            if (itr->lastSeenTick == tick && (slowest == stats.end() || itr->lastTime > slowest->lastTime))
+            {
+                slowest = itr;
+            }
+        }
+
+        if (slowest != stats.end())
+        {
+            DETAIL_LOG("MapManager: map update took %u ms, slowest map %u (instance %u) with %u ms",
+                       m_updater.GetLastTickTime() / IN_MILLISECONDS, slowest->mapId, slowest->instanceId, slowest->lastTime / IN_MILLISECONDS);
+        }
     }
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
@@ -288,6 +331,12 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    // preloader threads hold terrain references
+    if (m_gridPreloader.activated())
+    {
+        m_gridPreloader.deactivate();
+    }
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
     {
         iter->second->UnloadAll(true);
@@ -305,6 +354,11 @@ void MapManager::UnloadAll()
     {
         m_updater.deactivate();
     }
+
+    if (m_regionUpdater.activated())
+    {
+        m_regionUpdater.deactivate();
+    }
 }
 
 void MapManager::InitMaxInstanceId()
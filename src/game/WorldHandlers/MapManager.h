@@ -32,6 +32,8 @@
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
+#include "MapRegionUpdater.h"
+#include "GridPreloader.h"
 
 class Transport;
 class BattleGround;
@@ -156,6 +158,12 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         /* statistics */
         uint32 GetNumInstances();
         uint32 GetNumPlayersInInstances();
+        void GetMapUpdateStats(MapUpdateStatList& stats) { m_updater.GetUpdateStats(stats); }
+        uint32 GetLastMapUpdateTime() const { return m_updater.GetLastTickTime(); }
+        uint32 GetStolenMapUpdates() const { return m_updater.GetStolenCount(); }
+
+        MapRegionUpdater& GetRegionUpdater() { return m_regionUpdater; }
+        GridPreloader& GetGridPreloader() { return m_gridPreloader; }
 
 
         // get list of all maps
@@ -199,6 +207,8 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         MapMapType i_maps;
         IntervalTimer i_timer;
         MapUpdater m_updater;
+        MapRegionUpdater m_regionUpdater;
+        GridPreloader m_gridPreloader;
         uint32 i_MaxInstanceId;
 
         typedef ACE_Recursive_Thread_Mutex LOCK_TYPE;
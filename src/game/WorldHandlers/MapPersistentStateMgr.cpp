@@ -131,34 +131,45 @@ void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
 {
-    if (t > sWorld.GetGameTime())
-    {
-        m_creatureRespawnTimes[loguid] = t;
-    }
-    else
     {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_respawnLock);
+        if (t > sWorld.GetGameTime())
+        {
+            m_creatureRespawnTimes[loguid] = t;
+            return;
+        }
+
         m_creatureRespawnTimes.erase(loguid);
-        UnloadIfEmpty();
     }
+
+    // outside of the lock, the state may be deleted
+    UnloadIfEmpty();
 }
 
 void MapPersistentState::SetGORespawnTime(uint32 loguid, time_t t)
 {
-    if (t > sWorld.GetGameTime())
-    {
-        m_goRespawnTimes[loguid] = t;
-    }
-    else
     {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_respawnLock);
+        if (t > sWorld.GetGameTime())
+        {
+            m_goRespawnTimes[loguid] = t;
+            return;
+        }
+
         m_goRespawnTimes.erase(loguid);
-        UnloadIfEmpty();
     }
+
+    // outside of the lock, the state may be deleted
+    UnloadIfEmpty();
 }
 
 void MapPersistentState::ClearRespawnTimes()
 {
-    m_goRespawnTimes.clear();
-    m_creatureRespawnTimes.clear();
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_respawnLock);
+        m_goRespawnTimes.clear();
+        m_creatureRespawnTimes.clear();
+    }
 
     UnloadIfEmpty();
 }
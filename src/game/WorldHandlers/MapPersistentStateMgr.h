@@ -92,12 +92,14 @@ class MapPersistentState
 
         time_t GetCreatureRespawnTime(uint32 loguid) const
         {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_respawnLock, 0);
             RespawnTimes::const_iterator itr = m_creatureRespawnTimes.find(loguid);
             return itr != m_creatureRespawnTimes.end() ? itr->second : 0;
         }
         void SaveCreatureRespawnTime(uint32 loguid, time_t t);
         time_t GetGORespawnTime(uint32 loguid) const
         {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_respawnLock, 0);
             RespawnTimes::const_iterator itr = m_goRespawnTimes.find(loguid);
             return itr != m_goRespawnTimes.end() ? itr->second : 0;
         }
@@ -121,7 +123,11 @@ class MapPersistentState
 
         bool UnloadIfEmpty();
         void ClearRespawnTimes();
-        bool HasRespawnTimes() const { return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty(); }
+        bool HasRespawnTimes() const
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_respawnLock, true);
+            return !m_creatureRespawnTimes.empty() || !m_goRespawnTimes.empty();
+        }
 
     private:
         void SetCreatureRespawnTime(uint32 loguid, time_t t);
@@ -137,6 +143,7 @@ class MapPersistentState
         // persistent data
         RespawnTimes m_creatureRespawnTimes;                // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
         RespawnTimes m_goRespawnTimes;                      // lock MapPersistentState from unload, for example for temporary bound dungeon unload delay
+        mutable ACE_Thread_Mutex m_respawnLock;             // guards the respawn times, grid regions of the map save them in parallel
         MapCellObjectGuidsMap m_gridObjectGuids;            // Single map copy specific grid spawn data, like pool spawns
 };
 
@@ -245,30 +245,36 @@ namespace MMAP
         char* fileName = new char[pathLen];
         snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
 
-        FILE* file = fopen(fileName, "rb");
-        if (!file)
+        // the tile is used in place: detour only writes its link data, which the private
+        // mapping copies page by page, everything else stays shared in the page cache
+        ACE_Mem_Map* file = new ACE_Mem_Map();
+        if (file->map(fileName, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, MAP_PRIVATE) == -1)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
             delete[] fileName;
+            delete file;
             return false;
         }
         delete[] fileName;
 
+        // the mapping stays valid without the descriptor, don't hold one per loaded tile
+        file->close_handle();
+
         // read header
         MmapTileHeader fileHeader;
-        size_t file_read = fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
-
-        if (file_read <= 0)
+        if (file->size() < sizeof(MmapTileHeader))
         {
             sLog.outError("MMAP:loadMap: Could not load mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete file;
             return false;
         }
 
+        memcpy(&fileHeader, file->addr(), sizeof(MmapTileHeader));
+
         if (fileHeader.mmapMagic != MMAP_MAGIC)
         {
             sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete file;
             return false;
         }
 
@@ -276,35 +282,32 @@ namespace MMAP
         {
             sLog.outError("MMAP:loadMap: %03u%02i%02i.mmtile was built with generator v%i, expected v%i",
                           mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
-            fclose(file);
+            delete file;
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        MANGOS_ASSERT(data);
-
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        if (file->size() - sizeof(MmapTileHeader) < fileHeader.size)
         {
             sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
-            fclose(file);
+            delete file;
             return false;
         }
 
-        fclose(file);
+        unsigned char* data = static_cast<unsigned char*>(file->addr()) + sizeof(MmapTileHeader);
 
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        // the data is not owned by detour, the mapping is released when the tile is removed
+        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, 0, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
             sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
+            delete file;
             return false;
         }
 
+        mmap->mmapTileFiles[packedGridPos] = file;
         mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
         ++loadedTiles;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
@@ -334,6 +337,9 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
 
+        // cached corridors through this tile would point to freed polygons
+        pathCache.InvalidateTile(mapId, mmap->navMesh, tileRef);
+
         // unload, and mark as non loaded
         dtStatus dtResult = mmap->navMesh->removeTile(tileRef, NULL, NULL);
         if (dtStatusFailed(dtResult))
@@ -347,6 +353,7 @@ namespace MMAP
         else
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            mmap->ReleaseTileFile(packedGridPos);
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -382,6 +389,8 @@ namespace MMAP
             }
         }
 
+        pathCache.InvalidateMap(mapId);
+
         delete mmap;
         loadedMMaps.erase(mapId);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
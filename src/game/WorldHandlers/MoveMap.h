@@ -31,6 +31,9 @@
 
 #include "Platform/Define.h"
 #include "Utilities/UnorderedMapSet.h"
+#include "PathCache.h"
+
+#include <ace/Mem_Map.h>
 
 class Unit;
 
@@ -50,6 +53,7 @@ namespace MMAP
 {
     typedef UNORDERED_MAP<uint32, dtTileRef> MMapTileSet;
     typedef UNORDERED_MAP<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef UNORDERED_MAP<uint32, ACE_Mem_Map*> MMapTileFileSet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
@@ -66,6 +70,23 @@ namespace MMAP
             {
                 dtFreeNavMesh(navMesh);
             }
+
+            // tile data lives in the mapped files, release them after the mesh
+            for (MMapTileFileSet::iterator i = mmapTileFiles.begin(); i != mmapTileFiles.end(); ++i)
+            {
+                delete i->second;
+            }
+        }
+
+        // unmap the file of a tile removed from the mesh
+        void ReleaseTileFile(uint32 packedGridPos)
+        {
+            MMapTileFileSet::iterator i = mmapTileFiles.find(packedGridPos);
+            if (i != mmapTileFiles.end())
+            {
+                delete i->second;
+                mmapTileFiles.erase(i);
+            }
         }
 
         dtNavMesh* navMesh;
@@ -73,6 +94,7 @@ namespace MMAP
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileFileSet mmapTileFiles;      // maps [map grid coords] to the mapped .mmtile the tile data points into
     };
 
 
@@ -97,12 +119,16 @@ namespace MMAP
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+
+            // corridors found by PathFinder, shared by all instances of a map
+            PathCache& GetPathCache() { return pathCache; }
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            PathCache pathCache;
     };
 
     // static class
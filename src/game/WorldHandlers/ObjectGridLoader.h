@@ -33,7 +33,7 @@
 
 class ObjectWorldLoader;
 
-using GridLoaderType = GridLoader<Player, WorldTypeMapContainer, GridTypeMapContainer>;
+using GridLoaderType = GridLoader<Player, WorldTypeMapContainer, GridTypeMapContainer, CellPositionIndex>;
 
 class ObjectGridLoader
 {
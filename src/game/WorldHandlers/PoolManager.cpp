@@ -28,6 +28,7 @@
 #include "ProgressBar.h"
 #include "Log.h"
 #include "MapPersistentStateMgr.h"
+#include "MapRegionUpdater.h"
 #include "World.h"
 #include "Policies/Singleton.h"
 
@@ -1304,6 +1305,14 @@ void PoolManager::SetExcludeObject<GameObject>(uint16 pool_id, uint32 db_guid_or
 template<typename T>
 void PoolManager::UpdatePool(MapPersistentState& mapState, uint16 pool_id, uint32 db_guid_or_pool_id)
 {
+    // the next spawn may be in another grid, a region worker leaves the update to the merge
+    if (MapRegionContext* context = MapRegionUpdater::current_context())
+    {
+        MapPersistentState* state = &mapState;
+        context->calls.push_back([this, state, pool_id, db_guid_or_pool_id]() { UpdatePool<T>(*state, pool_id, db_guid_or_pool_id); });
+        return;
+    }
+
     if (uint16 motherpoolid = IsPartOfAPool<Pool>(pool_id))
     {
         SpawnPoolGroup<Pool>(mapState, motherpoolid, pool_id, false);
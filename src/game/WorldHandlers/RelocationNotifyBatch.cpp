@@ -0,0 +1,348 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "RelocationNotifyBatch.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "CellImpl.h"
+#include "Map.h"
+#include "Creature.h"
+#include "Player.h"
+#include "World.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+namespace
+{
+    /**
+     * @brief Collects the living players and creatures of a cell.
+     */
+    struct RelocationCellCollector
+    {
+        std::vector<Player*>& i_players;
+        std::vector<Creature*>& i_creatures;
+
+        RelocationCellCollector(std::vector<Player*>& players, std::vector<Creature*>& creatures) : i_players(players), i_creatures(creatures) {}
+
+        template<class T> void Visit(GridRefManager<T>&) {}
+
+        void Visit(PlayerMapType& m)
+        {
+            for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+            {
+                i_players.push_back(iter->getSource());
+            }
+        }
+
+        void Visit(CreatureMapType& m)
+        {
+            for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+            {
+                i_creatures.push_back(iter->getSource());
+            }
+        }
+    };
+
+    bool CanNotify(Player* player)
+    {
+        return player->IsAlive() && !player->IsTaxiFlying();
+    }
+
+    bool CanNotify(Creature* creature)
+    {
+        return creature->IsAlive();
+    }
+}
+
+/**
+ * @brief Constructor for RelocationNotifyBatch.
+ */
+RelocationNotifyBatch::RelocationNotifyBatch()
+{
+}
+
+/**
+ * @brief Queues a unit, may be called from region workers.
+ * @param unit Unit which moved, its notification is due.
+ */
+void RelocationNotifyBatch::Add(Unit* unit)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    m_queued.push_back(unit->GetObjectGuid());
+}
+
+/**
+ * @brief Runs the notifications of all queued units.
+ *
+ * Called by the map thread once all objects are updated. Units moved by
+ * the checks are scheduled again, as they would be at any other time.
+ * @param map Map the units are on.
+ */
+void RelocationNotifyBatch::Process(Map& map)
+{
+    m_due.clear();
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+        m_due.swap(m_queued);
+    }
+
+    if (m_due.empty())
+    {
+        return;
+    }
+
+    float aggroRadius = MAX_CREATURE_ATTACK_RADIUS * sWorld.getConfig(CONFIG_FLOAT_RATE_CREATURE_AGGRO);
+
+    m_moved.clear();
+    for (std::vector<ObjectGuid>::const_iterator itr = m_due.begin(); itr != m_due.end(); ++itr)
+    {
+        // a unit queued, removed from the map and queued again is notified once
+        Unit* unit = map.GetUnit(*itr);
+        if (!unit || !unit->IsInWorld() || !unit->IsAINotifyQueued())
+        {
+            continue;
+        }
+
+        unit->_SetAINotifyScheduled(false);
+
+        if (unit->GetTypeId() == TYPEID_PLAYER ? !CanNotify((Player*)unit) : !CanNotify((Creature*)unit))
+        {
+            continue;
+        }
+
+        Moved moved;
+        moved.unit = unit;
+        moved.x = unit->GetPositionX();
+        moved.y = unit->GetPositionY();
+        moved.radius = std::min(aggroRadius + unit->GetObjectBoundingRadius(), 333.0f); // same limit as Cell::Visit
+        moved.cell = MaNGOS::ComputeCellPair(moved.x, moved.y);
+
+        if (moved.cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || moved.cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        {
+            continue;
+        }
+
+        m_moved.push_back(moved);
+        unit->_SetRelocationNotifyIndex(uint32(m_moved.size()));
+    }
+
+    RelocationNotifyStats stats;
+    stats.units = m_moved.size();
+
+    // every cell within the radius of a unit, listed once per unit
+    m_cellUnits.clear();
+    for (uint32 index = 0; index < m_moved.size(); ++index)
+    {
+        Moved const& moved = m_moved[index];
+        CellArea area = Cell::CalculateCellArea(moved.x, moved.y, moved.radius);
+
+        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            {
+                if (Reaches(moved, x, y))
+                {
+                    m_cellUnits.push_back(CellUnit(y * TOTAL_NUMBER_OF_CELLS_PER_MAP + x, index));
+                }
+            }
+        }
+    }
+
+    stats.cellVisits = m_cellUnits.size();
+    std::sort(m_cellUnits.begin(), m_cellUnits.end());
+
+    RelocationCellCollector collector(m_cellPlayers, m_cellCreatures);
+    TypeContainerVisitor<RelocationCellCollector, GridTypeMapContainer > gridVisitor(collector);
+    TypeContainerVisitor<RelocationCellCollector, WorldTypeMapContainer > worldVisitor(collector);
+
+    for (std::vector<CellUnit>::const_iterator begin = m_cellUnits.begin(); begin != m_cellUnits.end();)
+    {
+        std::vector<CellUnit>::const_iterator end = begin;
+        while (end != m_cellUnits.end() && end->first == begin->first)
+        {
+            ++end;
+        }
+
+        Cell cell(CellPair(begin->first % TOTAL_NUMBER_OF_CELLS_PER_MAP, begin->first / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        cell.SetNoCreate();
+
+        m_cellPlayers.clear();
+        m_cellCreatures.clear();
+        map.Visit(cell, gridVisitor);
+        map.Visit(cell, worldVisitor);
+        ++stats.cellsScanned;
+
+        for (; begin != end; ++begin)
+        {
+            Unit* unit = m_moved[begin->second].unit;
+            if (unit->GetTypeId() == TYPEID_PLAYER)
+            {
+                stats.pairsSkipped += NotifyPlayer(begin->second, (Player*)unit);
+            }
+            else
+            {
+                stats.pairsSkipped += NotifyCreature(begin->second, (Creature*)unit);
+            }
+        }
+    }
+
+    for (std::vector<Moved>::const_iterator itr = m_moved.begin(); itr != m_moved.end(); ++itr)
+    {
+        itr->unit->_SetRelocationNotifyIndex(0);
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "RelocationNotifyBatch: map %u, " UI64FMTD " units, " UI64FMTD " cells scanned instead of " UI64FMTD ", " UI64FMTD " pairs checked once",
+                     map.GetId(), stats.units, stats.cellsScanned, stats.cellVisits, stats.pairsSkipped);
+
+    m_lastStats = stats;
+    m_totalStats.units += stats.units;
+    m_totalStats.cellVisits += stats.cellVisits;
+    m_totalStats.cellsScanned += stats.cellsScanned;
+    m_totalStats.pairsSkipped += stats.pairsSkipped;
+}
+
+/**
+ * @brief Tells if a cell is within the radius of a moved unit.
+ * @param moved Moved unit.
+ * @param cellX Cell coordinates, as computed by MaNGOS::ComputeCellPair.
+ * @param cellY
+ * @return True if the closest point of the cell is within the radius.
+ */
+bool RelocationNotifyBatch::Reaches(Moved const& moved, uint32 cellX, uint32 cellY)
+{
+    // cell i covers [(i - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL, (i - CENTER_GRID_CELL_ID + 1) * SIZE_OF_GRID_CELL)
+    float lowX = (int32(cellX) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float lowY = (int32(cellY) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float dx = std::max(std::max(lowX - moved.x, moved.x - (lowX + SIZE_OF_GRID_CELL)), 0.0f);
+    float dy = std::max(std::max(lowY - moved.y, moved.y - (lowY + SIZE_OF_GRID_CELL)), 0.0f);
+    return dx * dx + dy * dy <= moved.radius * moved.radius;
+}
+
+/**
+ * @brief Tells if the pair of a moved unit and another unit is checked by the other one.
+ *
+ * When both units moved, the one queued first checks the pair, provided
+ * the cell of the other is within its radius.
+ * @param index Index of the moved unit in m_moved.
+ * @param other Unit found in a cell within its radius.
+ */
+bool RelocationNotifyBatch::IsCheckedByOther(uint32 index, Unit* other) const
+{
+    uint32 otherIndex = other->GetRelocationNotifyIndex();
+    if (!otherIndex || otherIndex - 1 >= index)
+    {
+        return false;
+    }
+
+    CellPair const& cell = m_moved[index].cell;
+    return Reaches(m_moved[otherIndex - 1], cell.x_coord, cell.y_coord);
+}
+
+/**
+ * @brief Runs the checks of a moved player against the creatures of the scanned cell.
+ * @param index Index of the player in m_moved.
+ * @param player
+ * @return Number of pairs left to the other unit.
+ */
+uint32 RelocationNotifyBatch::NotifyPlayer(uint32 index, Player* player)
+{
+    // the state may have changed by the checks of other units
+    if (!CanNotify(player))
+    {
+        return 0;
+    }
+
+    uint32 skipped = 0;
+    for (std::vector<Creature*>::const_iterator itr = m_cellCreatures.begin(); itr != m_cellCreatures.end(); ++itr)
+    {
+        Creature* c = *itr;
+        if (!c->IsAlive())
+        {
+            continue;
+        }
+
+        if (IsCheckedByOther(index, c))
+        {
+            ++skipped;
+            continue;
+        }
+
+        PlayerCreatureRelocationWorker(player, c);
+    }
+
+    return skipped;
+}
+
+/**
+ * @brief Runs the checks of a moved creature against the players and creatures of the scanned cell.
+ * @param index Index of the creature in m_moved.
+ * @param creature
+ * @return Number of pairs left to the other unit.
+ */
+uint32 RelocationNotifyBatch::NotifyCreature(uint32 index, Creature* creature)
+{
+    if (!CanNotify(creature))
+    {
+        return 0;
+    }
+
+    uint32 skipped = 0;
+    for (std::vector<Player*>::const_iterator itr = m_cellPlayers.begin(); itr != m_cellPlayers.end(); ++itr)
+    {
+        Player* player = *itr;
+        if (!CanNotify(player))
+        {
+            continue;
+        }
+
+        if (IsCheckedByOther(index, player))
+        {
+            ++skipped;
+            continue;
+        }
+
+        PlayerCreatureRelocationWorker(player, creature);
+    }
+
+    for (std::vector<Creature*>::const_iterator itr = m_cellCreatures.begin(); itr != m_cellCreatures.end(); ++itr)
+    {
+        Creature* c = *itr;
+        if (c == creature || !c->IsAlive())
+        {
+            continue;
+        }
+
+        if (IsCheckedByOther(index, c))
+        {
+            ++skipped;
+            continue;
+        }
+
+        CreatureCreatureRelocationWorker(c, creature);
+    }
+
+    return skipped;
+}
@@ -0,0 +1,139 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_RELOCATION_NOTIFY_BATCH_H
+#define MANGOS_RELOCATION_NOTIFY_BATCH_H
+
+#include <ace/Thread_Mutex.h>
+
+#include "Common.h"
+#include "GridDefines.h"
+#include "ObjectGuid.h"
+
+#include <utility>
+#include <vector>
+
+class Map;
+class Unit;
+class Player;
+class Creature;
+
+/**
+ * @brief Counters of the relocation notifications of a map.
+ */
+struct RelocationNotifyStats
+{
+    RelocationNotifyStats() : units(0), cellVisits(0), cellsScanned(0), pairsSkipped(0) {}
+
+    uint64 units;           ///< Units whose notification ran.
+    uint64 cellVisits;      ///< Cell scans the units would have done one by one.
+    uint64 cellsScanned;    ///< Cells actually scanned.
+    uint64 pairsSkipped;    ///< Pairs of moved units which were only checked once.
+};
+
+/**
+ * @brief Relocation notifications of one map, resolved together at the end of the map update.
+ *
+ * Once the notify delay set by Unit::ScheduleAINotify ran out, the unit
+ * queues itself here instead of scanning the cells around it. Once all
+ * objects of the map are updated, Process() collects the cells within the
+ * aggro radius of any queued unit and scans each cell only once, running
+ * the MoveInLineOfSight checks of all units interested in it. A pair of
+ * units which both moved is checked by one of them only.
+ */
+class RelocationNotifyBatch
+{
+    public:
+        /**
+         * @brief Constructor for RelocationNotifyBatch.
+         */
+        RelocationNotifyBatch();
+
+        /**
+         * @brief Queues a unit, may be called from region workers.
+         * @param unit Unit which moved, its notification is due.
+         */
+        void Add(Unit* unit);
+
+        /**
+         * @brief Runs the notifications of all queued units.
+         * @param map Map the units are on.
+         */
+        void Process(Map& map);
+
+        /**
+         * @brief Counters of the last Process() call which ran notifications.
+         */
+        RelocationNotifyStats const& GetLastStats() const { return m_lastStats; }
+
+        /**
+         * @brief Counters summed over all Process() calls.
+         */
+        RelocationNotifyStats const& GetTotalStats() const { return m_totalStats; }
+
+    private:
+        RelocationNotifyBatch(RelocationNotifyBatch const&);
+        RelocationNotifyBatch& operator=(RelocationNotifyBatch const&);
+
+        /**
+         * @brief A unit notified by the current Process() call.
+         */
+        struct Moved
+        {
+            Unit* unit;
+            float x, y;
+            float radius;       ///< Aggro radius plus the bounding radius of the unit.
+            CellPair cell;      ///< Cell the unit stands in.
+        };
+
+        typedef std::pair<uint32, uint32> CellUnit; ///< Cell id and index in m_moved.
+
+        /**
+         * @brief Tells if a cell is within the radius of a moved unit.
+         */
+        static bool Reaches(Moved const& moved, uint32 cellX, uint32 cellY);
+
+        /**
+         * @brief Tells if the pair of the unit at index and another unit is checked by the other one.
+         */
+        bool IsCheckedByOther(uint32 index, Unit* other) const;
+
+        uint32 NotifyPlayer(uint32 index, Player* player);
+        uint32 NotifyCreature(uint32 index, Creature* creature);
+
+        ACE_Thread_Mutex m_lock;                ///< Protects m_queued.
+        std::vector<ObjectGuid> m_queued;       ///< The units may leave the map before Process().
+
+        // buffers of Process(), kept to reuse their memory
+        std::vector<ObjectGuid> m_due;
+        std::vector<Moved> m_moved;
+        std::vector<CellUnit> m_cellUnits;
+        std::vector<Player*> m_cellPlayers;
+        std::vector<Creature*> m_cellCreatures;
+
+        RelocationNotifyStats m_lastStats;
+        RelocationNotifyStats m_totalStats;
+};
+
+#endif // MANGOS_RELOCATION_NOTIFY_BATCH_H
@@ -54,6 +54,10 @@
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
 
+#include <G3D/Vector3.h>
+
+#include <memory>
+
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
 bool IsQuestTameSpell(uint32 spellId)
@@ -705,9 +709,12 @@ void Spell::FillTargetMap()
             }
         }
 
+        // line of sight of area targets is checked in one pass
+        bool losChecked = CheckTargetsLOS(tmpUnitLists[effToIndex[i]], SpellEffectIndex(i));
+
         for (UnitList::iterator itr = tmpUnitLists[effToIndex[i]].begin(); itr != tmpUnitLists[effToIndex[i]].end();)
         {
-            if (!CheckTarget(*itr, SpellEffectIndex(i)))
+            if (!CheckTarget(*itr, SpellEffectIndex(i), !losChecked))
             {
                 itr = tmpUnitLists[effToIndex[i]].erase(itr);
                 continue;
@@ -7541,7 +7548,7 @@ CurrentSpellTypes Spell::GetCurrentContainer()
     }
 }
 
-bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
+bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff, bool checkLOS)
 {
     // Check targets for creature type mask and remove not appropriate (skip explicit self target case, maybe need other explicit targets)
     if (m_spellInfo->EffectImplicitTargetA[eff] != TARGET_SELF)
@@ -7594,7 +7601,7 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
     }
 
     // Check targets for LOS visibility (except spells without range limitations )
-    if (!DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, NULL, SPELL_DISABLE_LOS))
+    if (checkLOS && !DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, NULL, SPELL_DISABLE_LOS))
     {
         switch (m_spellInfo->Effect[eff])
         {
@@ -7661,6 +7668,86 @@ bool Spell::CheckTarget(Unit* target, SpellEffectIndex eff)
     return true;
 }
 
+// Removes the targets not in line of sight of the casting object, like CheckTarget does for the normal case
+// but tracing all lines together. Returns false if the check is left to CheckTarget.
+bool Spell::CheckTargetsLOS(UnitList& targets, SpellEffectIndex eff)
+{
+    if (targets.size() < 2 || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, NULL, SPELL_DISABLE_LOS))
+    {
+        return false;
+    }
+
+    // effects with their own line of sight rules, see CheckTarget
+    switch (m_spellInfo->Effect[eff])
+    {
+        case SPELL_EFFECT_SUMMON_PLAYER:
+        case SPELL_EFFECT_DUMMY:
+        case SPELL_EFFECT_RESURRECT_NEW:
+            return false;
+        default:
+            break;
+    }
+
+    WorldObject* caster = GetCastingObject();
+    if (!caster)
+    {
+        return false;
+    }
+
+    float cx, cy, cz;
+    caster->GetPosition(cx, cy, cz);
+
+    // same lines as WorldObject::IsWithinLOSInMap, from the target to the caster
+    std::vector<G3D::Vector3> from;
+    std::vector<G3D::Vector3> to;
+    from.reserve(targets.size());
+    to.reserve(targets.size());
+    for (UnitList::iterator itr = targets.begin(); itr != targets.end();)
+    {
+        Unit* target = *itr;
+        if (target == m_caster)
+        {
+            ++itr;
+            continue;
+        }
+
+        if (!target->IsInMap(caster))
+        {
+            itr = targets.erase(itr);
+            continue;
+        }
+
+        float x, y, z;
+        target->GetPosition(x, y, z);
+        from.push_back(G3D::Vector3(x, y, z + 2.0f));
+        to.push_back(G3D::Vector3(cx, cy, cz + 2.0f));
+        ++itr;
+    }
+
+    if (from.empty())
+    {
+        return true;
+    }
+
+    std::unique_ptr<bool[]> inSight(new bool[from.size()]);
+    caster->GetMap()->IsInLineOfSight(&from[0], &to[0], inSight.get(), uint32(from.size()));
+
+    size_t line = 0;
+    for (UnitList::iterator itr = targets.begin(); itr != targets.end();)
+    {
+        if (*itr != m_caster && !inSight[line++])
+        {
+            itr = targets.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+
+    return true;
+}
+
 bool Spell::IsNeedSendToClient() const
 {
     return m_spellInfo->SpellVisual != 0 || IsChanneledSpell(m_spellInfo) ||
@@ -7930,7 +8017,10 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=NULL*/)
 {
     MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+
+    // only units close enough to pass the distance checks of the notifier are looked at
+    auto visitUnit = [&notifier](WorldObject* obj) { notifier.VisitUnit(static_cast<Unit*>(obj)); };
+    Cell::VisitPositionIndex(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), radius, notifier.GetCenterSize(), TYPEMASK_UNIT, visitUnit);
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, float radius, bool raid, bool withPets, bool withcaster)
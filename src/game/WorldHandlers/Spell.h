@@ -363,7 +363,8 @@ class Spell
 
         template<typename T> WorldObject* FindCorpseUsing();
 
-        bool CheckTarget(Unit* target, SpellEffectIndex eff);
+        bool CheckTarget(Unit* target, SpellEffectIndex eff, bool checkLOS = true);
+        bool CheckTargetsLOS(UnitList& targets, SpellEffectIndex eff);
         bool CanAutoCast(Unit* target);
 
         static void  SendCastResult(Player* caster, SpellEntry const* spellInfo, SpellCastResult result);
@@ -674,14 +675,16 @@ namespace MaNGOS
         float i_centerX;
         float i_centerY;
         float i_centerZ;
+        float i_centerSize;
 
         float GetCenterX() const { return i_centerX; }
         float GetCenterY() const { return i_centerY; }
+        float GetCenterSize() const { return i_centerSize; }
 
         SpellNotifierCreatureAndPlayer(Spell& spell, Spell::UnitList& data, float radius, SpellNotifyPushType type,
                                        SpellTargets TargetType = SPELL_TARGETS_NOT_FRIENDLY, WorldObject* originalCaster = NULL)
             : i_data(&data), i_spell(spell), i_push_type(type), i_radius(radius), i_TargetType(TargetType),
-              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject())
+              i_originalCaster(originalCaster), i_castingObject(i_spell.GetCastingObject()), i_centerSize(0.0f)
         {
             if (!i_originalCaster)
             {
@@ -700,6 +703,7 @@ namespace MaNGOS
                     {
                         i_centerX = i_castingObject->GetPositionX();
                         i_centerY = i_castingObject->GetPositionY();
+                        i_centerSize = i_castingObject->GetObjectBoundingRadius();
                     }
                     break;
                 case PUSH_DEST_CENTER:
@@ -717,6 +721,7 @@ namespace MaNGOS
                     {
                         i_centerX = target->GetPositionX();
                         i_centerY = target->GetPositionY();
+                        i_centerSize = target->GetObjectBoundingRadius();
                     }
                     break;
                 default:
@@ -725,6 +730,15 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>&  m)
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            {
+                VisitUnit(itr->getSource());
+            }
+        }
+
+        // checks a single candidate, used by the grid visit and by the position index sweep
+        inline void VisitUnit(Unit* target)
         {
             MANGOS_ASSERT(i_data);
 
@@ -733,124 +747,121 @@ namespace MaNGOS
                 return;
             }
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // GM OFF Spell must pass the checks.
-                bool gmSpell = (i_spell.m_spellInfo->Id == 1509);
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
+            // GM OFF Spell must pass the checks.
+            bool gmSpell = (i_spell.m_spellInfo->Id == 1509);
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
 
-                if (!gmSpell)
-                {
-                    if ((i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->IsTargetableForAttack(i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX3_CAST_ON_DEAD)))
-                        // mostly phase check
-                        || !itr->getSource()->IsInMap(i_originalCaster))
-                        {
-                            continue;
-                        }
-
-                    switch (i_TargetType)
+            if (!gmSpell)
+            {
+                if ((i_TargetType != SPELL_TARGETS_ALL && !target->IsTargetableForAttack(i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX3_CAST_ON_DEAD)))
+                    // mostly phase check
+                    || !target->IsInMap(i_originalCaster))
                     {
-                        case SPELL_TARGETS_HOSTILE:
-                            if (!i_originalCaster->IsHostileTo(itr->getSource()))
-                            {
-                                continue;
-                            }
-                            break;
-                        case SPELL_TARGETS_NOT_FRIENDLY:
-                            if (i_originalCaster->IsFriendlyTo(itr->getSource()))
-                            {
-                                continue;
-                            }
-                            break;
-                        case SPELL_TARGETS_NOT_HOSTILE:
-                            if (i_originalCaster->IsHostileTo(itr->getSource()))
-                            {
-                                continue;
-                            }
-                            break;
-                        case SPELL_TARGETS_FRIENDLY:
-                            if (!i_originalCaster->IsFriendlyTo(itr->getSource()))
-                            {
-                                continue;
-                            }
-                            break;
-                        case SPELL_TARGETS_AOE_DAMAGE:
-                        {
-                            if (itr->getSource()->GetTypeId() == TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            {
-                                continue;
-                            }
-
-                            if (i_playerControlled)
-                            {
-                                if (i_originalCaster->IsFriendlyTo(itr->getSource()))
-                                {
-                                    continue;
-                                }
-                            }
-                            else
-                            {
-                                if (!i_originalCaster->IsHostileTo(itr->getSource()))
-                                {
-                                    continue;
-                                }
-                            }
-                        }
-                        break;
-                        case SPELL_TARGETS_ALL:
-                            break;
-                        default: continue;
+                        return;
                     }
-                }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
+                switch (i_TargetType)
                 {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->IsInFront((Unit*)(itr->getSource()), i_radius, 2 * M_PI_F / 3))
+                    case SPELL_TARGETS_HOSTILE:
+                        if (!i_originalCaster->IsHostileTo(target))
                         {
-                            i_data->push_back(itr->getSource());
+                            return;
                         }
                         break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->IsInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 2))
+                    case SPELL_TARGETS_NOT_FRIENDLY:
+                        if (i_originalCaster->IsFriendlyTo(target))
                         {
-                            i_data->push_back(itr->getSource());
+                            return;
                         }
                         break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->IsInFront((Unit*)(itr->getSource()), i_radius, M_PI_F / 12))
+                    case SPELL_TARGETS_NOT_HOSTILE:
+                        if (i_originalCaster->IsHostileTo(target))
                         {
-                            i_data->push_back(itr->getSource());
+                            return;
                         }
                         break;
-                    case PUSH_IN_BACK:
-                        if (i_castingObject->IsInBack((Unit*)(itr->getSource()), i_radius, 2 * M_PI_F / 3))
+                    case SPELL_TARGETS_FRIENDLY:
+                        if (!i_originalCaster->IsFriendlyTo(target))
                         {
-                            i_data->push_back(itr->getSource());
+                            return;
                         }
                         break;
-                    case PUSH_SELF_CENTER:
-                        if (i_castingObject->IsWithinDist((Unit*)(itr->getSource()), i_radius))
+                    case SPELL_TARGETS_AOE_DAMAGE:
+                    {
+                        if (target->GetTypeId() == TYPEID_UNIT && ((Creature*)target)->IsTotem())
                         {
-                            i_data->push_back(itr->getSource());
+                            return;
                         }
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius))
+
+                        if (i_playerControlled)
                         {
-                            i_data->push_back(itr->getSource());
+                            if (i_originalCaster->IsFriendlyTo(target))
+                            {
+                                return;
+                            }
                         }
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
+                        else
                         {
-                            i_data->push_back(itr->getSource());
+                            if (!i_originalCaster->IsHostileTo(target))
+                            {
+                                return;
+                            }
                         }
+                    }
+                    break;
+                    case SPELL_TARGETS_ALL:
                         break;
+                    default: return;
                 }
             }
+
+            // we don't need to check InMap here, it's already done some lines above
+            switch (i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_castingObject->IsInFront(target, i_radius, 2 * M_PI_F / 3))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if (i_castingObject->IsInFront(target, i_radius, M_PI_F / 2))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if (i_castingObject->IsInFront(target, i_radius, M_PI_F / 12))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_castingObject->IsInBack(target, i_radius, 2 * M_PI_F / 3))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_SELF_CENTER:
+                    if (i_castingObject->IsWithinDist(target, i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_DEST_CENTER:
+                    if (target->IsWithinDist3d(i_centerX, i_centerY, i_centerZ, i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist(target, i_radius))
+                    {
+                        i_data->push_back(target);
+                    }
+                    break;
+            }
         }
 
 #ifdef WIN32
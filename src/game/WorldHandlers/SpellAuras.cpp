@@ -666,7 +666,10 @@ void Aura::ApplyModifier(bool apply, bool Real)
     SetInUse(true);
     if (aura < TOTAL_AURAS)
     {
+        // handlers read the aggregates of their type and may change the amount they are built from
+        GetTarget()->InvalidateAuraAggregates(aura);
         (*this.*AuraHandler [aura])(apply, Real);
+        GetTarget()->InvalidateAuraAggregates(aura);
     }
 
     SetInUse(false);
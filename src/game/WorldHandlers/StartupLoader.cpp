@@ -0,0 +1,303 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+    /// Number of steps listed as the slowest ones in the report.
+    const size_t REPORT_SLOWEST_STEPS = 10;
+
+    const size_t NO_STEP = size_t(-1);
+}
+
+/**
+ * @brief Constructor for StartupLoader.
+ */
+StartupLoader::StartupLoader() :
+m_mutex(), m_condition(m_mutex), m_remaining(0), m_workers(0), m_threads(1), m_startTime(0), m_totalTime(0)
+{
+}
+
+/**
+ * @brief Destructor for StartupLoader.
+ */
+StartupLoader::~StartupLoader()
+{
+}
+
+/**
+ * @brief Declares a load step.
+ * @param name Name of the step, printed when it starts and used by later steps to refer to it.
+ * @param step Work of the step.
+ * @param after Names of the steps which have to be finished first.
+ */
+void StartupLoader::Add(char const* name, Step const& step, std::initializer_list<char const*> after)
+{
+    Node node;
+    node.name = name;
+    node.step = step;
+    node.pending = 0;
+    node.start = 0;
+    node.duration = 0;
+    node.thread = 0;
+
+    for (std::initializer_list<char const*>::const_iterator itr = after.begin(); itr != after.end(); ++itr)
+    {
+        size_t index = 0;
+        while (index < m_nodes.size() && m_nodes[index].name != *itr)
+        {
+            ++index;
+        }
+
+        if (index == m_nodes.size())
+        {
+            sLog.outError("StartupLoader: Step '%s' waits for '%s', which is not declared before it", name, *itr);
+            MANGOS_ASSERT(false);
+        }
+
+        node.after.push_back(index);
+        m_nodes[index].dependents.push_back(m_nodes.size());
+    }
+
+    m_nodes.push_back(node);
+}
+
+/**
+ * @brief Runs all declared steps and waits for completion.
+ * @param num_threads Number of worker threads, below 2 the steps run in the calling thread.
+ */
+void StartupLoader::Run(size_t num_threads)
+{
+    m_startTime = getMSTime();
+    m_threads = 1;
+
+    if (num_threads > 1 && m_nodes.size() > 1)
+    {
+        m_ready.clear();
+        m_remaining = m_nodes.size();
+        m_workers = 0;
+
+        for (size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            m_nodes[i].pending = m_nodes[i].after.size();
+            if (!m_nodes[i].pending)
+            {
+                m_ready.insert(i);
+            }
+        }
+
+        // bars of steps running at the same time would overwrite each other
+        bool showBars = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, (int)num_threads) != -1)
+        {
+            ACE_Task_Base::wait();
+            m_threads = uint32(num_threads);
+        }
+        else
+        {
+            sLog.outError("StartupLoader: Can't start %u threads, loading in the main thread", uint32(num_threads));
+        }
+
+        BarGoLink::SetOutputState(showBars);
+
+        if (!m_remaining)
+        {
+            m_totalTime = GetMSTimeDiffToNow(m_startTime);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        Execute(i, 0);
+    }
+
+    m_totalTime = GetMSTimeDiffToNow(m_startTime);
+}
+
+/**
+ * @brief Runs a single step and records its timing.
+ * @param index Step to be run.
+ * @param thread Worker running the step.
+ */
+void StartupLoader::Execute(size_t index, uint32 thread)
+{
+    Node& node = m_nodes[index];
+
+    sLog.outString("Loading %s...", node.name.c_str());
+
+    node.thread = thread;
+    node.start = GetMSTimeDiffToNow(m_startTime);
+    node.step();
+    node.duration = GetMSTimeDiffToNow(m_startTime) - node.start;
+}
+
+/**
+ * @brief Worker thread body.
+ * @return Always returns 0.
+ */
+int StartupLoader::svc()
+{
+    uint32 thread;
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+        thread = ++m_workers;
+    }
+
+    WorldDatabase.ThreadStart();                            // let thread do mysql init, once for all databases
+    Database::SetThreadQueryConnection(int(thread - 1));
+
+    for (;;)
+    {
+        size_t index;
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            while (m_remaining && m_ready.empty())
+            {
+                m_condition.wait();
+            }
+
+            if (!m_remaining)
+            {
+                break;
+            }
+
+            index = *m_ready.begin();
+            m_ready.erase(m_ready.begin());
+        }
+
+        Execute(index, thread);
+
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+            --m_remaining;
+
+            std::vector<size_t> const& dependents = m_nodes[index].dependents;
+            for (std::vector<size_t>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+            {
+                if (!--m_nodes[*itr].pending)
+                {
+                    m_ready.insert(*itr);
+                }
+            }
+
+            m_condition.broadcast();
+        }
+    }
+
+    Database::SetThreadQueryConnection(-1);
+    WorldDatabase.ThreadEnd();
+    return 0;
+}
+
+/**
+ * @brief Prints the total time, the critical path through the dependencies and the slowest steps.
+ *
+ * The critical path is the chain of dependent steps with the longest sum of
+ * durations. It bounds the startup time whatever the number of threads, and
+ * is the chain to look at when a sequential run is to be sped up.
+ */
+void StartupLoader::PrintReport() const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    // steps are declared after their dependencies, so one pass finds the longest chain ending at each step
+    std::vector<uint32> pathTime(m_nodes.size(), 0);
+    std::vector<size_t> pathPrev(m_nodes.size(), NO_STEP);
+    size_t last = 0;
+    uint32 work = 0;
+
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        Node const& node = m_nodes[i];
+
+        uint32 longest = 0;
+        for (std::vector<size_t>::const_iterator itr = node.after.begin(); itr != node.after.end(); ++itr)
+        {
+            if (pathPrev[i] == NO_STEP || pathTime[*itr] > longest)
+            {
+                longest = pathTime[*itr];
+                pathPrev[i] = *itr;
+            }
+        }
+
+        pathTime[i] = longest + node.duration;
+        work += node.duration;
+
+        if (pathTime[i] > pathTime[last])
+        {
+            last = i;
+        }
+    }
+
+    sLog.outString("Startup loading: %u steps in %u ms, %u ms of work on %u thread(s)", uint32(m_nodes.size()), m_totalTime, work, m_threads);
+
+    std::vector<size_t> path;
+    for (size_t i = last; i != NO_STEP; i = pathPrev[i])
+    {
+        path.push_back(i);
+    }
+
+    sLog.outString("Critical path: %u ms", pathTime[last]);
+    for (std::vector<size_t>::const_reverse_iterator itr = path.rbegin(); itr != path.rend(); ++itr)
+    {
+        sLog.outString("  %6u ms  %s", m_nodes[*itr].duration, m_nodes[*itr].name.c_str());
+    }
+
+    std::vector<size_t> slowest(m_nodes.size());
+    std::iota(slowest.begin(), slowest.end(), size_t(0));
+
+    size_t count = std::min(slowest.size(), REPORT_SLOWEST_STEPS);
+    std::partial_sort(slowest.begin(), slowest.begin() + count, slowest.end(), [this](size_t a, size_t b)
+    {
+        return m_nodes[a].duration > m_nodes[b].duration;
+    });
+
+    sLog.outString("Slowest steps:");
+    for (size_t i = 0; i < count; ++i)
+    {
+        Node const& node = m_nodes[slowest[i]];
+        sLog.outString("  %6u ms  %s (started at %u ms, thread %u)", node.duration, node.name.c_str(), node.start, node.thread);
+    }
+
+    sLog.outString();
+}
@@ -0,0 +1,128 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef _STARTUP_LOADER_H_INCLUDED
+#define _STARTUP_LOADER_H_INCLUDED
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+
+#include <functional>
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs the world startup load steps along their declared dependencies.
+ *
+ * Every step names the steps it reads the data of, or shares a container
+ * with. Steps whose dependencies are finished run at the same time on
+ * worker threads, each worker using its own query connection of the
+ * databases (see Database::SetThreadQueryConnection). Without workers the
+ * steps run one after another in declaration order.
+ *
+ * Dependencies can only name steps declared before, so the declaration
+ * order is always a valid sequential order and the graph can not contain
+ * a cycle.
+ */
+class StartupLoader : protected ACE_Task_Base
+{
+    public:
+        typedef std::function<void()> Step;
+
+        /**
+         * @brief Constructor for StartupLoader.
+         */
+        StartupLoader();
+
+        /**
+         * @brief Destructor for StartupLoader.
+         */
+        virtual ~StartupLoader();
+
+        /**
+         * @brief Declares a load step.
+         * @param name Name of the step, printed when it starts and used by later steps to refer to it.
+         * @param step Work of the step.
+         * @param after Names of the steps which have to be finished first.
+         */
+        void Add(char const* name, Step const& step, std::initializer_list<char const*> after = {});
+
+        /**
+         * @brief Runs all declared steps and waits for completion.
+         * @param num_threads Number of worker threads, below 2 the steps run in the calling thread.
+         */
+        void Run(size_t num_threads);
+
+        /**
+         * @brief Prints the total time, the critical path through the dependencies and the slowest steps.
+         */
+        void PrintReport() const;
+
+    protected:
+        /**
+         * @brief Worker thread body.
+         * @return Always returns 0.
+         */
+        virtual int svc() override;
+
+    private:
+        /**
+         * @brief A declared step and its timing.
+         */
+        struct Node
+        {
+            std::string name;
+            Step step;
+            std::vector<size_t> after;      ///< Steps this one waits for.
+            std::vector<size_t> dependents; ///< Steps waiting for this one.
+            size_t pending;                 ///< Unfinished steps of after, while running.
+            uint32 start;                   ///< Time since the start of Run, in milliseconds.
+            uint32 duration;                ///< In milliseconds.
+            uint32 thread;                  ///< Worker which ran the step, 0 for the calling thread.
+        };
+
+        /**
+         * @brief Runs a single step and records its timing.
+         * @param index Step to be run.
+         * @param thread Worker running the step.
+         */
+        void Execute(size_t index, uint32 thread);
+
+        ACE_Thread_Mutex m_mutex;                   ///< Protects the scheduling state below.
+        ACE_Condition_Thread_Mutex m_condition;     ///< Signaled when steps become ready or all are done.
+        std::vector<Node> m_nodes;                  ///< Steps in declaration order.
+        std::set<size_t> m_ready;                   ///< Steps which may start, lowest declaration index first.
+        size_t m_remaining;                         ///< Steps not finished yet.
+        uint32 m_workers;                           ///< Number of started workers, used as their id.
+        uint32 m_threads;                           ///< Threads used by the last Run.
+        uint32 m_startTime;                         ///< getMSTime() at the start of Run.
+        uint32 m_totalTime;                         ///< Duration of the last Run, in milliseconds.
+};
+
+#endif //_STARTUP_LOADER_H_INCLUDED
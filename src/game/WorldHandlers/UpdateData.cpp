@@ -46,29 +46,87 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid const& guid)
     m_outOfRangeGUIDs.insert(guid);
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    /**
+     * @brief Deflate stream kept alive per thread, reset between packets instead of
+     * allocating the zlib state (~256KB) for every update packet.
+     */
+    struct UpdateCompressor
+    {
+        UpdateCompressor() : initialized(false), level(0) {}
+        ~UpdateCompressor()
+        {
+            if (initialized)
+            {
+                deflateEnd(&stream);
+            }
+        }
+
+        z_stream* Get(int compressionLevel)
+        {
+            if (initialized && level != compressionLevel)
+            {
+                deflateEnd(&stream);
+                initialized = false;
+            }
+
+            if (!initialized)
+            {
+                stream.zalloc = (alloc_func)0;
+                stream.zfree = (free_func)0;
+                stream.opaque = (voidpf)0;
+
+                int z_res = deflateInit(&stream, compressionLevel);
+                if (z_res != Z_OK)
+                {
+                    sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+                    return NULL;
+                }
+
+                initialized = true;
+                level = compressionLevel;
+                return &stream;
+            }
+
+            int z_res = deflateReset(&stream);
+            if (z_res != Z_OK)
+            {
+                sLog.outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+                deflateEnd(&stream);
+                initialized = false;
+                return NULL;
+            }
+
+            return &stream;
+        }
+
+        z_stream stream;
+        bool initialized;
+        int level;
+    };
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    thread_local UpdateCompressor t_compressor;
+}
 
+void UpdateData::Compress(void* dst, uint32* dst_size, ByteBuffer const& head, ByteBuffer const& data)
+{
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
-    if (z_res != Z_OK)
+    z_stream* c_stream = t_compressor.Get(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    if (!c_stream)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
         *dst_size = 0;
         return;
     }
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+    c_stream->next_out = (Bytef*)dst;
+    c_stream->avail_out = *dst_size;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
+    // the header and the update blocks are fed one after the other, no need to join them first
+    c_stream->next_in = (Bytef*)head.contents();
+    c_stream->avail_in = (uInt)head.wpos();
+
+    int z_res = deflate(c_stream, Z_NO_FLUSH);
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflate) Error code: %i (%s)", z_res, zError(z_res));
@@ -76,14 +134,17 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    if (c_stream.avail_in != 0)
+    if (c_stream->avail_in != 0)
     {
         sLog.outError("Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
         return;
     }
 
-    z_res = deflate(&c_stream, Z_FINISH);
+    c_stream->next_in = (Bytef*)(data.wpos() ? data.contents() : head.contents());
+    c_stream->avail_in = (uInt)data.wpos();
+
+    z_res = deflate(c_stream, Z_FINISH);
     if (z_res != Z_STREAM_END)
     {
         sLog.outError("Can't compress update packet (zlib: deflate should report Z_STREAM_END instead %i (%s)", z_res, zError(z_res));
@@ -91,40 +152,30 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
-    *dst_size = c_stream.total_out;
+    *dst_size = c_stream->total_out;
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet, bool hasTransport)
 {
     MANGOS_ASSERT(packet->empty());                         // shouldn't happen
 
-    ByteBuffer buf(4 + 1 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    ByteBuffer head(4 + 1 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()));
 
-    buf << (uint32)(!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
-    buf << (uint8)(hasTransport ? 1 : 0);
+    head << (uint32)(!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
+    head << (uint8)(hasTransport ? 1 : 0);
 
     if (!m_outOfRangeGUIDs.empty())
     {
-        buf << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
-        buf << (uint32) m_outOfRangeGUIDs.size();
+        head << (uint8) UPDATETYPE_OUT_OF_RANGE_OBJECTS;
+        head << (uint32) m_outOfRangeGUIDs.size();
 
         for (GuidSet::const_iterator i = m_outOfRangeGUIDs.begin(); i != m_outOfRangeGUIDs.end(); ++i)
         {
-            buf << i->WriteAsPacked();
+            head << i->WriteAsPacked();
         }
     }
 
-    buf.append(m_data);
-
-    size_t pSize = buf.wpos();                              // use real used data size
+    size_t pSize = head.wpos() + m_data.wpos();             // use real used data size
 
     if (pSize > 100)                                        // compress large packets
     {
@@ -132,7 +183,7 @@ bool UpdateData::BuildPacket(WorldPacket* packet, bool hasTransport)
         packet->resize(destsize + sizeof(uint32));
 
         packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
+        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, head, m_data);
         if (destsize == 0)
         {
             return false;
@@ -143,7 +194,9 @@ bool UpdateData::BuildPacket(WorldPacket* packet, bool hasTransport)
     }
     else                                                    // send small packets without compression
     {
-        packet->append(buf);
+        packet->reserve(pSize);
+        packet->append(head);
+        packet->append(m_data);
         packet->SetOpcode(SMSG_UPDATE_OBJECT);
     }
 
@@ -73,6 +73,6 @@ class UpdateData
         GuidSet m_outOfRangeGUIDs;
         ByteBuffer m_data;
 
-        void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        void Compress(void* dst, uint32* dst_size, ByteBuffer const& head, ByteBuffer const& data);
 };
 #endif
@@ -59,6 +59,7 @@
 #include "GameEventMgr.h"
 #include "PoolManager.h"
 #include "Database/DatabaseImpl.h"
+#include "Database/SQLStorageSnapshot.h"
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "MapPersistentStateMgr.h"
@@ -76,6 +77,7 @@
 #include "GitRevision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "StartupLoader.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -519,6 +521,7 @@ void World::LoadConfigSettings(bool reload)
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
+    setConfig(CONFIG_BOOL_PARALLEL_COMPRESSION, "Compression.Parallel", false);
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
@@ -553,6 +556,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
+    setConfig(CONFIG_BOOL_PLAYER_SAVE_BATCHED, "PlayerSave.Batched", false);
 
     setConfigMin(CONFIG_UINT32_INTERVAL_GRIDCLEAN, "GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS, MIN_GRID_DELAY);
     if (reload)
@@ -562,6 +566,37 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_NUMTHREADS, "MapUpdateThreads", 2);
 
+    if (configNoReload(reload, CONFIG_UINT32_REGION_UPDATE_THREADS, "MapUpdateRegionThreads", 0))
+    {
+        setConfig(CONFIG_UINT32_REGION_UPDATE_THREADS, "MapUpdateRegionThreads", 0);
+    }
+
+    if (configNoReload(reload, CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreloadThreads", 0))
+    {
+        setConfig(CONFIG_UINT32_GRID_PRELOAD_THREADS, "GridPreloadThreads", 0);
+    }
+
+    if (configNoReload(reload, CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreloadLookAhead", 10 * IN_MILLISECONDS))
+    {
+        setConfig(CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD, "GridPreloadLookAhead", 10 * IN_MILLISECONDS);
+    }
+
+    if (configNoReload(reload, CONFIG_UINT32_STARTUP_LOADER_THREADS, "StartupLoaderThreads", 0))
+    {
+        setConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS, "StartupLoaderThreads", 0);
+    }
+
+    m_configRegionUpdateMapIds.clear();
+    std::string regionUpdateMaps = sConfig.GetStringDefault("MapUpdateRegionMaps", "");
+    if (!regionUpdateMaps.empty())
+    {
+        unsigned int pos = 0;
+        unsigned int id;
+        VMAP::VMapFactory::chompAndTrim(regionUpdateMaps);
+        while (VMAP::VMapFactory::getNextId(regionUpdateMaps, pos, id))
+            m_configRegionUpdateMapIds.insert(id);
+    }
+
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
     {
@@ -936,6 +971,26 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    ///- Read the snapshot directory of the static world tables, empty disables the snapshots
+    std::string snapshotPath = sConfig.GetStringDefault("SnapshotDir", "");
+    if (!snapshotPath.empty() && snapshotPath.at(snapshotPath.length() - 1) != '/' && snapshotPath.at(snapshotPath.length() - 1) != '\\')
+    {
+        snapshotPath.append("/");
+    }
+
+    if (reload)
+    {
+        if (snapshotPath != SQLStorageSnapshot::GetDirectory())
+        {
+            sLog.outError("SnapshotDir option can't be changed at mangosd.conf reload, using current value (%s).", SQLStorageSnapshot::GetDirectory().c_str());
+        }
+    }
+    else if (!snapshotPath.empty())
+    {
+        SQLStorageSnapshot::SetDirectory(snapshotPath);
+        sLog.outString("Using SnapshotDir %s", snapshotPath.c_str());
+    }
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -949,11 +1004,24 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     VMAP::VMapFactory::preventSpellsFromBeingTestedForLoS(ignoreSpellIds.c_str());
+
+    if (configNoReload(reload, CONFIG_UINT32_TERRAIN_QUERY_CACHE_SIZE, "vmap.queryCacheSize", 4096))
+    {
+        setConfig(CONFIG_UINT32_TERRAIN_QUERY_CACHE_SIZE, "vmap.queryCacheSize", 4096);
+    }
+
+    // cached results may have been computed with other vmap settings
+    if (reload)
+    {
+        sTerrainMgr.InvalidateQueryCaches();
+    }
     sLog.outString("WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i",
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
+    setConfig(CONFIG_BOOL_MMAP_BATCHED_PATHS, "mmap.batchedPaths", false);
+    setConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE, "mmap.pathCacheSize", 2048);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds", "");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
@@ -1073,288 +1141,161 @@ void World::SetInitialWorldSettings()
     }
 #endif /* ENABLE_ELUNA */
 
-    sLog.outString("Loading Page Texts...");
-    sObjectMgr.LoadPageTexts();
-
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
-    sObjectMgr.LoadGameobjectInfo();
-
-    sLog.outString("Loading GameObject models...");
-    LoadGameObjectModelList();
-    sLog.outString();
-
-    sLog.outString("Loading Spell Chain Data...");
-    sSpellMgr.LoadSpellChains();
-
-    sLog.outString("Loading Spell Elixir types...");
-    sSpellMgr.LoadSpellElixirs();
-
-    sLog.outString("Loading Spell Facing Flags...");
-    sSpellMgr.LoadFacingCasterFlags();
-
-    sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Learn Spells...");
-    sSpellMgr.LoadSpellLearnSpells();
-
-    sLog.outString("Loading Spell Proc Event conditions...");
-    sSpellMgr.LoadSpellProcEvents();
-
-    sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();
-
-    sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
-
-    sLog.outString("Loading Spell Linked definitions...");
-    sSpellMgr.LoadSpellLinked();                            // must be after LoadSpellChains
-
-    sLog.outString("Loading Aggro Spells Definitions...");
-    sSpellMgr.LoadSpellThreats();
-
-    sLog.outString("Loading NPC Texts...");
-    sObjectMgr.LoadGossipText();
-
-    sLog.outString("Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
-
-    sLog.outString("Loading Disables...");                  // must be before loading quests and items
-    DisableMgr::LoadDisables();
-
-    sLog.outString("Loading Item Templates...");            // must be after LoadRandomEnchantmentsTable and LoadPageTexts
-    sObjectMgr.LoadItemPrototypes();
-
-    sLog.outString("Loading Creature Model Based Info Data...");
-    sObjectMgr.LoadCreatureModelInfo();
-
-    sLog.outString("Loading Creature Items...");
-    sObjectMgr.LoadCreatureItemTemplates();
-
-    sLog.outString("Loading Equipment templates...");
-    sObjectMgr.LoadEquipmentTemplates();
-
-    sLog.outString("Loading Creature Stats...");
-    sObjectMgr.LoadCreatureClassLvlStats();
-
-    sLog.outString("Loading Creature templates...");
-    sObjectMgr.LoadCreatureTemplates();
-
-    sLog.outString("Loading Creature template spells...");
-    sObjectMgr.LoadCreatureTemplateSpells();
-
-    sLog.outString("Loading Creature spells...");
-    sObjectMgr.LoadCreatureSpells();
-
-    sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
-
-    sLog.outString("Loading ItemRequiredTarget...");
-    sObjectMgr.LoadItemRequiredTarget();
-
-    sLog.outString("Loading Reputation Reward Rates...");
-    sObjectMgr.LoadReputationRewardRate();
-
-    sLog.outString("Loading Creature Reputation OnKill Data...");
-    sObjectMgr.LoadReputationOnKill();
-
-    sLog.outString("Loading Reputation Spillover Data...");
-    sObjectMgr.LoadReputationSpilloverTemplate();
-
-    sLog.outString("Loading Points Of Interest Data...");
-    sObjectMgr.LoadPointsOfInterest();
-
-    sLog.outString("Loading Pet Create Spells...");
-    sObjectMgr.LoadPetCreateSpells();
-
-    sLog.outString("Loading Creature Data...");
-    sObjectMgr.LoadCreatures();
-
-    sLog.outString("Loading Creature Addon Data...");
-    sObjectMgr.LoadCreatureAddons();                        // must be after LoadCreatureTemplates() and LoadCreatures()
-    sLog.outString(">>> Creature Addon Data loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Gameobject Data...");
-    sObjectMgr.LoadGameObjects();
-
-    sLog.outString("Loading CreatureLinking Data...");      // must be after Creatures
-    sCreatureLinkingMgr.LoadFromDB();
-
-    sLog.outString("Loading Objects Pooling Data...");
-    sPoolMgr.LoadFromDB();
-
-    sLog.outString("Loading Weather Data...");
-    sWeatherMgr.LoadWeatherZoneChances();
-
-    sLog.outString("Loading Quests...");
-    sObjectMgr.LoadQuests();                                // must be loaded after DBCs, creature_template, item_template, gameobject tables
-
-    sLog.outString("Loading Quests Relations...");
-    sObjectMgr.LoadQuestRelations();                        // must be after quest load
-    sLog.outString(">>> Quests Relations loaded");
-    sLog.outString();
-
-    sLog.outString("Checking Quest Disables...");
-    DisableMgr::CheckQuestDisables();                       // must be after loading quests
-
-    sLog.outString("Loading Game Event Data...");           // must be after sPoolMgr.LoadFromDB and quests to properly load pool events and quests for events
-    sGameEventMgr.LoadFromDB();
-    sLog.outString(">>> Game Event Data loaded");
-    sLog.outString();
-
-    // Load Conditions
-    sLog.outString("Loading Conditions...");
-    sObjectMgr.LoadConditions();
-
-    sLog.outString("Creating map persistent states for non-instanceable maps...");     // must be after PackInstances(), LoadCreatures(), sPoolMgr.LoadFromDB(), sGameEventMgr.LoadFromDB();
-    sMapPersistentStateMgr.InitWorldMaps();
-    sLog.outString();
-
-    sLog.outString("Loading Creature Respawn Data...");     // must be after LoadCreatures(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadCreatureRespawnTimes();
-
-    sLog.outString("Loading Gameobject Respawn Data...");   // must be after LoadGameObjects(), and sMapPersistentStateMgr.InitWorldMaps()
-    sMapPersistentStateMgr.LoadGameobjectRespawnTimes();
-
-    sLog.outString("Loading SpellArea Data...");            // must be after quest load
-    sSpellMgr.LoadSpellAreas();
-
-    sLog.outString("Loading AreaTrigger definitions...");
-    sObjectMgr.LoadAreaTriggerTeleports();                  // must be after item template load
-
-    sLog.outString("Loading Quest Area Triggers...");
-    sObjectMgr.LoadQuestAreaTriggers();                     // must be after LoadQuests
-
-    sLog.outString("Loading Tavern Area Triggers...");
-    sObjectMgr.LoadTavernAreaTriggers();
-
-    //sLog.outString("Loading AreaTrigger script names...");
-    //sScriptMgr.LoadAreaTriggerScripts();
-
-    //sLog.outString("Loading event id script names...");
-    //sScriptMgr.LoadEventIdScripts();
-
-    //sLog.outString("Loading spell script names...");
-    //sScriptMgr.LoadSpellIdScripts();
-
+    sLog.outString("Modifying in-memory dbc spell attributes...");
+    sSpellMgr.ModDBCSpellAttributes();                      // before the loaders, they read spells from any thread
+
+    ///- Load the static data, steps without dependency between them run at the same time with StartupLoaderThreads
+    // every step waits for the steps whose data it reads, and for the steps filling the same container
+    StartupLoader loader;
+
+    loader.Add("Page Texts", []() { sObjectMgr.LoadPageTexts(); });
+    loader.Add("Game Object Templates", []() { sObjectMgr.LoadGameobjectInfo(); }, { "Page Texts" });
+    loader.Add("GameObject models", []() { LoadGameObjectModelList(); });
+
+    loader.Add("Spell Chain Data", []() { sSpellMgr.LoadSpellChains(); });
+    loader.Add("Spell Elixir types", []() { sSpellMgr.LoadSpellElixirs(); });
+    loader.Add("Spell Facing Flags", []() { sSpellMgr.LoadFacingCasterFlags(); });
+    loader.Add("Spell Learn Skills", []() { sSpellMgr.LoadSpellLearnSkills(); }, { "Spell Chain Data" });
+    loader.Add("Spell Learn Spells", []() { sSpellMgr.LoadSpellLearnSpells(); });
+    loader.Add("Spell Proc Event conditions", []() { sSpellMgr.LoadSpellProcEvents(); }, { "Spell Chain Data" });
+    loader.Add("Spell Bonus Data", []() { sSpellMgr.LoadSpellBonuses(); }, { "Spell Chain Data" });
+    loader.Add("Spell Proc Item Enchant", []() { sSpellMgr.LoadSpellProcItemEnchant(); }, { "Spell Chain Data" });
+    loader.Add("Spell Linked definitions", []() { sSpellMgr.LoadSpellLinked(); }, { "Spell Chain Data" });
+    loader.Add("Aggro Spells Definitions", []() { sSpellMgr.LoadSpellThreats(); }, { "Spell Chain Data" });
+
+    loader.Add("NPC Texts", []() { sObjectMgr.LoadGossipText(); });
+    loader.Add("Item Random Enchantments Table", []() { LoadRandomEnchantmentsTable(); });
+    loader.Add("Disables", []() { DisableMgr::LoadDisables(); });
+    loader.Add("Item Templates", []() { sObjectMgr.LoadItemPrototypes(); }, { "Item Random Enchantments Table", "Page Texts", "Disables" });
+
+    loader.Add("Creature Model Based Info Data", []() { sObjectMgr.LoadCreatureModelInfo(); });
+    loader.Add("Creature Items", []() { sObjectMgr.LoadCreatureItemTemplates(); });
+    loader.Add("Equipment templates", []() { sObjectMgr.LoadEquipmentTemplates(); }, { "Creature Items" });
+    loader.Add("Creature Stats", []() { sObjectMgr.LoadCreatureClassLvlStats(); });
+    loader.Add("Creature templates", []() { sObjectMgr.LoadCreatureTemplates(); }, { "Creature Model Based Info Data", "Equipment templates", "Creature Stats" });
+    loader.Add("Creature template spells", []() { sObjectMgr.LoadCreatureTemplateSpells(); }, { "Creature templates" });
+    loader.Add("Creature spells", []() { sObjectMgr.LoadCreatureSpells(); });
+
+    loader.Add("SpellsScriptTarget", []() { sSpellMgr.LoadSpellScriptTarget(); }, { "Creature templates", "Game Object Templates" });
+    loader.Add("ItemRequiredTarget", []() { sObjectMgr.LoadItemRequiredTarget(); }, { "Item Templates", "Creature templates" });
+    loader.Add("Reputation Reward Rates", []() { sObjectMgr.LoadReputationRewardRate(); });
+    loader.Add("Creature Reputation OnKill Data", []() { sObjectMgr.LoadReputationOnKill(); }, { "Creature templates" });
+    loader.Add("Reputation Spillover Data", []() { sObjectMgr.LoadReputationSpilloverTemplate(); });
+    loader.Add("Points Of Interest Data", []() { sObjectMgr.LoadPointsOfInterest(); });
+    loader.Add("Pet Create Spells", []() { sObjectMgr.LoadPetCreateSpells(); }, { "Creature templates" });
+
+    // creatures, game objects and corpses fill the same per cell guid lists
+    loader.Add("Creature Data", []() { sObjectMgr.LoadCreatures(); }, { "Creature templates", "Equipment templates", "Disables" });
+    loader.Add("Creature Addon Data", []() { sObjectMgr.LoadCreatureAddons(); }, { "Creature templates", "Creature Data" });
+    loader.Add("Gameobject Data", []() { sObjectMgr.LoadGameObjects(); }, { "Game Object Templates", "Disables", "Creature Data" });
+    loader.Add("CreatureLinking Data", []() { sCreatureLinkingMgr.LoadFromDB(); }, { "Creature templates", "Creature Data" });
+    loader.Add("Objects Pooling Data", []() { sPoolMgr.LoadFromDB(); }, { "Creature Data", "Gameobject Data" });
+    loader.Add("Weather Data", []() { sWeatherMgr.LoadWeatherZoneChances(); });
+
+    loader.Add("Quests", []() { sObjectMgr.LoadQuests(); }, { "Creature templates", "Item Templates", "Game Object Templates", "Disables" });
+    loader.Add("Quests Relations", []() { sObjectMgr.LoadQuestRelations(); }, { "Quests", "Creature templates", "Game Object Templates" });
+    loader.Add("Quest Disables", []() { DisableMgr::CheckQuestDisables(); }, { "Quests" });
+    loader.Add("Game Event Data", []() { sGameEventMgr.LoadFromDB(); }, { "Objects Pooling Data", "Quests", "Creature templates", "Equipment templates" });
+    loader.Add("Conditions", []() { sObjectMgr.LoadConditions(); }, { "Game Event Data", "Quests", "Item Templates" });
+
+    // the persistent state of a map is created by the first step needing it
+    loader.Add("map persistent states for non-instanceable maps", []() { sMapPersistentStateMgr.InitWorldMaps(); }, { "Creature Data", "Gameobject Data", "Objects Pooling Data", "Game Event Data" });
+    loader.Add("Creature Respawn Data", []() { sMapPersistentStateMgr.LoadCreatureRespawnTimes(); }, { "Creature Data", "map persistent states for non-instanceable maps" });
+    loader.Add("Gameobject Respawn Data", []() { sMapPersistentStateMgr.LoadGameobjectRespawnTimes(); }, { "Gameobject Data", "Creature Respawn Data" });
+
+    loader.Add("SpellArea Data", []() { sSpellMgr.LoadSpellAreas(); }, { "Quests", "Conditions" });
+    loader.Add("AreaTrigger definitions", []() { sObjectMgr.LoadAreaTriggerTeleports(); }, { "Item Templates", "Conditions" });
+    loader.Add("Quest Area Triggers", []() { sObjectMgr.LoadQuestAreaTriggers(); }, { "Quests" });
+    loader.Add("Tavern Area Triggers", []() { sObjectMgr.LoadTavernAreaTriggers(); });
 #ifdef ENABLE_SD3
-    sLog.outString("Loading all script bindings...");
-    sScriptMgr.LoadScriptBinding();
+    loader.Add("all script bindings", []() { sScriptMgr.LoadScriptBinding(); }, { "Creature Data", "Gameobject Data", "Item Templates", "Conditions" });
 #endif /* ENABLE_SD3 */
 
-    sLog.outString("Loading Graveyard-zone links...");
-    sObjectMgr.LoadGraveyardZones();
-
-    sLog.outString("Loading spell target destination coordinates...");
-    sSpellMgr.LoadSpellTargetPositions();
-
-    sLog.outString("Loading SpellAffect definitions...");
-    sSpellMgr.LoadSpellAffects();
-
-    sLog.outString("Loading spell pet auras...");
-    sSpellMgr.LoadSpellPetAuras();
-
-    sLog.outString("Loading Player Create Info & Level Stats...");
-    sObjectMgr.LoadPlayerInfo();
-    sLog.outString(">>> Player Create Info & Level Stats loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Exploration BaseXP Data...");
-    sObjectMgr.LoadExplorationBaseXP();
-
-    sLog.outString("Loading Pet Name Parts...");
-    sObjectMgr.LoadPetNames();
-
-    CharacterDatabaseCleaner::CleanDatabase();
-    sLog.outString();
-
-    sLog.outString("Loading the max pet number...");
-    sObjectMgr.LoadPetNumber();
-
-    sLog.outString("Loading pet level stats...");
-    sObjectMgr.LoadPetLevelInfo();
-
-    sLog.outString("Loading Player Corpses...");
-    sObjectMgr.LoadCorpses();
-
-    sLog.outString("Loading Loot Tables...");
-    LoadLootTables();
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Gossip scripts...");
-    sScriptMgr.LoadDbScripts(DBS_ON_GOSSIP);                 // must be before gossip menu options
-
-    sObjectMgr.LoadGossipMenus();
-
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
-
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
-
-    sLog.outString("Loading Waypoint scripts...");          // before loading from creature_movement
-    sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_MOVEMENT);
-
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
-
-    sLog.outString("Modifying in-memory dbc spell attributes...");
-    sSpellMgr.ModDBCSpellAttributes();
-
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
-
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
-
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
-
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes();
-
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loader.Add("Graveyard-zone links", []() { sObjectMgr.LoadGraveyardZones(); });
+    loader.Add("spell target destination coordinates", []() { sSpellMgr.LoadSpellTargetPositions(); });
+    loader.Add("SpellAffect definitions", []() { sSpellMgr.LoadSpellAffects(); });
+    loader.Add("spell pet auras", []() { sSpellMgr.LoadSpellPetAuras(); });
+
+    loader.Add("Player Create Info & Level Stats", []() { sObjectMgr.LoadPlayerInfo(); }, { "Item Templates" });
+    loader.Add("Exploration BaseXP Data", []() { sObjectMgr.LoadExplorationBaseXP(); });
+    loader.Add("Pet Name Parts", []() { sObjectMgr.LoadPetNames(); });
+    loader.Add("Character Database cleanup", []() { CharacterDatabaseCleaner::CleanDatabase(); });
+    loader.Add("the max pet number", []() { sObjectMgr.LoadPetNumber(); });
+    loader.Add("pet level stats", []() { sObjectMgr.LoadPetLevelInfo(); }, { "Creature templates" });
+    loader.Add("Player Corpses", []() { sObjectMgr.LoadCorpses(); }, { "Gameobject Data" });
+    loader.Add("Loot Tables", []() { LoadLootTables(); }, { "Item Templates", "Creature templates", "Game Object Templates", "Conditions" });
+    loader.Add("Skill Fishing base level requirements", []() { sObjectMgr.LoadFishingBaseSkillLevel(); });
+
+    // db scripts check creature and game object spawns, quests and conditions
+    loader.Add("Gossip scripts", []() { sScriptMgr.LoadDbScripts(DBS_ON_GOSSIP); }, { "Creature Data", "Gameobject Data", "Quests", "Item Templates", "Conditions" });
+    loader.Add("Gossip Menus", []() { sObjectMgr.LoadGossipMenus(); }, { "Gossip scripts", "NPC Texts", "Points Of Interest Data", "Creature templates", "Game Object Templates", "Conditions" });
+    loader.Add("Vendors", []()
+    {
+        sObjectMgr.LoadVendorTemplates();                   // must be after load ItemTemplate
+        sObjectMgr.LoadVendors();                           // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    }, { "Item Templates", "Creature templates", "Conditions" });
+    loader.Add("Trainers", []()
+    {
+        sObjectMgr.LoadTrainerTemplates();                  // must be after load CreatureTemplate
+        sObjectMgr.LoadTrainers();                          // must be after load CreatureTemplate, TrainerTemplate
+    }, { "Creature templates", "Item Templates" });
+    loader.Add("Waypoint scripts", []() { sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_MOVEMENT); }, { "Creature Data", "Gameobject Data", "Quests", "Item Templates", "Conditions" });
+    loader.Add("Waypoints", []() { sWaypointMgr.Load(); }, { "Waypoint scripts", "Creature Data" });
+
+    loader.Add("ReservedNames", []() { sObjectMgr.LoadReservedPlayersNames(); });
+    loader.Add("GameObjects for quests", []() { sObjectMgr.LoadGameObjectForQuests(); }, { "Loot Tables", "Game Object Templates", "Quests Relations" });
+    loader.Add("BattleMasters", []() { sBattleGroundMgr.LoadBattleMastersEntry(); });
+    loader.Add("BattleGround event indexes", []() { sBattleGroundMgr.LoadBattleEventIndexes(); });
+    loader.Add("GameTeleports", []() { sObjectMgr.LoadGameTele(); });
 
     ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sCommandMgr.LoadCommandHelpLocale();
-    sLog.outString(">>> Localization strings loaded");
-    sLog.outString();
+    loader.Add("Localization strings", []()
+    {
+        sObjectMgr.LoadCreatureLocales();                   // must be after CreatureInfo loading
+        sObjectMgr.LoadGameObjectLocales();                 // must be after GameobjectInfo loading
+        sObjectMgr.LoadItemLocales();                       // must be after ItemPrototypes loading
+        sObjectMgr.LoadQuestLocales();                      // must be after QuestTemplates loading
+        sObjectMgr.LoadGossipTextLocales();                 // must be after LoadGossipText
+        sObjectMgr.LoadPageTextLocales();                   // must be after PageText loading
+        sObjectMgr.LoadGossipMenuItemsLocales();            // must be after gossip menu items loading
+        sObjectMgr.LoadPointOfInterestLocales();            // must be after POI loading
+        sCommandMgr.LoadCommandHelpLocale();
+    }, { "Creature templates", "Game Object Templates", "Item Templates", "Quests", "NPC Texts", "Page Texts", "Gossip Menus", "Points Of Interest Data" });
 
     ///- Load dynamic data tables from the database
-    sLog.outString("Loading Auctions...");
-    sAuctionMgr.LoadAuctionItems();
-    sAuctionMgr.LoadAuctions();
-    sLog.outString(">>> Auctions loaded");
-    sLog.outString();
+    loader.Add("Auctions", []()
+    {
+        sAuctionMgr.LoadAuctionItems();
+        sAuctionMgr.LoadAuctions();
+    }, { "Item Templates" });
+    loader.Add("Guilds", []() { sGuildMgr.LoadGuilds(); });
+    loader.Add("Groups", []() { sObjectMgr.LoadGroups(); }, { "Gameobject Respawn Data" });
+    loader.Add("old mails", []() { sObjectMgr.ReturnOrDeleteOldMails(false); }, { "Item Templates" });
+    loader.Add("GM tickets", []() { sTicketMgr.LoadGMTickets(); });
 
-    sLog.outString("Loading Guilds...");
-    sGuildMgr.LoadGuilds();
+    ///- Load and initialize DBScripts Engine
+    loader.Add("DB-Scripts Engine", []()
+    {
+        sScriptMgr.LoadDbScripts(DBS_ON_QUEST_START);       // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadDbScripts(DBS_ON_QUEST_END);         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadDbScripts(DBS_ON_SPELL);             // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadDbScripts(DBS_ON_GO_USE);            // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadDbScripts(DBS_ON_GOT_USE);           // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadDbScripts(DBS_ON_EVENT);             // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_DEATH);    // must be after load Creature/Gameobject(Template/Data)
+    }, { "Creature Data", "Gameobject Data", "Quests", "Item Templates", "Conditions" });
 
-    sLog.outString("Loading Groups...");
-    sObjectMgr.LoadGroups();
+    // script texts are added to the mangos strings and locale indexes the steps above read and fill
+    loader.Add("Scripts text locales", []() { sScriptMgr.LoadDbScriptStrings(); }, { "Gossip scripts", "Waypoint scripts", "DB-Scripts Engine", "Waypoints", "Localization strings" });
 
-    sLog.outString("Returning old mails...");
-    sObjectMgr.ReturnOrDeleteOldMails(false);
+    ///- Load and initialize EventAI Scripts
+    // false, texts and summons will be checked in LoadCreatureEventAI_Scripts
+    loader.Add("CreatureEventAI Texts", []() { sEventAIMgr.LoadCreatureEventAI_Texts(false); }, { "Scripts text locales" });
+    loader.Add("CreatureEventAI Summons", []() { sEventAIMgr.LoadCreatureEventAI_Summons(false); });
+    loader.Add("CreatureEventAI Scripts", []() { sEventAIMgr.LoadCreatureEventAI_Scripts(); }, { "CreatureEventAI Texts", "CreatureEventAI Summons", "Creature templates", "Quests", "Quest Area Triggers", "Conditions" });
 
-    sLog.outString("Loading GM tickets...");
-    sTicketMgr.LoadGMTickets();
+    loader.Run(getConfig(CONFIG_UINT32_STARTUP_LOADER_THREADS));
+    loader.PrintReport();
 
 #ifdef ENABLE_ELUNA
     if (sElunaConfig->IsElunaEnabled())
@@ -1367,31 +1308,6 @@ void World::SetInitialWorldSettings()
     }
 #endif /*ENABLE_ELUNA*/
 
-    ///- Load and initialize DBScripts Engine
-    sLog.outString("Loading DB-Scripts Engine...");
-    sScriptMgr.LoadDbScripts(DBS_ON_QUEST_START);           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadDbScripts(DBS_ON_QUEST_END);             // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadDbScripts(DBS_ON_SPELL);                 // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadDbScripts(DBS_ON_GO_USE);                // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadDbScripts(DBS_ON_GOT_USE);               // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadDbScripts(DBS_ON_EVENT);                 // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadDbScripts(DBS_ON_CREATURE_DEATH);        // must be after load Creature/Gameobject(Template/Data)
-    sLog.outString(">>> DB Scripts loaded");
-    sLog.outString();
-
-    sLog.outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sScriptMgr.LoadDbScriptStrings();
-
-    ///- Load and initialize EventAI Scripts
-    sLog.outString("Loading CreatureEventAI Texts...");
-    sEventAIMgr.LoadCreatureEventAI_Texts(false);           // false, will checked in LoadCreatureEventAI_Scripts
-
-    sLog.outString("Loading CreatureEventAI Summons...");
-    sEventAIMgr.LoadCreatureEventAI_Summons(false);         // false, will checked in LoadCreatureEventAI_Scripts
-
-    sLog.outString("Loading CreatureEventAI Scripts...");
-    sEventAIMgr.LoadCreatureEventAI_Scripts();
-
     sLog.outString("Initializing Scripts...");
 #ifdef ENABLE_SD3
     switch (sScriptMgr.LoadScriptLibrary("mangosscript"))
@@ -1763,6 +1679,10 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
     sMapMgr.Update(diff);
+
+    ///- Write the rows of all periodic player saves done in the map updates at once
+    CharacterDatabase.FlushBatchedStmts();
+
     sBattleGroundMgr.Update(diff);
     sLFGMgr.Update(diff);
     sOutdoorPvPMgr.Update(diff);
@@ -190,6 +190,12 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
     CONFIG_UINT32_NUMTHREADS,
+    CONFIG_UINT32_REGION_UPDATE_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_THREADS,
+    CONFIG_UINT32_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_UINT32_MMAP_PATH_CACHE_SIZE,
+    CONFIG_UINT32_TERRAIN_QUERY_CACHE_SIZE,
+    CONFIG_UINT32_STARTUP_LOADER_THREADS,
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY,
@@ -352,6 +358,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_MMAP_ENABLED,
+    CONFIG_BOOL_MMAP_BATCHED_PATHS,
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_AUTOPOOLING_MINING_ENABLE,
     CONFIG_BOOL_ENABLE_QUEST_TRACKER,
@@ -376,6 +383,8 @@ enum eConfigBoolValues
     // Recommended Or New Flag
     CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW_ENABLED,
     CONFIG_BOOL_REALM_RECOMMENDED_OR_NEW,
+    CONFIG_BOOL_PARALLEL_COMPRESSION,
+    CONFIG_BOOL_PLAYER_SAVE_BATCHED,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -578,6 +587,7 @@ class World
 
         /// Get configuration about force-loaded maps
         bool isForceLoadMap(uint32 id) const { return m_configForceLoadMapIds.find(id) != m_configForceLoadMapIds.end(); }
+        bool isRegionUpdateMap(uint32 id) const { return m_configRegionUpdateMapIds.find(id) != m_configRegionUpdateMapIds.end(); }
 
         /// Are we on a "Player versus Player" server?
         bool IsPvPRealm() { return (getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_PVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_RPPVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_FFA_PVP); }
@@ -727,6 +737,7 @@ class World
 
         // List of Maps that should be force-loaded on startup
         std::set<uint32> m_configForceLoadMapIds;
+        std::set<uint32> m_configRegionUpdateMapIds;
 };
 
 extern uint32 realmID;
@@ -31,6 +31,8 @@
 
 #include <Platform/Define.h>
 
+#include "RayPacket.h"
+
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
@@ -363,6 +365,257 @@ public:
         }
     }
 
+    /**
+     * @brief Intersects a packet of up to RAY_PACKET_SIZE rays with the BIH in one traversal.
+     *
+     * Rays close to each other, like the lines of sight from the targets of
+     * an area spell to its caster, mostly visit the same nodes. The packet
+     * descends into a node if any of its rays does, and the clip planes are
+     * tested for all rays at once. Lanes whose interval is empty skip the
+     * primitive tests.
+     *
+     * @tparam RayCallback Callback type for intersection, called as
+     *         callback(lane, ray, entry, maxDist[lane], stopAtFirst).
+     * @param rays The rays to intersect.
+     * @param count Number of rays, at most RAY_PACKET_SIZE.
+     * @param intersectCallback The callback to handle intersections.
+     * @param maxDist Maximum distance for intersection, one per ray.
+     * @param stopAtFirst Whether a ray stops at its first intersection.
+     */
+    template<typename RayCallback>
+    void intersectRayPacket(const Ray* rays, uint32 count, RayCallback& intersectCallback, float* maxDist, bool stopAtFirst = false) const
+    {
+        float orgs[3][RAY_PACKET_SIZE];
+        float invDirs[3][RAY_PACKET_SIZE];
+        float tMins[RAY_PACKET_SIZE];
+        float tMaxs[RAY_PACKET_SIZE];
+        float dists[RAY_PACKET_SIZE];
+        uint32 negDir[3] = { 0, 0, 0 };
+        uint32 all = 0;
+
+        for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+        {
+            // unused lanes get an empty interval
+            tMins[lane] = 1.f;
+            tMaxs[lane] = 0.f;
+            dists[lane] = 0.f;
+            for (int i = 0; i < 3; ++i)
+            {
+                orgs[i][lane] = lane < count ? rays[lane].origin()[i] : 0.f;
+                invDirs[i][lane] = lane < count ? rays[lane].invDirection()[i] : 0.f;
+                if (lane < count)
+                {
+                    negDir[i] |= (floatToRawIntBits(rays[lane].direction()[i]) >> 31) << lane;
+                }
+            }
+
+            if (lane >= count)
+            {
+                continue;
+            }
+
+            // clip against the bounds like intersectRay
+            Vector3 const& org = rays[lane].origin();
+            Vector3 const& dir = rays[lane].direction();
+            Vector3 const& invDir = rays[lane].invDirection();
+            float intervalMin = -1.f;
+            float intervalMax = -1.f;
+            bool miss = false;
+            for (int i = 0; i < 3 && !miss; ++i)
+            {
+                if (G3D::fuzzyNe(dir[i], 0.0f))
+                {
+                    float t1 = (bounds.low()[i] - org[i]) * invDir[i];
+                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
+                    if (t1 > t2)
+                    {
+                        std::swap(t1, t2);
+                    }
+                    if (t1 > intervalMin)
+                    {
+                        intervalMin = t1;
+                    }
+                    if (t2 < intervalMax || intervalMax < 0.f)
+                    {
+                        intervalMax = t2;
+                    }
+                    miss = intervalMax <= 0 || intervalMin >= maxDist[lane];
+                }
+            }
+
+            if (miss || intervalMin > intervalMax)
+            {
+                continue;
+            }
+
+            tMins[lane] = std::max(intervalMin, 0.f);
+            tMaxs[lane] = std::min(intervalMax, maxDist[lane]);
+            dists[lane] = maxDist[lane];
+            all |= 1 << lane;
+        }
+
+        if (!all)
+        {
+            return;
+        }
+
+        PacketFloat org[3];
+        PacketFloat invDir[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            org[i] = PacketFloat::load(orgs[i]);
+            invDir[i] = PacketFloat::load(invDirs[i]);
+        }
+
+        PacketFloat const posInf(std::numeric_limits<float>::infinity());
+        PacketFloat const negInf(-std::numeric_limits<float>::infinity());
+        PacketFloat tMin = PacketFloat::load(tMins);
+        PacketFloat tMax = PacketFloat::load(tMaxs);
+        uint32 done = 0;
+
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+
+        while (true)
+        {
+            while (true)
+            {
+                // rays shortened by a hit need not look further than the hit
+                tMax = pmin(tMax, PacketFloat::load(dists));
+                uint32 active = lessEqualMask(tMin, tMax) & all & ~done;
+                if (!active)
+                {
+                    break;
+                }
+
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = tn & (1 << 29);
+                int offset = tn & ~(7 << 29);
+
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node, left child ends at the left clip, right child starts at the right clip
+                        // the plane distances come first: a NaN from a ray parallel to the plane keeps the interval
+                        PacketFloat tl = (PacketFloat(intBitsToFloat(tree[node + 1])) - org[axis]) * invDir[axis];
+                        PacketFloat tr = (PacketFloat(intBitsToFloat(tree[node + 2])) - org[axis]) * invDir[axis];
+                        uint32 neg = negDir[axis];
+
+                        PacketFloat leftMin = pmax(blend(neg, tl, negInf), tMin);
+                        PacketFloat leftMax = pmin(blend(neg, posInf, tl), tMax);
+                        PacketFloat rightMin = pmax(blend(neg, negInf, tr), tMin);
+                        PacketFloat rightMax = pmin(blend(neg, tr, posInf), tMax);
+
+                        uint32 left = lessEqualMask(leftMin, leftMax) & active;
+                        uint32 right = lessEqualMask(rightMin, rightMax) & active;
+
+                        if (left && right)
+                        {
+                            // the first active ray decides which side is near
+                            bool leftFirst = !(neg & (active & (~active + 1)));
+                            stack[stackPos].node = leftFirst ? offset + 3 : offset;
+                            stack[stackPos].tnear = leftFirst ? rightMin : leftMin;
+                            stack[stackPos].tfar = leftFirst ? rightMax : leftMax;
+                            ++stackPos;
+
+                            node = leftFirst ? offset : offset + 3;
+                            tMin = leftFirst ? leftMin : rightMin;
+                            tMax = leftFirst ? leftMax : rightMax;
+                            continue;
+                        }
+
+                        if (left)
+                        {
+                            node = offset;
+                            tMin = leftMin;
+                            tMax = leftMax;
+                            continue;
+                        }
+
+                        if (right)
+                        {
+                            node = offset + 3;
+                            tMin = rightMin;
+                            tMax = rightMax;
+                            continue;
+                        }
+
+                        // all rays pass between the clip zones
+                        break;
+                    }
+                    else
+                    {
+                        // leaf - test some objects for the rays still inside
+                        int n = tree[node + 1];
+                        while (n > 0)
+                        {
+                            for (uint32 lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+                            {
+                                if (!(active & (1 << lane)) || (done & (1 << lane)))
+                                {
+                                    continue;
+                                }
+
+                                bool hit = intersectCallback(lane, rays[lane], objects[offset], dists[lane], stopAtFirst);
+                                if (stopAtFirst && hit)
+                                {
+                                    done |= 1 << lane;
+                                }
+                            }
+
+                            if (done == all)
+                            {
+                                for (uint32 lane = 0; lane < count; ++lane)
+                                {
+                                    maxDist[lane] = (all & (1 << lane)) ? dists[lane] : maxDist[lane];
+                                }
+                                return;
+                            }
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else
+                {
+                    if (axis > 2)
+                    {
+                        break;  // should not happen
+                    }
+
+                    PacketFloat tl = (PacketFloat(intBitsToFloat(tree[node + 1])) - org[axis]) * invDir[axis];
+                    PacketFloat tr = (PacketFloat(intBitsToFloat(tree[node + 2])) - org[axis]) * invDir[axis];
+                    uint32 neg = negDir[axis];
+                    node = offset;
+                    tMin = pmax(blend(neg, tr, tl), tMin);
+                    tMax = pmin(blend(neg, tl, tr), tMax);
+                    continue;
+                }
+            } // traversal loop
+
+            // stack is empty?
+            if (stackPos == 0)
+            {
+                break;
+            }
+
+            // move back up the stack
+            --stackPos;
+            node = stack[stackPos].node;
+            tMin = stack[stackPos].tnear;
+            tMax = stack[stackPos].tfar;
+        }
+
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            maxDist[lane] = (all & (1 << lane)) ? dists[lane] : maxDist[lane];
+        }
+    }
+
     /**
      * @brief Intersects a point with the BIH.
      *
@@ -509,6 +762,16 @@ protected:
         float tfar; /**< Far distance. */
     };
 
+    /**
+     * @brief Structure representing a stack node of a ray packet traversal.
+     */
+    struct PacketStackNode
+    {
+        uint32 node; /**< Node index. */
+        PacketFloat tnear; /**< Near distances, one per ray. */
+        PacketFloat tfar; /**< Far distances, one per ray. */
+    };
+
     /**
      * @brief Class for build statistics.
      */
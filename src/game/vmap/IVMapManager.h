@@ -28,6 +28,11 @@
 #include <string>
 #include <Platform/Define.h>
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -124,6 +129,16 @@ namespace VMAP
              * @return bool
              */
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
+            /**
+             * @brief Checks several lines of sight in one pass over the map tree
+             *
+             * @param pMapId
+             * @param from Start points, in world coordinates
+             * @param to End points, in world coordinates
+             * @param results Receives true for each line without obstacle
+             * @param count Number of lines
+             */
+            virtual void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) = 0;
             /**
              * @brief
              *
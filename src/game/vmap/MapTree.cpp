@@ -75,6 +75,50 @@ namespace VMAP
         bool hit; /**< Flag indicating if an intersection occurred. */
     };
 
+    /**
+     * @brief Callback class for ray packet intersection with models.
+     */
+    class MapRayPacketCallback
+    {
+    public:
+        MapRayPacketCallback(ModelInstance* val) : prims(val)
+        {
+            std::fill(hit, hit + RAY_PACKET_SIZE, false);
+        }
+
+        /**
+         * @brief Operator to handle the intersection of one ray of the packet.
+         *
+         * @param lane The index of the ray in the packet.
+         * @param ray The ray to intersect.
+         * @param entry The entry index.
+         * @param distance The distance to intersection.
+         * @param pStopAtFirstHit Whether to stop at the first hit.
+         * @return true if intersection occurs, false otherwise.
+         */
+        bool operator()(uint32 lane, const G3D::Ray& ray, uint32 entry, float& distance, bool pStopAtFirstHit = true)
+        {
+            bool result = prims[entry].intersectRay(ray, distance, pStopAtFirstHit);
+            if (result)
+            {
+                hit[lane] = true;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Checks if a ray of the packet hit something.
+         *
+         * @param lane The index of the ray in the packet.
+         * @return true if an intersection occurred, false otherwise.
+         */
+        bool didHit(uint32 lane) const { return hit[lane]; }
+
+    protected:
+        ModelInstance* prims; /**< Pointer to model instances. */
+        bool hit[RAY_PACKET_SIZE]; /**< Flags indicating if a ray hit something. */
+    };
+
     /**
      * @brief Callback class for area information.
      */
@@ -268,6 +312,62 @@ namespace VMAP
         return true;
     }
 
+    /**
+     * @brief Checks several lines of sight, tracing them in packets of RAY_PACKET_SIZE rays.
+     *
+     * @param pos1 The starting positions.
+     * @param pos2 The ending positions.
+     * @param results Receives true for each line without obstacle.
+     * @param count The number of lines.
+     */
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, bool* results, uint32 count) const
+    {
+        G3D::Ray rays[RAY_PACKET_SIZE];
+        float maxDist[RAY_PACKET_SIZE];
+        uint32 lines[RAY_PACKET_SIZE];
+        uint32 packetSize = 0;
+
+        for (uint32 i = 0; i <= count; ++i)
+        {
+            // trace when the packet is full or no line is left
+            if (packetSize == RAY_PACKET_SIZE || (i == count && packetSize))
+            {
+                MapRayPacketCallback intersectionCallBack(iTreeValues);
+                iTree.intersectRayPacket(rays, packetSize, intersectionCallBack, maxDist, true);
+                for (uint32 lane = 0; lane < packetSize; ++lane)
+                {
+                    results[lines[lane]] = !intersectionCallBack.didHit(lane);
+                }
+                packetSize = 0;
+            }
+
+            if (i == count)
+            {
+                break;
+            }
+
+            // same special cases as the single line check
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            if (dist == std::numeric_limits<float>::max() || dist == std::numeric_limits<float>::infinity())
+            {
+                results[i] = false;
+                continue;
+            }
+
+            MANGOS_ASSERT(dist < std::numeric_limits<float>::max());
+            results[i] = true;
+            if (dist < 1e-10f)
+            {
+                continue;
+            }
+
+            rays[packetSize] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i]) / dist);
+            maxDist[packetSize] = dist;
+            lines[packetSize] = i;
+            ++packetSize;
+        }
+    }
+
     /**
      * @brief Checks if an object is hit when moving from pos1 to pos2.
      *
@@ -145,6 +145,15 @@ namespace VMAP
          * @return bool True if there is a line of sight, false otherwise.
          */
         bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
+        /**
+         * @brief Checks several lines of sight, tracing them in packets of RAY_PACKET_SIZE rays.
+         *
+         * @param pos1 The starting positions.
+         * @param pos2 The ending positions.
+         * @param results Receives true for each line without obstacle.
+         * @param count The number of lines.
+         */
+        void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, bool* results, uint32 count) const;
         /**
          * @brief Checks if an object is hit when moving from pos1 to pos2.
          *
@@ -0,0 +1,168 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+
+#ifndef MANGOS_H_RAY_PACKET
+#define MANGOS_H_RAY_PACKET
+
+#include <Platform/Define.h>
+
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VMAP_RAY_PACKET_SSE
+#endif
+
+/// Number of rays traced together by BIH::intersectRayPacket.
+#define RAY_PACKET_SIZE 4
+
+/**
+ * @brief Four floats processed as one, one per ray of a packet.
+ *
+ * Maps to an SSE register where SSE2 is part of the target architecture
+ * (all x86-64 builds), plain arrays elsewhere.
+ */
+struct PacketFloat
+{
+#ifdef VMAP_RAY_PACKET_SSE
+    __m128 v;
+
+    PacketFloat() {}
+    explicit PacketFloat(__m128 val) : v(val) {}
+    explicit PacketFloat(float f) : v(_mm_set1_ps(f)) {}
+
+    static PacketFloat load(float const* f) { return PacketFloat(_mm_loadu_ps(f)); }
+    void store(float* f) const { _mm_storeu_ps(f, v); }
+
+    friend PacketFloat operator-(PacketFloat const& a, PacketFloat const& b) { return PacketFloat(_mm_sub_ps(a.v, b.v)); }
+    friend PacketFloat operator*(PacketFloat const& a, PacketFloat const& b) { return PacketFloat(_mm_mul_ps(a.v, b.v)); }
+    friend PacketFloat pmin(PacketFloat const& a, PacketFloat const& b) { return PacketFloat(_mm_min_ps(a.v, b.v)); }
+    friend PacketFloat pmax(PacketFloat const& a, PacketFloat const& b) { return PacketFloat(_mm_max_ps(a.v, b.v)); }
+
+    /// Bit i is set if lane i of a is less or equal to lane i of b.
+    friend uint32 lessEqualMask(PacketFloat const& a, PacketFloat const& b) { return uint32(_mm_movemask_ps(_mm_cmple_ps(a.v, b.v))); }
+
+    /// Lanes of a where bit i of mask is set, lanes of b elsewhere.
+    friend PacketFloat blend(uint32 mask, PacketFloat const& a, PacketFloat const& b)
+    {
+        __m128 m = _mm_castsi128_ps(_mm_set_epi32((mask & 8) ? -1 : 0, (mask & 4) ? -1 : 0, (mask & 2) ? -1 : 0, (mask & 1) ? -1 : 0));
+        return PacketFloat(_mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v)));
+    }
+#else
+    float v[RAY_PACKET_SIZE];
+
+    PacketFloat() {}
+    explicit PacketFloat(float f)
+    {
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            v[i] = f;
+        }
+    }
+
+    static PacketFloat load(float const* f)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = f[i];
+        }
+        return r;
+    }
+
+    void store(float* f) const
+    {
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            f[i] = v[i];
+        }
+    }
+
+    friend PacketFloat operator-(PacketFloat const& a, PacketFloat const& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = a.v[i] - b.v[i];
+        }
+        return r;
+    }
+
+    friend PacketFloat operator*(PacketFloat const& a, PacketFloat const& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = a.v[i] * b.v[i];
+        }
+        return r;
+    }
+
+    friend PacketFloat pmin(PacketFloat const& a, PacketFloat const& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+        }
+        return r;
+    }
+
+    friend PacketFloat pmax(PacketFloat const& a, PacketFloat const& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+        }
+        return r;
+    }
+
+    friend uint32 lessEqualMask(PacketFloat const& a, PacketFloat const& b)
+    {
+        uint32 mask = 0;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            if (a.v[i] <= b.v[i])
+            {
+                mask |= 1 << i;
+            }
+        }
+        return mask;
+    }
+
+    friend PacketFloat blend(uint32 mask, PacketFloat const& a, PacketFloat const& b)
+    {
+        PacketFloat r;
+        for (int i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            r.v[i] = (mask & (1 << i)) ? a.v[i] : b.v[i];
+        }
+        return r;
+    }
+#endif
+};
+
+#endif // MANGOS_H_RAY_PACKET
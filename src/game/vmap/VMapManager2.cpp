@@ -25,6 +25,8 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <algorithm>
 #include "VMapManager2.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
@@ -215,6 +217,41 @@ namespace VMAP
         return result;
     }
 
+    /**
+     * @brief Checks several lines of sight in one pass over the map tree.
+     *
+     * @param pMapId The map ID.
+     * @param from The start points, in world coordinates.
+     * @param to The end points, in world coordinates.
+     * @param results Receives true for each line without obstacle.
+     * @param count The number of lines.
+     */
+    void VMapManager2::isInLineOfSight(unsigned int pMapId, Vector3 const* from, Vector3 const* to, bool* results, uint32 count)
+    {
+        std::fill(results, results + count, true);
+
+        if (!count || !isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(pMapId, VMAP_DISABLE_LOS))
+        {
+            return;
+        }
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            return;
+        }
+
+        std::vector<Vector3> pos1(count);
+        std::vector<Vector3> pos2(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            pos1[i] = convertPositionToInternalRep(from[i].x, from[i].y, from[i].z);
+            pos2[i] = convertPositionToInternalRep(to[i].x, to[i].y, to[i].z);
+        }
+
+        instanceTree->second->isInLineOfSight(&pos1[0], &pos2[0], results, count);
+    }
+
     /**
      * @brief Gets the hit position of an object in the line of sight.
      *
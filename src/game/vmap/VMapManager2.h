@@ -191,6 +191,17 @@ namespace VMAP
          * @return bool True if there is a line of sight, false otherwise.
          */
         bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) override;
+
+        /**
+         * @brief Checks several lines of sight in one pass over the map tree.
+         *
+         * @param pMapId The map ID.
+         * @param from The start points, in world coordinates.
+         * @param to The end points, in world coordinates.
+         * @param results Receives true for each line without obstacle.
+         * @param count The number of lines.
+         */
+        void isInLineOfSight(unsigned int pMapId, G3D::Vector3 const* from, G3D::Vector3 const* to, bool* results, uint32 count) override;
         /**
          * @brief Gets the hit position of an object in the line of sight.
          *
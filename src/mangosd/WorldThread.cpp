@@ -84,6 +84,10 @@ int WorldThread::svc()
         uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
 
         sWorld.Update(diff);
+
+        // one write per socket for everything the tick produced
+        sWorldSocketMgr->FlushBatchedSockets();
+
         realPrevTime = realCurrTime;
 
         uint32 executionTimeDiff = getMSTimeDiff(realCurrTime, getMSTime());
@@ -105,6 +109,7 @@ int WorldThread::svc()
     }
     sWorld.KickAll();                                       // save and kick all players
     sWorld.UpdateSessions(1);                               // real players unload required UpdateSessions call
+    sWorldSocketMgr->FlushBatchedSockets();
     sWorldSocketMgr->StopNetwork();
 
     sMapMgr.UnloadAll();                                    // unload all grids (including locked in memory)
@@ -28,68 +28,65 @@
 
 #include "DBCFileLoader.h"
 
+#include <ace/Mem_Map.h>
+
 DBCFileLoader::DBCFileLoader()
 {
     data = NULL;
     fieldsOffset = NULL;
+    m_file = NULL;
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    delete[] data;
+    uint32 header[5];                                       // 'WDBC', records, fields, record size, string size
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-    {
-        return false;
-    }
+    data = NULL;
+    delete[] fieldsOffset;
+    fieldsOffset = NULL;
+    delete m_file;
 
-    if (fread(&header, 4, 1, f) != 1)                       // Number of records
+    // private writable mapping: records used in place can still be patched by the core, the file is never written
+    m_file = new ACE_Mem_Map();
+    if (m_file->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ | PROT_WRITE, MAP_PRIVATE) == -1)
     {
-        fclose(f);
+        delete m_file;
+        m_file = NULL;
         return false;
     }
 
-    EndianConvert(header);
-    if (header != 0x43424457)                               //'WDBC'
-    {
-        fclose(f);
-        return false;
-    }
+    // the mapping stays valid without the descriptor, the stores keep it for the whole run
+    m_file->close_handle();
+
+    unsigned char* file = static_cast<unsigned char*>(m_file->addr());
+    size_t fileSize = m_file->size();
 
-    if (fread(&recordCount, 4, 1, f) != 1)                  // Number of records
+    if (fileSize < sizeof(header))
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                   // Number of fields
+    memcpy(header, file, sizeof(header));
+    for (uint32 i = 0; i < 5; ++i)
     {
-        fclose(f);
-        return false;
+        EndianConvert(header[i]);
     }
 
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                   // Size of a record
+    if (header[0] != 0x43424457)                            //'WDBC'
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(recordSize);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
 
-    if (fread(&stringSize, 4, 1, f) != 1)                   // String size
+    if (fileSize - sizeof(header) < size_t(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(stringSize);
-
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -105,25 +102,24 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
         }
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = file + sizeof(header);
     stringTable = data + recordSize * recordCount;
-
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+    delete m_file;
     delete[] fieldsOffset;
 }
 
+ACE_Mem_Map* DBCFileLoader::ReleaseFile()
+{
+    ACE_Mem_Map* file = m_file;
+    m_file = NULL;
+    return file;
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -177,6 +173,28 @@ uint32 DBCFileLoader::GetFormatRecordSize(const char* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::IsDataInPlace(const char* format) const
+{
+#if MANGOS_ENDIAN == MANGOS_BIGENDIAN
+    return false;
+#else
+    if (strlen(format) != fieldCount || recordSize != fieldCount * sizeof(uint32))
+    {
+        return false;
+    }
+
+    for (uint32 x = 0; format[x]; ++x)
+    {
+        if (format[x] != DBC_FF_IND && format[x] != DBC_FF_INT && format[x] != DBC_FF_FLOAT)
+        {
+            return false;
+        }
+    }
+
+    return true;
+#endif
+}
+
 char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable)
 {
     /*
@@ -224,15 +242,27 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    if (IsDataInPlace(format))
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = reinterpret_cast<char*>(data + y * recordSize);
+        }
+
+        return reinterpret_cast<char*>(data);
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
     {
+        Record record = getRecord(y);
+
         if (i >= 0)
         {
-            indexTable[getRecord(y).getUInt(i)] = &dataTable[offset];
+            indexTable[record.getUInt(i)] = &dataTable[offset];
         }
         else
         {
@@ -244,16 +274,16 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
             switch (format[x])
             {
                 case DBC_FF_FLOAT:
-                    *((float*)(&dataTable[offset])) = getRecord(y).getFloat(x);
+                    *((float*)(&dataTable[offset])) = record.getFloat(x);
                     offset += sizeof(float);
                     break;
                 case DBC_FF_IND:
                 case DBC_FF_INT:
-                    *((uint32*)(&dataTable[offset])) = getRecord(y).getUInt(x);
+                    *((uint32*)(&dataTable[offset])) = record.getUInt(x);
                     offset += sizeof(uint32);
                     break;
                 case DBC_FF_BYTE:
-                    *((uint8*)(&dataTable[offset])) = getRecord(y).getUInt8(x);
+                    *((uint8*)(&dataTable[offset])) = record.getUInt8(x);
                     offset += sizeof(uint8);
                     break;
                 case DBC_FF_STRING:
@@ -277,16 +307,13 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
+void DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
 {
     if (strlen(format) != fieldCount)
     {
-        return NULL;
+        return;
     }
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -311,8 +338,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
                     {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (const char*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -330,6 +356,4 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
             }
         }
     }
-
-    return stringPool;
 }
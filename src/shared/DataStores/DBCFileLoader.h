@@ -29,6 +29,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 /**
  * @brief
  *
@@ -181,23 +183,41 @@ class DBCFileLoader
          * @return bool
          */
         bool IsLoaded() const {return (data != NULL);}
+        /**
+         * @brief Checks whether the records of the file already have the layout of the format.
+         *
+         * That is the case for formats of 4 byte integer and float fields only, on
+         * little endian hosts. AutoProduceData then indexes the mapped records
+         * instead of copying them.
+         *
+         * @param fmt
+         * @return bool
+         */
+        bool IsDataInPlace(const char* fmt) const;
         /**
          * @brief
          *
          * @param fmt
          * @param count
          * @param indexTable
-         * @return char
+         * @return char the record table, the mapped records if IsDataInPlace
          */
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable);
         /**
-         * @brief
+         * @brief Points the empty string fields of the records at the strings of the file.
+         *
+         * The strings are not copied, the mapping has to be kept with ReleaseFile.
          *
          * @param fmt
          * @param dataTable
-         * @return char
          */
-        char* AutoProduceStrings(const char* fmt, char* dataTable);
+        void AutoProduceStrings(const char* fmt, char* dataTable);
+        /**
+         * @brief Hands over the file mapping, which the loader then no longer unmaps.
+         *
+         * @return ACE_Mem_Map
+         */
+        ACE_Mem_Map* ReleaseFile();
         /**
          * Calculate and return the total amount of memory required by the types specified within the format string
          *
@@ -215,5 +235,6 @@ class DBCFileLoader
         uint32* fieldsOffset; /**< TODO */
         unsigned char* data; /**< TODO */
         unsigned char* stringTable; /**< TODO */
+        ACE_Mem_Map* m_file; /**< Private writable mapping of the file, data and stringTable point into it */
 };
 #endif
@@ -27,6 +27,10 @@
 
 #include "DBCFileLoader.h"
 
+#include <ace/Mem_Map.h>
+
+#include <cstring>
+
 template<class T>
 /**
  * @brief
@@ -38,14 +42,14 @@ class DBCStorage
          * @brief
          *
          */
-        typedef std::list<char*> StringPoolList;
+        typedef std::list<ACE_Mem_Map*> MappedFileList;
     public:
         /**
          * @brief
          *
          * @param f
          */
-        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL) { }
+        explicit DBCStorage(const char* f) : nCount(0), fieldCount(0), fmt(f), indexTable(NULL), m_dataTable(NULL), m_dataInPlace(false) { }
         /**
          * @brief
          *
@@ -109,10 +113,16 @@ class DBCStorage
             fieldCount = dbc.GetCols();
 
             // load raw non-string data
+            m_dataInPlace = dbc.IsDataInPlace(fmt);
             m_dataTable = (T*)dbc.AutoProduceData(fmt, nCount, (char**&)indexTable);
 
-            // load strings from dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            // load strings from dbc data, they stay in the mapped file
+            dbc.AutoProduceStrings(fmt, (char*)m_dataTable);
+
+            if (m_dataInPlace || strchr(fmt, DBC_FF_STRING))
+            {
+                m_mappedFileList.push_back(dbc.ReleaseFile());
+            }
 
             // error in dbc file at loading if NULL
             return indexTable != NULL;
@@ -158,7 +168,8 @@ class DBCStorage
             }
 
             // load strings from another locale dbc data
-            m_stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)m_dataTable));
+            dbc.AutoProduceStrings(fmt, (char*)m_dataTable);
+            m_mappedFileList.push_back(dbc.ReleaseFile());
 
             return true;
         }
@@ -182,13 +193,17 @@ class DBCStorage
 
             delete[]((char*)indexTable);
             indexTable = NULL;
-            delete[]((char*)m_dataTable);
+            if (!m_dataInPlace)
+            {
+                delete[]((char*)m_dataTable);
+            }
             m_dataTable = NULL;
+            m_dataInPlace = false;
 
-            while (!m_stringPoolList.empty())
+            while (!m_mappedFileList.empty())
             {
-                delete[] m_stringPoolList.front();
-                m_stringPoolList.pop_front();
+                delete m_mappedFileList.front();
+                m_mappedFileList.pop_front();
             }
             nCount = 0;
         }
@@ -213,9 +228,10 @@ class DBCStorage
         char const* fmt; /**< TODO */
         T** indexTable; /**< TODO */
         T* m_dataTable; /**< TODO */
+        bool m_dataInPlace; /**< m_dataTable points into a mapped file */
         std::map<uint32, T const*> data;
         bool loaded;
-        StringPoolList m_stringPoolList; /**< TODO */
+        MappedFileList m_mappedFileList; /**< Files the strings, and the records if m_dataInPlace, point into */
 };
 
 #endif
@@ -30,6 +30,8 @@
 #include <ctime>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <memory>
 
 #define MIN_CONNECTION_POOL_SIZE 1
@@ -120,13 +122,30 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+QueryResult* SqlConnection::QueryStmt(int nIndex, const SqlStmtParameters& id)
+{
+    if (nIndex == -1)
+    {
+        return NULL;
+    }
+
+    SqlPreparedStatement* pStmt = GetStmt(nIndex);
+    if (!pStmt)
+    {
+        return NULL;
+    }
+
+    pStmt->bind(id);
+    return pStmt->query();
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -171,12 +190,29 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
+    // create and initialize connections for async requests
+    if (nAsyncConns < MIN_CONNECTION_POOL_SIZE)
     {
-        return false;
+        nAsyncConns = MIN_CONNECTION_POOL_SIZE;
     }
+    else if (nAsyncConns > MAX_CONNECTION_POOL_SIZE)
+    {
+        nAsyncConns = MAX_CONNECTION_POOL_SIZE;
+    }
+
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
+
+    m_pAsyncConn = m_pAsyncConnections[0];
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -189,7 +225,13 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
+
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        delete m_pAsyncConnections[i];
+    }
+
+    m_pAsyncConnections.clear();
 
     m_pResultQueue = NULL;
     m_pAsyncConn = NULL;
@@ -205,31 +247,46 @@ void Database::StopServer()
 SqlDelayThread* Database::CreateDelayThread()
 {
     assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    return new SqlDelayThread(this, m_pAsyncConnections);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
+    // New delay threads for delay execute, one per async connection
+    m_threadBody = CreateDelayThread();              // will deleted with the last of m_delayThreads
     m_TransStorage = new ACE_TSS<Database::TransHelper>();
-    m_delayThread = new ACE_Based::Thread(m_threadBody);
+
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        m_delayThreads.push_back(new ACE_Based::Thread(m_threadBody));
+    }
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread)
+    if (!m_threadBody || m_delayThreads.empty())
     {
         return;
     }
 
+    FlushBatchedStmts();                                    // rows still waiting for the end of the tick
     m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
+
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+    {
+        m_delayThreads[i]->wait();                          // Wait for flush to DB
+    }
+
     delete m_TransStorage;
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = NULL;
+
+    for (size_t i = 0; i < m_delayThreads.size(); ++i)
+    {
+        delete m_delayThreads[i];                           // The last one also deletes m_threadBody
+    }
+
+    m_delayThreads.clear();
     m_threadBody = NULL;
     m_TransStorage=NULL;
 }
@@ -264,8 +321,24 @@ void Database::escape_string(std::string& str)
     delete[] buf;
 }
 
+namespace
+{
+    /// Query connection slot pinned by the current thread, -1 for round-robin selection.
+    thread_local int t_queryConnectionSlot = -1;
+}
+
+void Database::SetThreadQueryConnection(int slot)
+{
+    t_queryConnectionSlot = slot;
+}
+
 SqlConnection* Database::getQueryConnection()
 {
+    if (t_queryConnectionSlot >= 0)
+    {
+        return m_pQueryConnections[t_queryConnectionSlot % m_nQueryConnPoolSize];
+    }
+
     int nCount = 0;
 
     if (m_nQueryCounter == long(1 << 31))
@@ -284,8 +357,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (size_t i = 0; i < m_pAsyncConnections.size(); ++i)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnections[i]);
         delete guard->Query(sql);
     }
 
@@ -458,7 +532,7 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 orderKey)
 {
     if (!m_pAsyncConn)
     {
@@ -467,7 +541,7 @@ bool Database::BeginTransaction()
 
     // initiate transaction on current thread
     // currently we do not support queued transactions
-    (*m_TransStorage)->init();
+    (*m_TransStorage)->init(orderKey);
     return true;
 }
 
@@ -491,7 +565,8 @@ bool Database::CommitTransaction()
     }
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay((*m_TransStorage)->detach());
+    SqlTransaction* pTrans = (*m_TransStorage)->detach();
+    m_threadBody->Delay(pTrans, pTrans->GetOrderKey());
     return true;
 }
 
@@ -703,6 +778,153 @@ bool Database::DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* pa
     return _guard->ExecuteStmt(id.ID(), *params);
 }
 
+QueryResult* Database::QueryStmt(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    MANGOS_ASSERT(params);
+    std::shared_ptr<SqlStmtParameters> p(params);
+    SqlConnection::Lock _guard(getQueryConnection());
+    return _guard->QueryStmt(id.ID(), *params);
+}
+
+bool Database::ExecuteStmtBatched(const SqlStatementID& id, SqlStmtParameters* params)
+{
+    // nothing to merge with if requests are not sent asynchronously
+    if (!m_pAsyncConn || !m_bAllowAsyncTransactions)
+    {
+        return ExecuteStmt(id, params);
+    }
+
+    LOCK_GUARD _guard(m_batchGuard);
+    m_batchedStmts[id.ID()].push_back(params);
+    return true;
+}
+
+void Database::FlushBatchedStmts()
+{
+    // kept until the rows are queued, an unbatched save must not get ahead of them
+    LOCK_GUARD _flushGuard(m_flushGuard);
+
+    BatchedStmtMap batched;
+    {
+        LOCK_GUARD _guard(m_batchGuard);
+        if (m_batchedStmts.empty())
+        {
+            return;
+        }
+
+        batched.swap(m_batchedStmts);
+    }
+
+    // a caller may already have a transaction open on this thread, extend it then
+    bool ownTrans = !(*m_TransStorage)->get();
+    if (ownTrans)
+    {
+        BeginTransaction();
+    }
+
+    for (BatchedStmtMap::iterator itr = batched.begin(); itr != batched.end(); ++itr)
+    {
+        std::vector<SqlStmtParameters*>& rows = itr->second;
+
+        // split "INSERT ... VALUES (?, ?) ON DUPLICATE KEY UPDATE ..." around the tuple
+        std::string fmt = GetStmtString(itr->first);
+        std::string upper = fmt;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        size_t valuesPos = upper.find("VALUES");
+        size_t open = valuesPos != std::string::npos ? fmt.find('(', valuesPos) : std::string::npos;
+        size_t close = open != std::string::npos ? fmt.find(')', open) : std::string::npos;
+
+        if (close == std::string::npos)
+        {
+            sLog.outError("SQL: statement can not be batched, executing rows one by one: %s", fmt.c_str());
+
+            SqlStatementID id;
+            id.init(itr->first, rows.empty() ? 0 : rows[0]->boundParams());
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                ExecuteStmt(id, rows[i]);
+            }
+            continue;
+        }
+
+        std::string head = fmt.substr(0, open);
+        std::string tuple = fmt.substr(open, close - open + 1);
+        std::string tail = fmt.substr(close + 1);
+
+        std::string sql;
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            if (sql.empty())
+            {
+                sql = head;
+            }
+            else
+            {
+                sql += ',';
+            }
+
+            AppendBatchedRow(sql, tuple, *rows[i]);
+            delete rows[i];
+
+            // keep single requests reasonably small
+            if (sql.size() >= MAX_QUERY_LEN || i + 1 == rows.size())
+            {
+                sql += tail;
+                Execute(sql.c_str());
+                sql.clear();
+            }
+        }
+    }
+
+    if (ownTrans)
+    {
+        CommitTransaction();
+    }
+}
+
+void Database::AppendBatchedRow(std::string& sql, std::string const& tuple, SqlStmtParameters const& params)
+{
+    SqlStmtParameters::ParameterContainer const& args = params.params();
+    size_t nArg = 0;
+
+    for (size_t i = 0; i < tuple.size(); ++i)
+    {
+        if (tuple[i] != '?' || nArg >= args.size())
+        {
+            sql += tuple[i];
+            continue;
+        }
+
+        SqlStmtFieldData const& data = args[nArg++];
+        std::ostringstream fmt;
+        switch (data.type())
+        {
+            case FIELD_BOOL:    fmt << "'" << uint32(data.toBool()) << "'";     break;
+            case FIELD_UI8:     fmt << "'" << uint32(data.toUint8()) << "'";    break;
+            case FIELD_UI16:    fmt << "'" << uint32(data.toUint16()) << "'";   break;
+            case FIELD_UI32:    fmt << "'" << data.toUint32() << "'";           break;
+            case FIELD_UI64:    fmt << "'" << data.toUint64() << "'";           break;
+            case FIELD_I8:      fmt << "'" << int32(data.toInt8()) << "'";      break;
+            case FIELD_I16:     fmt << "'" << int32(data.toInt16()) << "'";     break;
+            case FIELD_I32:     fmt << "'" << data.toInt32() << "'";            break;
+            case FIELD_I64:     fmt << "'" << data.toInt64() << "'";            break;
+            // enough digits to read back the same value, the prepared path sends it binary
+            case FIELD_FLOAT:   fmt << "'" << std::setprecision(std::numeric_limits<float>::max_digits10) << data.toFloat() << "'";    break;
+            case FIELD_DOUBLE:  fmt << "'" << std::setprecision(std::numeric_limits<double>::max_digits10) << data.toDouble() << "'";  break;
+            case FIELD_STRING:
+            {
+                std::string tmp = data.toStr();
+                escape_string(tmp);
+                fmt << "'" << tmp << "'";
+                break;
+            }
+            case FIELD_NONE:    fmt << "NULL";                                  break;
+        }
+
+        sql += fmt.str();
+    }
+}
+
 SqlStatement Database::CreateStatement(SqlStatementID& index, const char* fmt)
 {
     int nId = -1;
@@ -762,10 +984,10 @@ Database::TransHelper::~TransHelper()
     reset();
 }
 
-SqlTransaction* Database::TransHelper::init()
+SqlTransaction* Database::TransHelper::init(uint32 orderKey)
 {
     MANGOS_ASSERT(!m_pTrans);   // if we will get a nested transaction request - we MUST fix code!!!
-    m_pTrans = new SqlTransaction;
+    m_pTrans = new SqlTransaction(orderKey);
     return m_pTrans;
 }
 
@@ -131,6 +131,14 @@ class SqlConnection
          * @return bool
          */
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        /**
+         * @brief run a SELECT prepared statement, result set is read with the binary protocol if supported
+         *
+         * @param nIndex
+         * @param id
+         * @return QueryResult
+         */
+        QueryResult* QueryStmt(int nIndex, const SqlStmtParameters& id);
 
         /**
          * @brief SqlConnection object lock
@@ -234,9 +242,10 @@ class Database
          *
          * @param infoString
          * @param nConns
+         * @param nAsyncConns connections (and threads) for async requests
          * @return bool
          */
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1);
         /**
          * @brief start worker thread for async DB request execution
          *
@@ -550,11 +559,16 @@ class Database
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
         /**
-         * @brief
+         * @brief start a transaction on the current thread
          *
+         * Async transactions with the same order key are executed in commit
+         * order, those with different keys may run concurrently. Key 0 orders
+         * the transaction against all other async requests.
+         *
+         * @param orderKey e.g. the guid of the saved character
          * @return bool
          */
-        bool BeginTransaction();
+        bool BeginTransaction(uint32 orderKey = 0);
         /**
          * @brief
          *
@@ -590,6 +604,19 @@ class Database
          * @return std::string
          */
         std::string GetStmtString(const int stmtId) const;
+        /**
+         * @brief send all rows queued with SqlStatement::ExecuteBatched()
+         *
+         * Rows of the same statement are merged into multi-row requests
+         * (the VALUES tuple of the statement is repeated), and everything is
+         * sent in one transaction with order key 0. If the calling thread
+         * has a transaction open the requests are added to it instead.
+         *
+         * A flush returns only after the rows it took are queued, so a save
+         * flushing before queueing its own requests is always sent after
+         * them, also when another thread did the flush.
+         */
+        void FlushBatchedStmts();
 
         /**
          * @brief
@@ -616,6 +643,16 @@ class Database
          */
         virtual void ThreadEnd();
 
+        /**
+         * @brief pins the query connection used by the calling thread, in every Database object
+         *
+         * Lets threads querying in parallel use separate connections instead of
+         * the round-robin pick, which may hand two of them the same connection.
+         *
+         * @param slot index into the query connection pool, taken modulo its size; -1 restores round-robin selection
+         */
+        static void SetThreadQueryConnection(int slot);
+
         /**
          * @brief set database-wide result queue. also we should use object-bases and not thread-based result queues
          *
@@ -659,7 +696,7 @@ class Database
          */
         Database() :
             m_TransStorage(NULL),m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
-            m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
+            m_threadBody(NULL), m_bAllowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -705,9 +742,10 @@ class Database
                 /**
                  * @brief initializes new SqlTransaction object
                  *
+                 * @param orderKey
                  * @return SqlTransaction
                  */
-                SqlTransaction* init();
+                SqlTransaction* init(uint32 orderKey);
                 /**
                  * @brief gets pointer on current transaction object. Returns NULL if transaction was not initiated
                  *
@@ -773,6 +811,30 @@ class Database
          * @return bool
          */
         bool DirectExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        /**
+         * @brief synchronous SELECT through a prepared statement on one of the query connections
+         *
+         * @param id
+         * @param params
+         * @return QueryResult
+         */
+        QueryResult* QueryStmt(const SqlStatementID& id, SqlStmtParameters* params);
+        /**
+         * @brief queue the bound parameters until the next FlushBatchedStmts()
+         *
+         * @param id
+         * @param params
+         * @return bool
+         */
+        bool ExecuteStmtBatched(const SqlStatementID& id, SqlStmtParameters* params);
+        /**
+         * @brief append one VALUES tuple of a batched statement with its parameters as SQL literals
+         *
+         * @param sql
+         * @param tuple
+         * @param params
+         */
+        void AppendBatchedRow(std::string& sql, std::string const& tuple, SqlStmtParameters const& params);
 
         // connection helper counters
         int m_nQueryConnPoolSize;                               /**< current size of query connection pool */
@@ -785,12 +847,15 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections; /**< TODO */
 
-        // only one single DB connection for transactions
+        // first async connection, also used for direct transactions
         SqlConnection* m_pAsyncConn; /**< TODO */
+        SqlConnectionContainer m_pAsyncConnections;         /**< DB connections for async requests, one per delay thread */
+
+        typedef std::vector<ACE_Based::Thread*> DelayThreadContainer;
 
         SqlResultQueue*     m_pResultQueue;                 /**< Transaction queues from diff. threads */
-        SqlDelayThread*     m_threadBody;                   /**< Pointer to delay sql executer (owned by m_delayThread) */
-        ACE_Based::Thread*  m_delayThread;                  /**< Pointer to executer thread */
+        SqlDelayThread*     m_threadBody;                   /**< Pointer to delay sql executer (owned by m_delayThreads) */
+        DelayThreadContainer m_delayThreads;                /**< Executer threads, one per async connection */
 
         bool m_bAllowAsyncTransactions;                     /**< flag which specifies if async transactions are enabled */
 
@@ -817,6 +882,11 @@ class Database
 
         int m_iStmtIndex; /**< TODO */
 
+        typedef std::map<int, std::vector<SqlStmtParameters*> > BatchedStmtMap;
+        BatchedStmtMap m_batchedStmts;                      /**< statement id -> queued rows */
+        LOCK_TYPE m_batchGuard;                             /**< guards m_batchedStmts, saves run in map threads */
+        LOCK_TYPE m_flushGuard;                             /**< held by FlushBatchedStmts until its transaction is queued */
+
     private:
 
         bool m_logSQL; /**< TODO */
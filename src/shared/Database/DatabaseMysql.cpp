@@ -31,6 +31,8 @@
 #include "DatabaseEnv.h"
 #include "Utilities/Timer.h"
 
+#include <type_traits>
+
 size_t DatabaseMysql::db_count = 0;
 
 void DatabaseMysql::ThreadStart()
@@ -418,7 +420,10 @@ bool MySqlPreparedStatement::prepare()
         /* Get total columns in the query */
         m_nColumns = mysql_num_fields(m_pResultMetadata);
 
-        // bind output buffers
+        // output buffers are bound per result set in QueryResultMysqlStmt, let
+        // mysql_stmt_store_result() compute the longest value of every column for them
+        std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type updateMaxLength = 1;   // bool or my_bool, depends on client library
+        mysql_stmt_attr_set(m_stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
     }
 
     m_bPrepared = true;
@@ -520,6 +525,52 @@ bool MySqlPreparedStatement::execute()
     return true;
 }
 
+QueryResult* MySqlPreparedStatement::query()
+{
+    if (!isPrepared() || !isQuery())
+    {
+        return NULL;
+    }
+
+    uint32 _s = getMSTime();
+
+    if (mysql_stmt_execute(m_stmt))
+    {
+        sLog.outError("SQL: can not execute '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        return NULL;
+    }
+
+    if (mysql_stmt_store_result(m_stmt))
+    {
+        sLog.outError("SQL: can not store result of '%s'", m_szFmt.c_str());
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(m_stmt));
+        mysql_stmt_free_result(m_stmt);
+        return NULL;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL STMT: %s", getMSTimeDiff(_s, getMSTime()), m_szFmt.c_str());
+
+    uint64 rowCount = mysql_stmt_num_rows(m_stmt);
+    QueryResultMysqlStmt* queryResult = NULL;
+    if (rowCount)
+    {
+        // all rows are copied out, the statement can be executed again right after
+        queryResult = new QueryResultMysqlStmt(m_stmt, m_pResultMetadata, rowCount, m_nColumns);
+    }
+
+    mysql_stmt_free_result(m_stmt);
+
+    // same contract as MySQLConnection::Query(): no rows - no result, first row is current
+    if (queryResult && !queryResult->NextRow())
+    {
+        delete queryResult;
+        queryResult = NULL;
+    }
+
+    return queryResult;
+}
+
 enum_field_types MySqlPreparedStatement::ToMySQLType(const SqlStmtFieldData& data, bool& bUnsigned)
 {
     bUnsigned = 0;
@@ -80,6 +80,13 @@ class MySqlPreparedStatement : public SqlPreparedStatement
          */
         bool execute() override;
 
+        /**
+         * @brief execute SELECT statement, the result set is read through the binary protocol
+         *
+         * @return QueryResult
+         */
+        QueryResult* query() override;
+
     protected:
         /**
          * @brief bind parameters
@@ -22,4 +22,24 @@
  * and lore are copyrighted by Blizzard Entertainment, Inc.
  */
 
-//#include "DatabaseEnv.h"
+#include "Field.h"
+
+const char* Field::FormatBinary() const
+{
+    switch (mStorage)
+    {
+        case STORAGE_INT64:
+            snprintf(mText, sizeof(mText), SI64FMTD, mBinary.i64);
+            break;
+        case STORAGE_UINT64:
+            snprintf(mText, sizeof(mText), UI64FMTD, mBinary.ui64);
+            break;
+        case STORAGE_DOUBLE:
+            snprintf(mText, sizeof(mText), "%.17g", mBinary.d);
+            break;
+        default:
+            return mValue;
+    }
+
+    return mText;
+}
@@ -53,14 +53,14 @@ class Field
          * @brief
          *
          */
-        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL) {}
+        Field() : mValue(NULL), mType(MYSQL_TYPE_NULL), mStorage(STORAGE_TEXT) { mBinary.i64 = 0; }
         /**
          * @brief
          *
          * @param value
          * @param type
          */
-        Field(const char* value, enum_field_types type) : mValue(value), mType(type) {}
+        Field(const char* value, enum_field_types type) : mValue(value), mType(type), mStorage(STORAGE_TEXT) { mBinary.i64 = 0; }
 
         /**
          * @brief
@@ -79,14 +79,14 @@ class Field
          *
          * @return bool
          */
-        bool IsNULL() const { return mValue == NULL; }
+        bool IsNULL() const { return mStorage == STORAGE_TEXT && mValue == NULL; }
 
         /**
          * @brief
          *
          * @return const char
          */
-        const char* GetString() const { return mValue; }
+        const char* GetString() const { return mStorage == STORAGE_TEXT ? mValue : FormatBinary(); }
         /**
          * @brief
          *
@@ -94,62 +94,63 @@ class Field
          */
         std::string GetCppString() const
         {
-            return mValue ? mValue : "";                    // std::string s = 0 have undefine result in C++
+            const char* value = GetString();
+            return value ? value : "";                      // std::string s = 0 have undefine result in C++
         }
         /**
          * @brief
          *
          * @return float
          */
-        float GetFloat() const { return mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
+        float GetFloat() const { return mStorage != STORAGE_TEXT ? GetBinary<float>() : mValue ? static_cast<float>(atof(mValue)) : 0.0f; }
         /**
          * @brief
          *
          * @return bool
          */
-        bool GetBool() const { return mValue ? atoi(mValue) > 0 : false; }
+        bool GetBool() const { return mStorage != STORAGE_TEXT ? GetBinary<int64>() > 0 : mValue ? atoi(mValue) > 0 : false; }
         /**
         * @brief
         *
         * @return double
         */
-        double GetDouble() const { return mValue ? static_cast<double>(atof(mValue)) : 0.0f; }
+        double GetDouble() const { return mStorage != STORAGE_TEXT ? GetBinary<double>() : mValue ? static_cast<double>(atof(mValue)) : 0.0f; }
         /**
         * @brief
         *
         * @return int8
         */
-        int8 GetInt8() const { return mValue ? static_cast<int8>(atol(mValue)) : int8(0); }
+        int8 GetInt8() const { return mStorage != STORAGE_TEXT ? GetBinary<int8>() : mValue ? static_cast<int8>(atol(mValue)) : int8(0); }
         /**
          * @brief
          *
          * @return int32
          */
-        int32 GetInt32() const { return mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
+        int32 GetInt32() const { return mStorage != STORAGE_TEXT ? GetBinary<int32>() : mValue ? static_cast<int32>(atol(mValue)) : int32(0); }
         /**
          * @brief
          *
          * @return uint8
          */
-        uint8 GetUInt8() const { return mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
+        uint8 GetUInt8() const { return mStorage != STORAGE_TEXT ? GetBinary<uint8>() : mValue ? static_cast<uint8>(atol(mValue)) : uint8(0); }
         /**
          * @brief
          *
          * @return uint16
          */
-        uint16 GetUInt16() const { return mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
+        uint16 GetUInt16() const { return mStorage != STORAGE_TEXT ? GetBinary<uint16>() : mValue ? static_cast<uint16>(atol(mValue)) : uint16(0); }
         /**
          * @brief
          *
          * @return int16
          */
-        int16 GetInt16() const { return mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
+        int16 GetInt16() const { return mStorage != STORAGE_TEXT ? GetBinary<int16>() : mValue ? static_cast<int16>(atol(mValue)) : int16(0); }
         /**
          * @brief
          *
          * @return uint32
          */
-        uint32 GetUInt32() const { return mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
+        uint32 GetUInt32() const { return mStorage != STORAGE_TEXT ? GetBinary<uint32>() : mValue ? static_cast<uint32>(atol(mValue)) : uint32(0); }
         /**
          * @brief
          *
@@ -157,6 +158,11 @@ class Field
          */
         uint64 GetUInt64() const
         {
+            if (mStorage != STORAGE_TEXT)
+            {
+                return GetBinary<uint64>();
+            }
+
             uint64 value = 0;
             if (!mValue || sscanf(mValue, UI64FMTD, &value) == -1)
             {
@@ -172,6 +178,11 @@ class Field
         */
         uint64 GetInt64() const
         {
+            if (mStorage != STORAGE_TEXT)
+            {
+                return GetBinary<int64>();
+            }
+
             int64 value = 0;
             if (!mValue || sscanf(mValue, SI64FMTD, &value) == -1)
             {
@@ -195,7 +206,26 @@ class Field
          *
          * @param value
          */
-        void SetValue(const char* value) { mValue = value; }
+        void SetValue(const char* value) { mValue = value; mStorage = STORAGE_TEXT; }
+
+        /**
+         * @brief store an already decoded integer column (binary protocol results)
+         *
+         * @param value
+         */
+        void SetInt64Value(int64 value) { mValue = NULL; mBinary.i64 = value; mStorage = STORAGE_INT64; }
+        /**
+         * @brief store an already decoded unsigned integer column (binary protocol results)
+         *
+         * @param value
+         */
+        void SetUInt64Value(uint64 value) { mValue = NULL; mBinary.ui64 = value; mStorage = STORAGE_UINT64; }
+        /**
+         * @brief store an already decoded floating point column (binary protocol results)
+         *
+         * @param value
+         */
+        void SetDoubleValue(double value) { mValue = NULL; mBinary.d = value; mStorage = STORAGE_DOUBLE; }
 
     private:
         /**
@@ -212,7 +242,52 @@ class Field
          */
         Field& operator=(Field const&);
 
+        /**
+         * @brief where the value of the field lives
+         *
+         * Text protocol results only carry the string returned by the client library,
+         * binary protocol (prepared statement) results keep numeric columns decoded.
+         */
+        enum StorageType
+        {
+            STORAGE_TEXT    = 0,
+            STORAGE_INT64   = 1,
+            STORAGE_UINT64  = 2,
+            STORAGE_DOUBLE  = 3
+        };
+
+        /**
+         * @brief convert a decoded numeric value to the requested type
+         *
+         * @return T
+         */
+        template<typename T>
+        T GetBinary() const
+        {
+            switch (mStorage)
+            {
+                case STORAGE_INT64:  return static_cast<T>(mBinary.i64);
+                case STORAGE_UINT64: return static_cast<T>(mBinary.ui64);
+                default:             return static_cast<T>(mBinary.d);
+            }
+        }
+
+        /**
+         * @brief text representation of a decoded numeric value, built on demand
+         *
+         * @return const char
+         */
+        const char* FormatBinary() const;
+
         const char* mValue; /**< TODO */
         enum_field_types mType; /**< TODO */
+        StorageType mStorage; /**< text or decoded binary value */
+        union
+        {
+            int64 i64;
+            uint64 ui64;
+            double d;
+        } mBinary; /**< decoded value for binary protocol results */
+        mutable char mText[32]; /**< buffer for GetString() on decoded values */
 };
 #endif
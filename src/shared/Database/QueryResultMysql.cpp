@@ -27,6 +27,10 @@
 #include "DatabaseEnv.h"
 #include "Utilities/Errors.h"
 
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
     QueryResult(rowCount, fieldCount), mResult(result)
 {
@@ -80,6 +84,183 @@ void QueryResultMysql::EndQuery()
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// bool in MySQL 8 client headers, my_bool (char) in older and MariaDB ones
+typedef std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type MySqlBool;
+
+QueryResultMysqlStmt::QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount) :
+    QueryResult(rowCount, fieldCount), mRows(NULL), mStrings(NULL), mNextRow(0)
+{
+    MYSQL_FIELD* fields = mysql_fetch_fields(metadata);
+
+    std::vector<MYSQL_BIND> binds(mFieldCount);
+    std::vector<uint64> numbers(mFieldCount);
+    std::vector<unsigned long> lengths(mFieldCount);
+    std::vector<size_t> offsets(mFieldCount);
+    std::unique_ptr<MySqlBool[]> nulls(new MySqlBool[mFieldCount]());
+
+    // integers and floats are decoded by the client library, everything else is read as string;
+    // max_length is filled by mysql_stmt_store_result() (STMT_ATTR_UPDATE_MAX_LENGTH)
+    size_t rowStringSize = 0;
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        MYSQL_BIND& bind = binds[i];
+        memset(&bind, 0, sizeof(MYSQL_BIND));
+        bind.is_null = &nulls[i];
+        bind.length = &lengths[i];
+
+        switch (fields[i].type)
+        {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_LONG:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONGLONG:
+                bind.buffer_type = MYSQL_TYPE_LONGLONG;
+                bind.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                bind.buffer = &numbers[i];
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                bind.buffer_type = MYSQL_TYPE_DOUBLE;
+                bind.buffer = &numbers[i];
+                break;
+            default:
+            {
+                unsigned long size = fields[i].max_length;
+                // temporal and decimal values are converted to text, leave room for the longest representation
+                if (!IS_LONGDATA(fields[i].type) && fields[i].type != MYSQL_TYPE_VARCHAR)
+                {
+                    size = std::max(size, 64UL);
+                }
+
+                bind.buffer_type = MYSQL_TYPE_STRING;
+                bind.buffer_length = size + 1;
+                offsets[i] = rowStringSize;
+                rowStringSize += size + 1;
+                break;
+            }
+        }
+    }
+
+    std::vector<char> scratch(rowStringSize);
+    for (uint32 i = 0; i < mFieldCount; ++i)
+    {
+        if (binds[i].buffer_type == MYSQL_TYPE_STRING)
+        {
+            binds[i].buffer = &scratch[offsets[i]];
+        }
+    }
+
+    if (mysql_stmt_bind_result(stmt, &binds[0]))
+    {
+        sLog.outError("SQL ERROR: mysql_stmt_bind_result() failed");
+        sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+        mRowCount = 0;
+        return;
+    }
+
+    mRows = new Field[mRowCount * mFieldCount];
+    if (rowStringSize)
+    {
+        mStrings = new char[mRowCount * rowStringSize];
+    }
+
+    uint64 row = 0;
+    for (; row < mRowCount; ++row)
+    {
+        int rc = mysql_stmt_fetch(stmt);
+        if (rc == MYSQL_NO_DATA)
+        {
+            break;
+        }
+
+        if (rc == 1)
+        {
+            sLog.outError("SQL ERROR: mysql_stmt_fetch() failed");
+            sLog.outError("SQL ERROR: %s", mysql_stmt_error(stmt));
+            break;
+        }
+
+        Field* rowFields = mRows + row * mFieldCount;
+        char* rowStrings = mStrings + row * rowStringSize;
+        for (uint32 i = 0; i < mFieldCount; ++i)
+        {
+            Field& field = rowFields[i];
+            field.SetType(fields[i].type);
+
+            if (nulls[i])
+            {
+                field.SetValue(NULL);
+                continue;
+            }
+
+            switch (binds[i].buffer_type)
+            {
+                case MYSQL_TYPE_LONGLONG:
+                    if (binds[i].is_unsigned)
+                    {
+                        field.SetUInt64Value(numbers[i]);
+                    }
+                    else
+                    {
+                        field.SetInt64Value(int64(numbers[i]));
+                    }
+                    break;
+                case MYSQL_TYPE_DOUBLE:
+                {
+                    double value;
+                    memcpy(&value, &numbers[i], sizeof(double));
+                    field.SetDoubleValue(value);
+                    break;
+                }
+                default:
+                {
+                    // truncated values (rc == MYSQL_DATA_TRUNCATED) keep what fit into the buffer
+                    size_t length = std::min<size_t>(lengths[i], binds[i].buffer_length - 1);
+                    char* value = rowStrings + offsets[i];
+                    memcpy(value, &scratch[offsets[i]], length);
+                    value[length] = '\0';
+                    field.SetValue(value);
+                    break;
+                }
+            }
+        }
+    }
+
+    // the server may have sent less rows than announced if the fetch failed
+    mRowCount = row;
+}
+
+QueryResultMysqlStmt::~QueryResultMysqlStmt()
+{
+    EndQuery();
+}
+
+bool QueryResultMysqlStmt::NextRow()
+{
+    if (mNextRow >= mRowCount)
+    {
+        EndQuery();
+        return false;
+    }
+
+    mCurrentRow = mRows + mNextRow * mFieldCount;
+    ++mNextRow;
+    return true;
+}
+
+void QueryResultMysqlStmt::EndQuery()
+{
+    mCurrentRow = NULL;
+
+    delete[] mRows;
+    mRows = NULL;
+
+    delete[] mStrings;
+    mStrings = NULL;
+}
+
 Field::SimpleDataTypes QueryResultMysql::GetSimpleType(enum_field_types type)
 {
     switch (type)
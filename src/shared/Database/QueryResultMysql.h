@@ -82,6 +82,51 @@ class QueryResultMysql : public QueryResult
 
         MYSQL_RES* mResult; /**< TODO */
 };
+
+/**
+ * @brief result of a prepared statement read through the binary protocol
+ *
+ * The whole result set is fetched while the statement is still owned by the caller,
+ * so the statement can be reused right away. Integer and floating point columns are
+ * stored already decoded in the fields, strings are copied into one buffer.
+ */
+class QueryResultMysqlStmt : public QueryResult
+{
+    public:
+        /**
+         * @brief fetch all rows of an executed and stored statement
+         *
+         * @param stmt
+         * @param metadata
+         * @param rowCount
+         * @param fieldCount
+         */
+        QueryResultMysqlStmt(MYSQL_STMT* stmt, MYSQL_RES* metadata, uint64 rowCount, uint32 fieldCount);
+
+        /**
+         * @brief
+         *
+         */
+        ~QueryResultMysqlStmt();
+
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool NextRow() override;
+
+    private:
+        /**
+         * @brief
+         *
+         */
+        void EndQuery();
+
+        Field* mRows; /**< mRowCount * mFieldCount fields */
+        char* mStrings; /**< storage for all string columns */
+        uint64 mNextRow; /**< index of the row returned by the next NextRow() */
+};
 #endif
 
 #endif
@@ -720,6 +720,25 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char* src, char*& dst);
 
     private:
+        /**
+         * @brief Fills the storage from its snapshot, see SQLStorageSnapshot.
+         *
+         * @param store
+         * @param recordSize
+         * @param stamp
+         * @return bool False if there is no usable snapshot.
+         */
+        bool LoadSnapshot(StorageClass& store, uint32 recordSize, uint64 stamp);
+        /**
+         * @brief Writes the snapshot of the just loaded records.
+         *
+         * @param store
+         * @param recordIds Ids of the records, in load order.
+         * @param recordSize
+         * @param stamp
+         */
+        void SaveSnapshot(StorageClass const& store, std::vector<uint32> const& recordIds, uint32 recordSize, uint64 stamp);
+
         template<class V>
         /**
          * @brief
@@ -28,6 +28,7 @@
 #include "Utilities/ProgressBar.h"
 #include "Log/Log.h"
 #include "DataStores/DBCFileLoader.h"
+#include "SQLStorageSnapshot.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>
@@ -280,6 +281,48 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     uint32 recordsize = 0;
     delete result;
 
+    // get struct size
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case DBC_FF_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case DBC_FF_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_INT:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_STRING:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_NA:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+
+    uint64 stamp = 0;
+    bool useSnapshot = !SQLStorageSnapshot::GetDirectory().empty() &&
+                       SQLStorageSnapshot::GetStamp(store.GetTableName(), store.GetSrcFormat(), store.GetDstFormat(), recordsize, stamp);
+
+    if (useSnapshot && LoadSnapshot(store, recordsize, stamp))
+    {
+        return;
+    }
+
     result = WorldDatabase.PQuery("SELECT COUNT(*) FROM `%s`", store.GetTableName());
     if (result)
     {
@@ -314,43 +357,15 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case DBC_FF_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case DBC_FF_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_INT:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_STRING:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_NA:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_IND:
-            case DBC_FF_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> recordIds;
+    if (useSnapshot)
+    {
+        recordIds.reserve(recordCount);
+    }
+
     BarGoLink bar(recordCount);
     do
     {
@@ -358,7 +373,12 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+        uint32 offset = 0;
+
+        if (useSnapshot)
+        {
+            recordIds.push_back(fields[0].GetUInt32());
+        }
 
         // dependend on dest-size
         // iterate two indexes: x over dest, y over source
@@ -409,6 +429,113 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    if (useSnapshot)
+    {
+        SaveSnapshot(store, recordIds, recordsize, stamp);
+    }
+}
+
+template<class DerivedLoader, class StorageClass>
+bool SQLStorageLoaderBase<DerivedLoader, StorageClass>::LoadSnapshot(StorageClass& store, uint32 recordSize, uint64 stamp)
+{
+    std::vector<uint32> strings;
+    std::vector<uint32> defaults;
+    SQLStorageSnapshot::GetPointerFields(store.GetDstFormat(), strings, defaults);
+
+    SQLStorageSnapshot::Reader reader;
+    if (!reader.Open(store.GetTableName(), stamp, recordSize, strings) || !reader.GetRecordCount())
+    {
+        return false;
+    }
+
+    // default filled pointers are not saved, they are filled again like a load from the DB does
+    std::vector<uint32> defaultFields;
+    for (uint32 x = 0; store.GetDstFormat()[x]; ++x)
+    {
+        if (store.GetDstFormat(x) == DBC_FF_NA_POINTER)
+        {
+            defaultFields.push_back(x);
+        }
+    }
+
+    DerivedLoader* subclass = (static_cast<DerivedLoader*>(this));
+    store.prepareToLoad(reader.GetMaxEntry(), reader.GetRecordCount(), recordSize);
+
+    // records are copied, the callers fix them in place and Free() deletes the strings
+    BarGoLink bar(reader.GetRecordCount());
+    for (uint32 i = 0; i < reader.GetRecordCount(); ++i)
+    {
+        bar.step();
+
+        char* record = store.createRecord(reader.GetRecordId(i));
+        memcpy(record, reader.GetRecord(i), recordSize);
+
+        for (std::vector<uint32>::const_iterator itr = strings.begin(); itr != strings.end(); ++itr)
+        {
+            size_t ref;
+            memcpy(&ref, record + *itr, sizeof(ref));
+
+            char const* src = reader.GetString(ref);
+            size_t length = src ? strlen(src) + 1 : 1;
+            char* dst = new char[length];
+            if (src)
+            {
+                memcpy(dst, src, length);
+            }
+            else
+            {
+                dst[0] = '\0';
+            }
+
+            memcpy(record + *itr, &dst, sizeof(dst));
+        }
+
+        for (uint32 d = 0; d < defaults.size(); ++d)
+        {
+            subclass->default_fill_to_str(defaultFields[d], NULL, *((char**)(record + defaults[d])));
+        }
+    }
+
+    sLog.outString("Loaded %u records of %s from its snapshot", reader.GetRecordCount(), store.GetTableName());
+    return true;
+}
+
+template<class DerivedLoader, class StorageClass>
+void SQLStorageLoaderBase<DerivedLoader, StorageClass>::SaveSnapshot(StorageClass const& store, std::vector<uint32> const& recordIds, uint32 recordSize, uint64 stamp)
+{
+    std::vector<uint32> strings;
+    std::vector<uint32> defaults;
+    SQLStorageSnapshot::GetPointerFields(store.GetDstFormat(), strings, defaults);
+
+    SQLStorageSnapshot::Writer writer(store.GetTableName(), stamp, store.GetMaxEntry(), recordSize);
+    std::vector<char> record(recordSize);
+
+    for (uint32 i = 0; i < recordIds.size(); ++i)
+    {
+        memcpy(&record[0], store.m_data + size_t(i) * recordSize, recordSize);
+
+        for (std::vector<uint32>::const_iterator itr = strings.begin(); itr != strings.end(); ++itr)
+        {
+            char const* str;
+            memcpy(&str, &record[*itr], sizeof(str));
+
+            size_t ref = writer.AddString(str);
+            memcpy(&record[*itr], &ref, sizeof(ref));
+        }
+
+        for (std::vector<uint32>::const_iterator itr = defaults.begin(); itr != defaults.end(); ++itr)
+        {
+            memset(&record[*itr], 0, sizeof(char*));
+        }
+
+        writer.AddRecord(recordIds[i], &record[0]);
+    }
+
+    if (writer.Save())
+    {
+        DETAIL_LOG("Saved the snapshot of %s", store.GetTableName());
+    }
 }
 
 #endif
@@ -0,0 +1,320 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "SQLStorageSnapshot.h"
+#include "DatabaseEnv.h"
+#include "DataStores/DBCFileLoader.h"
+#include "GitRevision.h"
+
+#include <ace/Mem_Map.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <cstring>
+
+namespace
+{
+    const uint32 SNAPSHOT_MAGIC   = 0x53515353;             // "SSQS"
+    const uint32 SNAPSHOT_VERSION = 1;
+
+    struct SnapshotHeader
+    {
+        uint32 magic;
+        uint32 version;
+        uint64 stamp;
+        uint32 maxEntry;
+        uint32 recordCount;
+        uint32 recordSize;
+        uint32 stringsSize;
+    };
+
+    std::string s_directory;
+
+    /// FNV-1a, the stamp only has to change when its inputs do.
+    void HashBytes(uint64& hash, void const* data, size_t size)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= UI64LIT(1099511628211);
+        }
+    }
+
+    void HashString(uint64& hash, char const* str)
+    {
+        HashBytes(hash, str, strlen(str) + 1);
+    }
+
+    std::string GetFileName(char const* table)
+    {
+        return s_directory + table + ".snapshot";
+    }
+}
+
+void SQLStorageSnapshot::SetDirectory(std::string const& directory)
+{
+    s_directory = directory;
+}
+
+std::string const& SQLStorageSnapshot::GetDirectory()
+{
+    return s_directory;
+}
+
+void SQLStorageSnapshot::GetPointerFields(char const* dstFormat, std::vector<uint32>& strings, std::vector<uint32>& defaults)
+{
+    uint32 offset = 0;
+    for (char const* format = dstFormat; *format; ++format)
+    {
+        switch (*format)
+        {
+            case DBC_FF_LOGIC:
+                offset += sizeof(bool);
+                break;
+            case DBC_FF_BYTE:
+            case DBC_FF_NA_BYTE:
+                offset += sizeof(char);
+                break;
+            case DBC_FF_INT:
+            case DBC_FF_NA:
+                offset += sizeof(uint32);
+                break;
+            case DBC_FF_FLOAT:
+            case DBC_FF_NA_FLOAT:
+                offset += sizeof(float);
+                break;
+            case DBC_FF_STRING:
+                strings.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            case DBC_FF_NA_POINTER:
+                defaults.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool SQLStorageSnapshot::GetStamp(char const* table, char const* srcFormat, char const* dstFormat, uint32 recordSize, uint64& stamp)
+{
+    // script names are stored as ids, which change with the bound names
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE `%s`, `script_binding`", table);
+    if (!result)
+    {
+        return false;
+    }
+
+    uint64 hash = UI64LIT(14695981039346656037);
+    uint32 pointerSize = sizeof(char*);
+    HashBytes(hash, &SNAPSHOT_VERSION, sizeof(SNAPSHOT_VERSION));
+    HashBytes(hash, &pointerSize, sizeof(pointerSize));
+    HashBytes(hash, &recordSize, sizeof(recordSize));
+    HashString(hash, GitRevision::GetFullRevision());
+    HashString(hash, srcFormat);
+    HashString(hash, dstFormat);
+
+    do
+    {
+        Field* fields = result->Fetch();
+
+        // missing table
+        if (fields[1].IsNULL())
+        {
+            delete result;
+            return false;
+        }
+
+        uint64 checksum = fields[1].GetUInt64();
+        HashString(hash, fields[0].GetString());
+        HashBytes(hash, &checksum, sizeof(checksum));
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    stamp = hash;
+    return true;
+}
+
+SQLStorageSnapshot::Reader::Reader() :
+    m_file(NULL), m_ids(NULL), m_records(NULL), m_strings(NULL), m_maxEntry(0), m_recordCount(0), m_recordSize(0)
+{
+}
+
+SQLStorageSnapshot::Reader::~Reader()
+{
+    delete m_file;
+}
+
+bool SQLStorageSnapshot::Reader::Open(char const* table, uint64 stamp, uint32 recordSize, std::vector<uint32> const& stringFields)
+{
+    std::string fileName = GetFileName(table);
+    if (ACE_OS::access(fileName.c_str(), R_OK) != 0)
+    {
+        return false;
+    }
+
+    m_file = new ACE_Mem_Map();
+    if (m_file->map(fileName.c_str(), static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, MAP_SHARED) == -1)
+    {
+        sLog.outError("SQLStorageSnapshot: Can't map %s", fileName.c_str());
+        return false;
+    }
+
+    char const* data = static_cast<char const*>(m_file->addr());
+    size_t size = m_file->size();
+
+    SnapshotHeader header;
+    if (size < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.stamp != stamp || header.recordSize != recordSize)
+    {
+        return false;
+    }
+
+    size_t idsSize = size_t(header.recordCount) * sizeof(uint32);
+    size_t recordsSize = size_t(header.recordCount) * recordSize;
+    if (size != sizeof(header) + idsSize + recordsSize + header.stringsSize)
+    {
+        sLog.outError("SQLStorageSnapshot: %s is truncated", fileName.c_str());
+        return false;
+    }
+
+    m_ids = data + sizeof(header);
+    m_records = m_ids + idsSize;
+    m_strings = m_records + recordsSize;
+
+    // every string ends within the block as long as the block does
+    if (header.stringsSize && m_strings[header.stringsSize - 1] != '\0')
+    {
+        sLog.outError("SQLStorageSnapshot: %s has a broken string block", fileName.c_str());
+        return false;
+    }
+
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        char const* record = m_records + size_t(i) * recordSize;
+        for (std::vector<uint32>::const_iterator itr = stringFields.begin(); itr != stringFields.end(); ++itr)
+        {
+            size_t ref;
+            memcpy(&ref, record + *itr, sizeof(ref));
+            if (ref > header.stringsSize)
+            {
+                sLog.outError("SQLStorageSnapshot: %s has a broken string reference", fileName.c_str());
+                return false;
+            }
+        }
+    }
+
+    m_maxEntry = header.maxEntry;
+    m_recordCount = header.recordCount;
+    m_recordSize = recordSize;
+    return true;
+}
+
+uint32 SQLStorageSnapshot::Reader::GetRecordId(uint32 index) const
+{
+    uint32 id;
+    memcpy(&id, m_ids + size_t(index) * sizeof(uint32), sizeof(id));
+    return id;
+}
+
+SQLStorageSnapshot::Writer::Writer(char const* table, uint64 stamp, uint32 maxEntry, uint32 recordSize) :
+    m_table(table), m_stamp(stamp), m_maxEntry(maxEntry), m_recordSize(recordSize)
+{
+}
+
+size_t SQLStorageSnapshot::Writer::AddString(char const* str)
+{
+    if (!str)
+    {
+        return 0;
+    }
+
+    size_t ref = m_strings.size() + 1;
+    m_strings.insert(m_strings.end(), str, str + strlen(str) + 1);
+    return ref;
+}
+
+void SQLStorageSnapshot::Writer::AddRecord(uint32 id, char const* record)
+{
+    m_ids.push_back(id);
+    m_records.insert(m_records.end(), record, record + m_recordSize);
+}
+
+bool SQLStorageSnapshot::Writer::Save()
+{
+    SnapshotHeader header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.stamp = m_stamp;
+    header.maxEntry = m_maxEntry;
+    header.recordCount = uint32(m_ids.size());
+    header.recordSize = m_recordSize;
+    header.stringsSize = uint32(m_strings.size());
+
+    // written aside and renamed, a crash while writing leaves the old file or none
+    std::string fileName = GetFileName(m_table.c_str());
+    std::string tempName = fileName + ".tmp";
+
+    FILE* file = fopen(tempName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("SQLStorageSnapshot: Can't create %s", tempName.c_str());
+        return false;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (written && !m_ids.empty())
+    {
+        written = fwrite(&m_ids[0], sizeof(uint32), m_ids.size(), file) == m_ids.size() &&
+                  fwrite(&m_records[0], 1, m_records.size(), file) == m_records.size();
+    }
+
+    if (written && !m_strings.empty())
+    {
+        written = fwrite(&m_strings[0], 1, m_strings.size(), file) == m_strings.size();
+    }
+
+    if (fclose(file) != 0)
+    {
+        written = false;
+    }
+
+    if (!written || ACE_OS::rename(tempName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("SQLStorageSnapshot: Can't write %s", fileName.c_str());
+        ACE_OS::unlink(tempName.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,183 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_SQLSTORAGESNAPSHOT
+#define MANGOS_H_SQLSTORAGESNAPSHOT
+
+#include "Common/Common.h"
+
+#include <string>
+#include <vector>
+
+class ACE_Mem_Map;
+
+/**
+ * @brief Binary copy of a loaded SQL storage table.
+ *
+ * Once a table has been read into its storage, the records are written to
+ * <SnapshotDir>/<table>.snapshot. The next load maps that file and copies
+ * the records back, as long as the stamp still matches: the stamp is a hash
+ * of the core revision, the field formats and the checksums of the table
+ * and of `script_binding` (script names are stored as ids). Otherwise the
+ * table is read from the database and the snapshot written again.
+ *
+ * Strings are stored in a block after the records, the string fields of a
+ * record hold their offset in that block plus one, 0 for NULL. Default
+ * filled pointers are not stored and come back as NULL.
+ *
+ * The snapshot is taken right after the rows are read, the checks and
+ * fixes done by the callers still run on every load.
+ */
+namespace SQLStorageSnapshot
+{
+    /**
+     * @brief Sets the directory of the snapshot files.
+     * @param directory Directory ending with a path separator, empty disables the snapshots.
+     */
+    void SetDirectory(std::string const& directory);
+
+    /**
+     * @brief Directory of the snapshot files, empty when disabled.
+     */
+    std::string const& GetDirectory();
+
+    /**
+     * @brief Offsets of the pointer fields of a record.
+     * @param dstFormat Field format of the storage.
+     * @param strings Receives the offsets of the string fields, which are stored as references.
+     * @param defaults Receives the offsets of the default filled pointers, which are stored as NULL.
+     */
+    void GetPointerFields(char const* dstFormat, std::vector<uint32>& strings, std::vector<uint32>& defaults);
+
+    /**
+     * @brief Computes the stamp a snapshot of a table must carry to be used.
+     * @param table Name of the table.
+     * @param srcFormat Field format of the table.
+     * @param dstFormat Field format of the storage.
+     * @param recordSize Size of a stored record.
+     * @param stamp Receives the stamp.
+     * @return False if the checksum of the table is not available.
+     */
+    bool GetStamp(char const* table, char const* srcFormat, char const* dstFormat, uint32 recordSize, uint64& stamp);
+
+    /**
+     * @brief Snapshot file mapped for reading.
+     */
+    class Reader
+    {
+        public:
+            Reader();
+            ~Reader();
+
+            /**
+             * @brief Maps the snapshot of a table and checks it.
+             * @param table Name of the table.
+             * @param stamp Stamp the snapshot must carry.
+             * @param recordSize Size of a stored record.
+             * @param stringFields Offsets of the string fields, see GetPointerFields.
+             * @return False if there is no usable snapshot.
+             */
+            bool Open(char const* table, uint64 stamp, uint32 recordSize, std::vector<uint32> const& stringFields);
+
+            uint32 GetMaxEntry() const { return m_maxEntry; }
+            uint32 GetRecordCount() const { return m_recordCount; }
+
+            /**
+             * @brief Id of the record, as passed to createRecord.
+             * @param index Record index, in load order.
+             */
+            uint32 GetRecordId(uint32 index) const;
+
+            /**
+             * @brief Stored record, string fields hold string references.
+             * @param index Record index, in load order.
+             */
+            char const* GetRecord(uint32 index) const { return m_records + size_t(index) * m_recordSize; }
+
+            /**
+             * @brief Resolves a string reference of a record.
+             * @param ref Value of the string field.
+             * @return The string, NULL for a NULL reference.
+             */
+            char const* GetString(size_t ref) const { return ref ? m_strings + ref - 1 : NULL; }
+
+        private:
+            Reader(Reader const&);
+            Reader& operator=(Reader const&);
+
+            ACE_Mem_Map* m_file;
+            char const* m_ids;
+            char const* m_records;
+            char const* m_strings;
+            uint32 m_maxEntry;
+            uint32 m_recordCount;
+            uint32 m_recordSize;
+    };
+
+    /**
+     * @brief Collects the records of a storage and writes its snapshot.
+     */
+    class Writer
+    {
+        public:
+            /**
+             * @param table Name of the table.
+             * @param stamp Stamp of the table contents.
+             * @param maxEntry Highest record id plus one.
+             * @param recordSize Size of a stored record.
+             */
+            Writer(char const* table, uint64 stamp, uint32 maxEntry, uint32 recordSize);
+
+            /**
+             * @brief Adds a string to the string block.
+             * @param str String, may be NULL.
+             * @return Reference to be stored in the string field.
+             */
+            size_t AddString(char const* str);
+
+            /**
+             * @brief Adds a record, its pointer fields already replaced by references.
+             * @param id Id of the record.
+             * @param record Record data.
+             */
+            void AddRecord(uint32 id, char const* record);
+
+            /**
+             * @brief Writes the snapshot, replacing the previous one.
+             * @return False if the file could not be written.
+             */
+            bool Save();
+
+        private:
+            std::string m_table;
+            uint64 m_stamp;
+            uint32 m_maxEntry;
+            uint32 m_recordSize;
+            std::vector<uint32> m_ids;
+            std::vector<char> m_records;
+            std::vector<char> m_strings;
+    };
+}
+
+#endif
@@ -26,7 +26,15 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_time.h>
+
+/// Requests looked at for one that may run, keeps a long backlog cheap
+#define MAX_DELAY_QUEUE_SCAN 256
+
+SqlDelayThread::SqlDelayThread(Database* db, std::vector<SqlConnection*> const& conns) :
+    m_mutex(), m_condition(m_mutex), m_inFlight(0), m_barrier(false),
+    m_dbEngine(db), m_dbConnections(conns), m_nextConnection(0), m_running(true)
 {
 }
 
@@ -36,49 +44,152 @@ SqlDelayThread::~SqlDelayThread()
     ProcessRequests();
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql, uint32 orderKey)
+{
+    DelayedOperation op;
+    op.sql = sql;
+    op.orderKey = orderKey;
+
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+    m_sqlQueue.push_back(op);
+    m_condition.signal();
+    return true;
+}
+
 void SqlDelayThread::run()
 {
 #ifndef DO_POSTGRESQL
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
+    const long connIndex = m_nextConnection++;
+    SqlConnection* conn = m_dbConnections[connIndex % m_dbConnections.size()];
 
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
+    // first thread keeps the connections alive, the others only wake up for work
+    const bool pinger = connIndex == 0;
+    const ACE_Time_Value pingInterval(m_dbEngine->GetPingIntervall() / 1000, (m_dbEngine->GetPingIntervall() % 1000) * 1000);
+    ACE_Time_Value nextPing = ACE_OS::gettimeofday() + pingInterval;
 
-    uint32 loopCounter = 0;
-    while (m_running)
+    for (;;)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        ACE_Based::Thread::Sleep(loopSleepms);
+        DelayedOperation op;
+        bool ping = false;
+
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+            while (!NextOperation(op))
+            {
+                // if the running state gets turned off empty the queue before exiting
+                if (!m_running && m_sqlQueue.empty())
+                {
+#ifndef DO_POSTGRESQL
+                    mysql_thread_end();
+#endif
+                    return;
+                }
 
-        ProcessRequests();
+                if (pinger && m_running && ACE_OS::gettimeofday() >= nextPing)
+                {
+                    ping = true;
+                    break;
+                }
 
-        if ((loopCounter++) >= pingEveryLoop)
+                m_condition.wait(pinger && m_running ? &nextPing : NULL);
+            }
+        }
+
+        if (ping)
         {
-            loopCounter = 0;
             m_dbEngine->Ping();
+            nextPing = ACE_OS::gettimeofday() + pingInterval;
+            continue;
         }
-    }
 
-#ifndef DO_POSTGRESQL
-    mysql_thread_end();
-#endif
+        op.sql->Execute(conn);
+        delete op.sql;
 
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+        FinishOperation(op);
+        m_condition.broadcast();
+    }
 }
 
 void SqlDelayThread::Stop()
 {
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
     m_running = false;
+    m_condition.broadcast();
+}
+
+bool SqlDelayThread::NextOperation(DelayedOperation& op)
+{
+    if (m_barrier)
+    {
+        return false;
+    }
+
+    // keys which have an older request still waiting, their order must be kept
+    std::set<uint32> blockedKeys;
+    uint32 scanned = 0;
+
+    for (SqlQueue::iterator itr = m_sqlQueue.begin(); itr != m_sqlQueue.end() && scanned < MAX_DELAY_QUEUE_SCAN; ++itr, ++scanned)
+    {
+        if (itr->orderKey == 0)
+        {
+            // nothing passes an unkeyed request, and it only starts after all before it are done
+            if (itr != m_sqlQueue.begin() || m_inFlight)
+            {
+                return false;
+            }
+
+            op = *itr;
+            m_sqlQueue.erase(itr);
+            m_barrier = true;
+            ++m_inFlight;
+            return true;
+        }
+
+        if (m_busyKeys.find(itr->orderKey) != m_busyKeys.end() || blockedKeys.find(itr->orderKey) != blockedKeys.end())
+        {
+            blockedKeys.insert(itr->orderKey);
+            continue;
+        }
+
+        op = *itr;
+        m_sqlQueue.erase(itr);
+        m_busyKeys.insert(op.orderKey);
+        ++m_inFlight;
+        return true;
+    }
+
+    return false;
+}
+
+void SqlDelayThread::FinishOperation(DelayedOperation const& op)
+{
+    if (op.orderKey == 0)
+    {
+        m_barrier = false;
+    }
+    else
+    {
+        m_busyKeys.erase(op.orderKey);
+    }
+
+    --m_inFlight;
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    SqlOperation* s = NULL;
-    while (m_sqlQueue.next(s))
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    while (!m_sqlQueue.empty())
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        DelayedOperation op = m_sqlQueue.front();
+        m_sqlQueue.pop_front();
+
+        op.sql->Execute(m_dbConnections[0]);
+        delete op.sql;
     }
 }
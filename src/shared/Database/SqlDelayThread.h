@@ -26,31 +26,70 @@
 #define MANGOS_H_SQLDELAYTHREAD
 
 #include <ace/Thread_Mutex.h>
-#include "LockedQueue/LockedQueue.h"
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
 #include "Threading/Threading.h"
+#include "Common/Common.h"
+
+#include <deque>
+#include <set>
+#include <vector>
 
 class Database;
 class SqlOperation;
 class SqlConnection;
 
 /**
- * @brief
+ * @brief Executes the async requests of one database.
  *
+ * The same runnable is run by one thread per async connection. Requests
+ * queued with an order key are executed in queue order per key, requests
+ * with different keys may run at the same time on different connections.
+ * Requests without key (0) keep the global order: they wait until everything
+ * queued before them is done and nothing queued after them starts earlier.
  */
 class SqlDelayThread : public ACE_Based::Runnable
 {
+    private:
         /**
-         * @brief
+         * @brief A queued request with its order key.
          *
          */
-        typedef ACE_Based::LockedQueue<SqlOperation*, ACE_Thread_Mutex> SqlQueue;
+        struct DelayedOperation
+        {
+            SqlOperation* sql;
+            uint32 orderKey;
+        };
 
-    private:
+        typedef std::deque<DelayedOperation> SqlQueue;
+
+        ACE_Thread_Mutex m_mutex;                           /**< Protects everything below */
+        ACE_Condition_Thread_Mutex m_condition;             /**< Signaled on new requests, finished requests and stop */
         SqlQueue m_sqlQueue;                                /**< Queue of SQL statements */
+        std::set<uint32> m_busyKeys;                        /**< Order keys of requests being executed */
+        uint32 m_inFlight;                                  /**< Number of requests being executed */
+        bool m_barrier;                                     /**< An unkeyed request is being executed */
+
         Database* m_dbEngine;                               /**< Pointer to used Database engine */
-        SqlConnection* m_dbConnection;                      /**< Pointer to DB connection */
+        std::vector<SqlConnection*> m_dbConnections;        /**< DB connections, one per thread */
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_nextConnection; /**< Connection for the next started thread */
         volatile bool m_running; /**< TODO */
 
+        /**
+         * @brief take the next request which may run now, needs m_mutex
+         *
+         * @param op
+         * @return bool false if nothing may run right now
+         */
+        bool NextOperation(DelayedOperation& op);
+
+        /**
+         * @brief mark a request taken by NextOperation as done, needs m_mutex
+         *
+         * @param op
+         */
+        void FinishOperation(DelayedOperation const& op);
+
         /**
          * @brief process all enqueued requests
          *
@@ -62,9 +101,9 @@ class SqlDelayThread : public ACE_Based::Runnable
          * @brief
          *
          * @param db
-         * @param conn
+         * @param conns async connections, one thread has to run this per connection
          */
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, std::vector<SqlConnection*> const& conns);
         /**
          * @brief
          *
@@ -75,9 +114,10 @@ class SqlDelayThread : public ACE_Based::Runnable
          * @brief Put sql statement to delay queue
          *
          * @param sql
+         * @param orderKey requests with the same key are executed in order, 0 orders against all requests
          * @return bool
          */
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql, uint32 orderKey = 0);
 
         /**
          * @brief Stop event
@@ -174,6 +174,33 @@ bool SqlQueryHolder::SetPQuery(size_t index, const char* format, ...)
     return SetQuery(index, szQuery);
 }
 
+bool SqlQueryHolder::SetStmtQuery(size_t index, SqlStatement& stmt)
+{
+    if (m_queries.size() <= index)
+    {
+        sLog.outError("Query index (%zu) out of range (size: %zu) for statement: %i", index, m_queries.size(), stmt.ID());
+        return false;
+    }
+
+    if (m_queries[index].first != NULL || m_stmts[index].second != NULL)
+    {
+        sLog.outError("Attempt assign statement to holder index (%zu) where other query stored (New statement: %i)", index, stmt.ID());
+        return false;
+    }
+
+    SqlStmtParameters* args = stmt.detach();
+    if (args->boundParams() != stmt.arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i) for holder index (%zu)", args->boundParams(), stmt.arguments(), index);
+        delete args;
+        return false;
+    }
+
+    /// not executed yet, just stored
+    m_stmts[index] = SqlStmtPair(stmt.ID(), args);
+    return true;
+}
+
 QueryResult* SqlQueryHolder::GetResult(size_t index)
 {
     if (index < m_queries.size())
@@ -184,6 +211,11 @@ QueryResult* SqlQueryHolder::GetResult(size_t index)
             delete[](const_cast<char*>(m_queries[index].first));
             m_queries[index].first = NULL;
         }
+        if (m_stmts[index].second != NULL)
+        {
+            delete m_stmts[index].second;
+            m_stmts[index].second = NULL;
+        }
         /// when you get a result aways remember to delete it!
         return m_queries[index].second;
     }
@@ -213,6 +245,11 @@ SqlQueryHolder::~SqlQueryHolder()
             delete[](const_cast<char*>(m_queries[i].first));
             delete m_queries[i].second;
         }
+        else if (m_stmts[i].second != NULL)
+        {
+            delete m_stmts[i].second;
+            delete m_queries[i].second;
+        }
     }
 }
 
@@ -220,6 +257,7 @@ void SqlQueryHolder::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_stmts.resize(size, SqlStmtPair(-1, (SqlStmtParameters*)NULL));
 }
 
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
@@ -240,6 +278,10 @@ bool SqlQueryHolderEx::Execute(SqlConnection* conn)
         {
             m_holder->SetResult(i, conn->Query(sql));
         }
+        else if (SqlStmtParameters* params = m_holder->m_stmts[i].second)
+        {
+            m_holder->SetResult(i, conn->QueryStmt(m_holder->m_stmts[i].first, *params));
+        }
     }
 
     /// sync with the caller thread
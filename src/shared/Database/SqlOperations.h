@@ -38,6 +38,7 @@ class Database;
 class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
+class SqlStatement;
 
 /**
  * @brief
@@ -104,13 +105,15 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue; /**< TODO */
+        uint32 m_orderKey;                                  /**< async order key, see SqlDelayThread::Delay */
 
     public:
         /**
          * @brief
          *
+         * @param orderKey
          */
-        SqlTransaction() {}
+        explicit SqlTransaction(uint32 orderKey = 0) : m_orderKey(orderKey) {}
         /**
          * @brief
          *
@@ -124,6 +127,13 @@ class SqlTransaction : public SqlOperation
          */
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
 
+        /**
+         * @brief
+         *
+         * @return uint32
+         */
+        uint32 GetOrderKey() const { return m_orderKey; }
+
         /**
          * @brief
          *
@@ -241,6 +251,12 @@ class SqlQueryHolder
          */
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries; /**< TODO */
+        /**
+         * @brief prepared statement id and its bound parameters, used instead of the query string
+         *
+         */
+        typedef std::pair<int, SqlStmtParameters*> SqlStmtPair;
+        std::vector<SqlStmtPair> m_stmts; /**< same indexes as m_queries */
     public:
         /**
          * @brief
@@ -268,6 +284,17 @@ class SqlQueryHolder
          * @return bool
          */
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
+        /**
+         * @brief store a SELECT prepared statement with all its parameters bound
+         *
+         * The result is read through the binary protocol, numeric columns are not
+         * parsed from text. The parameters are taken over from the statement.
+         *
+         * @param index
+         * @param stmt
+         * @return bool
+         */
+        bool SetStmtQuery(size_t index, SqlStatement& stmt);
         /**
          * @brief
          *
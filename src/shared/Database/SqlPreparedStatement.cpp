@@ -115,6 +115,46 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+/**
+ * @brief Queue the row for a multi-row request sent by Database::FlushBatchedStmts().
+ * @return True if the row was queued (or executed), false otherwise.
+ */
+bool SqlStatement::ExecuteBatched()
+{
+    SqlStmtParameters* args = detach();
+    // verify amount of bound parameters
+    if (args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return false;
+    }
+
+    return m_pDB->ExecuteStmtBatched(m_index, args);
+}
+
+/**
+ * @brief Run the SELECT statement synchronously.
+ * @return The result set, or NULL on error or when no rows were returned.
+ */
+QueryResult* SqlStatement::Query()
+{
+    SqlStmtParameters* args = detach();
+    // verify amount of bound parameters
+    if (args->boundParams() != arguments())
+    {
+        sLog.outError("SQL ERROR: wrong amount of parameters (%i instead of %i)", args->boundParams(), arguments());
+        sLog.outError("SQL ERROR: statement: %s", m_pDB->GetStmtString(ID()).c_str());
+        MANGOS_ASSERT(false);
+        delete args;
+        return NULL;
+    }
+
+    return m_pDB->QueryStmt(m_index, args);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 /**
@@ -181,6 +221,20 @@ bool SqlPlainPreparedStatement::execute()
     return m_pConn.Execute(m_szPlainRequest.c_str());
 }
 
+/**
+ * @brief Execute the statement as a plain SQL query.
+ * @return The result set, or NULL on error or when no rows were returned.
+ */
+QueryResult* SqlPlainPreparedStatement::query()
+{
+    if (m_szPlainRequest.empty())
+    {
+        return NULL;
+    }
+
+    return m_pConn.Query(m_szPlainRequest.c_str());
+}
+
 /**
  * @brief Convert data to string format.
  * @param data The data to convert.
@@ -373,6 +373,20 @@ class SqlStatement
          * @return True if the execution was successful, false otherwise.
          */
         bool DirectExecute();
+        /**
+         * @brief Queue the row for a multi-row request sent by Database::FlushBatchedStmts().
+         *
+         * Only for INSERT statements with a single VALUES tuple, typically
+         * with ON DUPLICATE KEY UPDATE, whose rows may be written later in the tick.
+         *
+         * @return True if the row was queued (or executed), false otherwise.
+         */
+        bool ExecuteBatched();
+        /**
+         * @brief Run the SELECT statement synchronously.
+         * @return The result set, or NULL on error or when no rows were returned.
+         */
+        QueryResult* Query();
 
         // templates to simplify 1-4 parameter bindings
         template<typename ParamType1>
@@ -511,6 +525,8 @@ class SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        // holders take over bound parameters for async execution
+        friend class SqlQueryHolder;
         /**
          * @brief Constructor to create a SqlStatement object.
          * @param index The statement ID.
@@ -613,6 +629,12 @@ class SqlPreparedStatement
          */
         virtual bool execute() = 0;
 
+        /**
+         * @brief Execute the statement and read its result set.
+         * @return The result set, or NULL on error or when no rows were returned.
+         */
+        virtual QueryResult* query() = 0;
+
     protected:
         /**
          * @brief Constructor to create a SqlPreparedStatement object.
@@ -667,6 +689,12 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
          */
         bool execute() override;
 
+        /**
+         * @brief Execute the statement as a plain SQL query.
+         * @return The result set, or NULL on error or when no rows were returned.
+         */
+        QueryResult* query() override;
+
     protected:
         /**
          * @brief Convert data to string format.
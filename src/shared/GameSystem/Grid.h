@@ -31,7 +31,7 @@
 #include "TypeContainerVisitor.h"
 
 // forward declaration
-template<class A, class T, class O> class GridLoader;
+template<class A, class T, class O, class I> class GridLoader;
 
 /**
  * @brief Grid is a logical segment of the game world represented inside MaNGOS.
@@ -42,13 +42,17 @@ template<class A, class T, class O> class GridLoader;
  * a subtle difference between dynamic loader and on-demand loader but
  * this is implementation specific to the loader class.  From the
  * Grid's perspective, the loader meets its API requirement is suffice.
+ *
+ * Every object entering or leaving the grid is also passed to the
+ * POSITION_INDEX, which keeps the positions of the objects in the grid
+ * for range queries that do not need to walk the object lists.
  */
 
-template <typename ACTIVE_OBJECT, typename WORLD_CONTAINER, typename GRID_CONTAINER>
+template <typename ACTIVE_OBJECT, typename WORLD_CONTAINER, typename GRID_CONTAINER, typename POSITION_INDEX>
 class Grid
 {
         // allows the GridLoader to access its internals
-        template<class A, class T, class O> friend class GridLoader;
+        template<class A, class T, class O, class I> friend class GridLoader;
 
     public:
 
@@ -61,6 +65,7 @@ class Grid
          */
         bool AddWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_positionIndex.Insert(obj);
             return i_worldContainer.template insert<SPECIFIC_OBJECT>(obj);
         }
 
@@ -73,6 +78,7 @@ class Grid
          */
         bool RemoveWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_positionIndex.Remove(obj);
             return i_worldContainer.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -90,6 +96,7 @@ class Grid
                 m_activeGridObjects.insert(obj);
             }
 
+            i_positionIndex.Insert(obj);
             return i_gridContainer.template insert<SPECIFIC_OBJECT>(obj);
         }
 
@@ -107,6 +114,7 @@ class Grid
                 m_activeGridObjects.erase(obj);
             }
 
+            i_positionIndex.Remove(obj);
             return i_gridContainer.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -122,6 +130,13 @@ class Grid
             visitor.Visit(i_worldContainer);
         }
 
+        /**
+         * @brief Positions of the objects in the grid.
+         *
+         * @return const POSITION_INDEX
+         */
+        const POSITION_INDEX& GetPositionIndex() const { return i_positionIndex; }
+
         size_t ActiveObjectsInGrid() const
         {
             return m_activeGridObjects.size() + i_worldContainer.template count<ACTIVE_OBJECT>(nullptr);
@@ -130,6 +145,7 @@ class Grid
     private:
         GRID_CONTAINER  i_gridContainer;
         WORLD_CONTAINER i_worldContainer;
+        POSITION_INDEX  i_positionIndex;
         std::set<void*> m_activeGridObjects;
 };
 
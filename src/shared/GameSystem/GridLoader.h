@@ -33,7 +33,8 @@ template
 <
 class ACTIVE_OBJECT,
       class WORLD_OBJECT_TYPES,
-      class GRID_OBJECT_TYPES
+      class GRID_OBJECT_TYPES,
+      class POSITION_INDEX
       >
 /**
  * @brief The GridLoader is working in conjuction with the Grid and responsible
@@ -58,7 +59,7 @@ class GridLoader
          * @param grid
          * @param loader
          */
-        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, LOADER& loader)
+        void Load(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, POSITION_INDEX>& grid, LOADER& loader)
         {
             loader.Load(grid);
         }
@@ -72,7 +73,7 @@ class GridLoader
          * @param grid
          * @param stoper
          */
-        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, STOPER& stoper)
+        void Stop(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, POSITION_INDEX>& grid, STOPER& stoper)
         {
             stoper.Stop(grid);
         }
@@ -86,7 +87,7 @@ class GridLoader
          * @param grid
          * @param unloader
          */
-        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES>& grid, UNLOADER& unloader)
+        void Unload(Grid<ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES, POSITION_INDEX>& grid, UNLOADER& unloader)
         {
             unloader.Unload(grid);
         }
@@ -111,6 +111,39 @@ class ByteBuffer
          */
         ByteBuffer(const ByteBuffer& buf): _rpos(buf._rpos), _wpos(buf._wpos), _storage(buf._storage) { }
 
+        /**
+         * @brief move constructor, takes over the storage of buf
+         *
+         * @param buf
+         */
+        ByteBuffer(ByteBuffer&& buf): _rpos(buf._rpos), _wpos(buf._wpos), _storage(std::move(buf._storage))
+        {
+            buf._rpos = buf._wpos = 0;
+        }
+
+        /**
+         * @brief copy assignment
+         *
+         * @param buf
+         * @return ByteBuffer &operator
+         */
+        ByteBuffer& operator=(const ByteBuffer& buf) = default;
+
+        /**
+         * @brief move assignment, takes over the storage of buf
+         *
+         * @param buf
+         * @return ByteBuffer &operator
+         */
+        ByteBuffer& operator=(ByteBuffer&& buf)
+        {
+            _rpos = buf._rpos;
+            _wpos = buf._wpos;
+            _storage = std::move(buf._storage);
+            buf._rpos = buf._wpos = 0;
+            return *this;
+        }
+
         /**
          * @brief
          *
@@ -24,14 +24,27 @@
 
 #include "EventProcessor.h"
 
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    struct EventNodeTimeLess
+    {
+        template<class Node>
+        bool operator()(Node const* a, Node const* b) const { return a->time < b->time; }
+    };
+}
+
 /**
  * @brief Construct a new Event Processor::Event Processor object
  * Initializes member variables m_time and m_aborting.
  */
-EventProcessor::EventProcessor()
+EventProcessor::EventProcessor() :
+    m_time(0), m_aborting(false), m_wheel(NULL), m_wheelTime(0), m_count(0), m_freeNodes(NULL)
 {
-    m_time = 0;
-    m_aborting = false;
+    m_late.head = m_late.tail = NULL;
+    m_overflow.head = m_overflow.tail = NULL;
 }
 
 /**
@@ -41,6 +54,7 @@ EventProcessor::EventProcessor()
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    ReleaseStorage();
 }
 
 /**
@@ -53,13 +67,59 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // main event loop, events added by executed ones are run in the same loop if due
+    while (m_count)
     {
+        EventNode* node;
+        if (m_late.head)
+        {
+            node = PopFront(m_late);
+        }
+        else
+        {
+            uint32 index = uint32(m_wheelTime) & WHEEL_MASK;
+            uint32 pending = m_wheel->used[0] & (~uint32(0) << index);
+
+            // nothing left in this block of level 0, move on to the next one
+            if (!pending)
+            {
+                uint64 next = (m_wheelTime | WHEEL_MASK) + 1;
+                if (next > m_time)
+                {
+                    break;
+                }
+
+                m_wheelTime = next;
+                Cascade();
+                continue;
+            }
+
+            while (!(pending & (uint32(1) << index)))
+            {
+                ++index;
+            }
+
+            uint64 slotTime = (m_wheelTime & ~uint64(WHEEL_MASK)) | index;
+            if (slotTime > m_time)
+            {
+                break;
+            }
+
+            m_wheelTime = slotTime;
+
+            // one at a time, events added for the same time are queued behind the others
+            EventSlot& slot = m_wheel->slots[0][index];
+            node = PopFront(slot);
+            if (!slot.head)
+            {
+                m_wheel->used[0] &= ~(uint32(1) << index);
+            }
+        }
+
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = node->event;
+        FreeNode(node);
+        --m_count;
 
         if (!Event->to_Abort)
         {
@@ -75,6 +135,13 @@ void EventProcessor::Update(uint32 p_time)
             delete Event;
         }
     }
+
+    // nothing pending, the wheel can start over at the current time
+    if (!m_count)
+    {
+        m_wheelTime = m_time;
+        ReleaseStorage();
+    }
 }
 
 /**
@@ -87,29 +154,67 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    if (!m_count)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        return;
+    }
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
+    // take all events out, events added by Abort are scheduled normally
+    std::vector<EventNode*> events;
+    events.reserve(m_count);
 
-            if (!force)                                     // need per-element cleanup
+    while (EventNode* node = PopFront(m_late))
+    {
+        events.push_back(node);
+    }
+
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        for (uint32 index = 0; index < WHEEL_SLOTS; ++index)
+        {
+            while (EventNode* node = PopFront(m_wheel->slots[level][index]))
             {
-                m_events.erase(i_old);
+                events.push_back(node);
             }
         }
+
+        m_wheel->used[level] = 0;
+    }
+
+    while (EventNode* node = PopFront(m_overflow))
+    {
+        events.push_back(node);
+    }
+
+    // same order as Update would have run them, the slots keep the order of equal times
+    std::stable_sort(events.begin(), events.end(), EventNodeTimeLess());
+
+    m_count = 0;
+
+    // abort all existing events
+    for (std::vector<EventNode*>::const_iterator itr = events.begin(); itr != events.end(); ++itr)
+    {
+        EventNode* node = *itr;
+        BasicEvent* Event = node->event;
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+
+        if (force || Event->IsDeletable())
+        {
+            delete Event;
+            FreeNode(node);
+        }
+        else
+        {
+            // kept until the next update, which calls Abort again and deletes it
+            ++m_count;
+            Schedule(node);
+        }
     }
 
-    // fast clear event list (in force case)
-    if (force)
+    if (!m_count)
     {
-        m_events.clear();
+        ReleaseStorage();
     }
 }
 
@@ -128,7 +233,13 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     }
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    EventNode* node = AllocateNode();
+    node->event = Event;
+    node->time = e_time;
+
+    ++m_count;
+    Schedule(node);
 }
 
 /**
@@ -141,3 +252,208 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+/**
+ * @brief Takes a node from the free list, allocating a new chunk of nodes if it is empty.
+ *
+ * @return EventNode* Unlinked node.
+ */
+EventProcessor::EventNode* EventProcessor::AllocateNode()
+{
+    if (!m_freeNodes)
+    {
+        EventNode* chunk = new EventNode[NODE_CHUNK];
+        m_nodeChunks.push_back(chunk);
+
+        for (uint32 i = 0; i < NODE_CHUNK; ++i)
+        {
+            chunk[i].next = m_freeNodes;
+            m_freeNodes = &chunk[i];
+        }
+    }
+
+    EventNode* node = m_freeNodes;
+    m_freeNodes = node->next;
+    node->next = NULL;
+    return node;
+}
+
+/**
+ * @brief Frees the wheel and the nodes of a processor without pending events.
+ *
+ * Most processors (one per unit) only hold an event now and then, they
+ * don't keep the storage in between.
+ */
+void EventProcessor::ReleaseStorage()
+{
+    delete m_wheel;
+    m_wheel = NULL;
+
+    for (std::vector<EventNode*>::const_iterator itr = m_nodeChunks.begin(); itr != m_nodeChunks.end(); ++itr)
+    {
+        delete[] *itr;
+    }
+
+    std::vector<EventNode*>().swap(m_nodeChunks);
+    m_freeNodes = NULL;
+}
+
+/**
+ * @brief Returns a node to the free list.
+ *
+ * @param node Node no longer linked in any slot.
+ */
+void EventProcessor::FreeNode(EventNode* node)
+{
+    node->event = NULL;
+    node->next = m_freeNodes;
+    m_freeNodes = node;
+}
+
+/**
+ * @brief Puts an event node where it waits for its execution time.
+ *
+ * The level is the lowest one whose slot range, counted from the wheel
+ * position, contains the time. Events already due go to the late list.
+ *
+ * @param node Node with its execution time set.
+ */
+void EventProcessor::Schedule(EventNode* node)
+{
+    uint64 time = node->time;
+
+    if (!m_wheel)
+    {
+        m_wheel = new TimerWheel;
+        memset(m_wheel, 0, sizeof(TimerWheel));
+    }
+
+    if (time < m_wheelTime)
+    {
+        // keep the list ordered, after the events of the same time
+        EventNode* prev = NULL;
+        for (EventNode* itr = m_late.head; itr && itr->time <= time; itr = itr->next)
+        {
+            prev = itr;
+        }
+
+        if (!prev)
+        {
+            node->next = m_late.head;
+            m_late.head = node;
+            if (!m_late.tail)
+            {
+                m_late.tail = node;
+            }
+        }
+        else
+        {
+            node->next = prev->next;
+            prev->next = node;
+            if (m_late.tail == prev)
+            {
+                m_late.tail = node;
+            }
+        }
+        return;
+    }
+
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 shift = WHEEL_BITS * (level + 1);
+        if ((time >> shift) == (m_wheelTime >> shift))
+        {
+            uint32 index = uint32(time >> (WHEEL_BITS * level)) & WHEEL_MASK;
+            Append(m_wheel->slots[level][index], node);
+            m_wheel->used[level] |= uint32(1) << index;
+            return;
+        }
+    }
+
+    Append(m_overflow, node);
+}
+
+/**
+ * @brief Spreads the slots of the upper levels which start at the wheel position.
+ *
+ * Called when the wheel position enters a new level 0 block. The highest
+ * level goes first, its events may belong to any lower level.
+ */
+void EventProcessor::Cascade()
+{
+    uint32 top = 1;
+    while (top < WHEEL_LEVELS && !(uint32(m_wheelTime >> (WHEEL_BITS * top)) & WHEEL_MASK))
+    {
+        ++top;
+    }
+
+    if (top == WHEEL_LEVELS)
+    {
+        EventSlot overflow = m_overflow;
+        m_overflow.head = m_overflow.tail = NULL;
+
+        while (EventNode* node = PopFront(overflow))
+        {
+            Schedule(node);
+        }
+
+        --top;
+    }
+
+    for (uint32 level = top; level > 0; --level)
+    {
+        CascadeSlot(level, uint32(m_wheelTime >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    }
+}
+
+/**
+ * @brief Moves the events of a slot to the levels below.
+ *
+ * @param level Level of the slot.
+ * @param index Index of the slot.
+ */
+void EventProcessor::CascadeSlot(uint32 level, uint32 index)
+{
+    if (!(m_wheel->used[level] & (uint32(1) << index)))
+    {
+        return;
+    }
+
+    EventSlot slot = m_wheel->slots[level][index];
+    m_wheel->slots[level][index].head = m_wheel->slots[level][index].tail = NULL;
+    m_wheel->used[level] &= ~(uint32(1) << index);
+
+    while (EventNode* node = PopFront(slot))
+    {
+        Schedule(node);
+    }
+}
+
+void EventProcessor::Append(EventSlot& slot, EventNode* node)
+{
+    node->next = NULL;
+    if (slot.tail)
+    {
+        slot.tail->next = node;
+    }
+    else
+    {
+        slot.head = node;
+    }
+    slot.tail = node;
+}
+
+EventProcessor::EventNode* EventProcessor::PopFront(EventSlot& slot)
+{
+    EventNode* node = slot.head;
+    if (node)
+    {
+        slot.head = node->next;
+        if (!slot.head)
+        {
+            slot.tail = NULL;
+        }
+        node->next = NULL;
+    }
+    return node;
+}
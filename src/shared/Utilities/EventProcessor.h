@@ -26,7 +26,7 @@
 #define MANGOS_H_EVENTPROCESSOR
 
 #include "Platform/Define.h"
-#include <map>
+#include <vector>
 
 /**
  * @brief Note. All times are in milliseconds here.
@@ -82,15 +82,19 @@ class BasicEvent
         uint64 m_execTime; /**< Planned time of next execution, filled by event handler */
 };
 
-/**
- * @brief Typedef for a multimap of events
- *
- */
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
 /**
  * @brief Event Processor class
  *
+ * Pending events are kept in a hashed hierarchical timer wheel: three levels
+ * of 32 slots, a level 0 slot per millisecond, a level 1 slot per 32 ms and
+ * a level 2 slot per 1024 ms. Events further away wait in an overflow list.
+ * When the wheel enters the next 32 ms, the matching slot of the level above
+ * is spread over the level below, so adding and running an event costs a
+ * constant amount of work whatever the number of pending events. The list
+ * nodes are taken from a free list kept by the processor.
+ *
+ * Events run in the order of their execution time, events of the same time
+ * in the order they were added.
  */
 class EventProcessor
 {
@@ -140,8 +144,58 @@ class EventProcessor
 
     protected:
         uint64 m_time; /**< Current time in milliseconds */
-        EventList m_events; /**< List of events */
         bool m_aborting; /**< Flag indicating if the event processor is aborting */
+
+    private:
+        static const uint32 WHEEL_BITS = 5;
+        static const uint32 WHEEL_SLOTS = 1 << WHEEL_BITS;
+        static const uint32 WHEEL_MASK = WHEEL_SLOTS - 1;
+        static const uint32 WHEEL_LEVELS = 3;
+        static const uint32 NODE_CHUNK = 16;
+
+        struct EventNode
+        {
+            BasicEvent* event;
+            uint64 time;
+            EventNode* next;
+        };
+
+        /**
+         * @brief Events of one slot, in the order they were added.
+         */
+        struct EventSlot
+        {
+            EventNode* head;
+            EventNode* tail;
+        };
+
+        struct TimerWheel
+        {
+            EventSlot slots[WHEEL_LEVELS][WHEEL_SLOTS];
+            uint32 used[WHEEL_LEVELS]; /**< Bit per non-empty slot */
+        };
+
+        EventProcessor(EventProcessor const&);
+        EventProcessor& operator=(EventProcessor const&);
+
+        EventNode* AllocateNode();
+        void FreeNode(EventNode* node);
+        void ReleaseStorage();
+
+        void Schedule(EventNode* node);
+        void Cascade();
+        void CascadeSlot(uint32 level, uint32 index);
+
+        static void Append(EventSlot& slot, EventNode* node);
+        static EventNode* PopFront(EventSlot& slot);
+
+        TimerWheel* m_wheel; /**< Allocated with the first event, freed when none is left */
+        EventSlot m_late; /**< Events due before the wheel position, ordered by time */
+        EventSlot m_overflow; /**< Events beyond the range of the wheel */
+        uint64 m_wheelTime; /**< Time of the next level 0 slot to run, never after m_time */
+        uint32 m_count; /**< Number of pending events */
+        EventNode* m_freeNodes; /**< Free list of event nodes */
+        std::vector<EventNode*> m_nodeChunks; /**< Node allocations, released when no event is left */
 };
 
 #endif
@@ -0,0 +1,142 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_FLATMAP_H
+#define MANGOS_FLATMAP_H
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Read-only map kept as one sorted array.
+ *
+ * Meant for static data which is looked up far more often than it changes:
+ * the data is collected in a Builder (the std::map or std::multimap the
+ * load code already works with) and then frozen into the array with Assign.
+ * Lookups are binary searches over contiguous pairs, iteration walks the
+ * array, and the const interface matches the one of the std containers.
+ *
+ * Values of equal keys keep their order in the builder.
+ */
+template<class Key, class Value>
+class FlatMapBase
+{
+    public:
+        typedef Key key_type;
+        typedef Value mapped_type;
+        typedef std::pair<Key, Value> value_type;
+        typedef typename std::vector<value_type>::size_type size_type;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+        typedef const_iterator iterator;
+
+        const_iterator begin() const { return m_values.begin(); }
+        const_iterator end() const { return m_values.end(); }
+        size_type size() const { return m_values.size(); }
+        bool empty() const { return m_values.empty(); }
+
+        void clear() { std::vector<value_type>().swap(m_values); }
+
+        const_iterator lower_bound(Key const& key) const
+        {
+            return std::lower_bound(m_values.begin(), m_values.end(), key, KeyLess());
+        }
+
+        const_iterator upper_bound(Key const& key) const
+        {
+            return std::upper_bound(m_values.begin(), m_values.end(), key, KeyLess());
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(Key const& key) const
+        {
+            return std::equal_range(m_values.begin(), m_values.end(), key, KeyLess());
+        }
+
+        /**
+         * @brief Finds the first value of the key.
+         * @param key
+         * @return const_iterator end() if the key is not stored
+         */
+        const_iterator find(Key const& key) const
+        {
+            const_iterator itr = lower_bound(key);
+            return itr != m_values.end() && !(key < itr->first) ? itr : m_values.end();
+        }
+
+        size_type count(Key const& key) const
+        {
+            std::pair<const_iterator, const_iterator> bounds = equal_range(key);
+            return size_type(bounds.second - bounds.first);
+        }
+
+    protected:
+        /**
+         * @brief Replaces the content by the one of a sorted container.
+         * @param source std::map or std::multimap
+         */
+        template<class Source>
+        void AssignSorted(Source const& source)
+        {
+            std::vector<value_type> values;
+            values.reserve(source.size());
+            values.assign(source.begin(), source.end());
+            m_values.swap(values);
+        }
+
+    private:
+        struct KeyLess
+        {
+            bool operator()(value_type const& value, Key const& key) const { return value.first < key; }
+            bool operator()(Key const& key, value_type const& value) const { return key < value.first; }
+        };
+
+        std::vector<value_type> m_values;
+};
+
+/**
+ * @brief FlatMapBase with unique keys, built from a std::map.
+ */
+template<class Key, class Value>
+class FlatMap : public FlatMapBase<Key, Value>
+{
+    public:
+        typedef std::map<Key, Value> Builder;
+
+        void Assign(Builder const& source) { this->AssignSorted(source); }
+};
+
+/**
+ * @brief FlatMapBase with repeated keys, built from a std::multimap.
+ */
+template<class Key, class Value>
+class FlatMultiMap : public FlatMapBase<Key, Value>
+{
+    public:
+        typedef std::multimap<Key, Value> Builder;
+
+        void Assign(Builder const& source) { this->AssignSorted(source); }
+};
+
+#endif
@@ -29,6 +29,8 @@
 #include "ByteBuffer.h"
 #include "Opcodes.h"
 
+#include <memory>
+
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
 /**
@@ -60,6 +62,17 @@ class WorldPacket : public ByteBuffer
         WorldPacket(const WorldPacket& packet) : ByteBuffer(packet), m_opcode(packet.m_opcode)
         {
         }
+        /**
+         * @brief move constructor
+         *
+         * @param packet
+         */
+        WorldPacket(WorldPacket&& packet) : ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode)
+        {
+        }
+
+        WorldPacket& operator=(const WorldPacket& packet) = default;
+        WorldPacket& operator=(WorldPacket&& packet) = default;
 
         /**
          * @brief
@@ -96,4 +109,57 @@ class WorldPacket : public ByteBuffer
     protected:
         uint16 m_opcode; /**< TODO */
 };
+
+/**
+ * @brief A packet sent to several receivers.
+ *
+ * Receivers which can take the packet right away write it straight out of the
+ * referenced packet. The payload is copied at most once, when the first receiver
+ * has to queue it, and all queued receivers then share that immutable copy.
+ * Not thread safe, build one per broadcast.
+ */
+class SharedWorldPacket
+{
+    public:
+        typedef std::shared_ptr<WorldPacket const> PacketPtr;
+
+        /**
+         * @brief references packet, which has to outlive this object
+         *
+         * @param packet
+         */
+        explicit SharedWorldPacket(WorldPacket const& packet) : m_packet(&packet) {}
+        /**
+         * @brief takes over packet
+         *
+         * @param packet
+         */
+        explicit SharedWorldPacket(WorldPacket&& packet) : m_shared(std::make_shared<WorldPacket const>(std::move(packet))), m_packet(m_shared.get()) {}
+
+        /**
+         * @brief
+         *
+         * @return const WorldPacket
+         */
+        WorldPacket const& Get() const { return *m_packet; }
+
+        /**
+         * @brief refcounted payload which can be queued without copying it again
+         *
+         * @return const PacketPtr
+         */
+        PacketPtr const& Share() const
+        {
+            if (!m_shared)
+            {
+                m_shared = std::make_shared<WorldPacket const>(*m_packet);
+                m_packet = m_shared.get();
+            }
+            return m_shared;
+        }
+
+    private:
+        mutable PacketPtr m_shared; /**< set once the payload has been copied */
+        mutable WorldPacket const* m_packet; /**< TODO */
+};
 #endif
@@ -0,0 +1,336 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file bench_cell_sweep.cpp
+ * @brief Range queries over grid cell lists against the cell position index.
+ *
+ * Spreads 10000 objects over a synthetic map of 33.3 yard cells and runs
+ * area queries for units around random objects, with the same cell
+ * selection as Cell::VisitPositionIndex. Each query runs two ways:
+ * - list walk: like a TypeContainerVisitor over the creature and player
+ *   lists of each cell. Every list node leads to its object, which is
+ *   read for its position.
+ * - index sweep: like CellPositionIndex::Sweep. The coordinate arrays of
+ *   each cell are tested in blocks of 64, and only the matches are read.
+ *
+ * The game library needs a whole world to create objects, so the
+ * benchmark uses stand-ins. They have about the size of a Creature and
+ * are allocated in a shuffled order, as the grid loader spawns them by
+ * guid and not by position. The lists and arrays follow the layout of
+ * GridRefManager and CellPositionIndex.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    typedef unsigned char uint8;
+    typedef unsigned short uint16;
+    typedef unsigned int uint32;
+    typedef unsigned long long uint64;
+
+    // TypeMask values of ObjectGuid.h
+    const uint16 TYPEMASK_UNIT       = 0x0008;
+    const uint16 TYPEMASK_PLAYER     = 0x0010;
+    const uint16 TYPEMASK_GAMEOBJECT = 0x0020;
+
+    const float SIZE_OF_GRID_CELL = 533.33333f / 16;
+    const size_t SWEEP_BLOCK = 64;
+
+    struct BenchObject;
+
+    /// GridReference: intrusive list node inside the object
+    struct GridRef
+    {
+        GridRef* next;
+        GridRef* prev;
+        BenchObject* source;
+    };
+
+    /// Stand-in for a Creature, fields at about the offsets they have in WorldObject and Unit.
+    struct BenchObject
+    {
+        void* vtable;
+        uint16 typeMask;                                    // Object::m_objectTypeMask
+        char objectFields[300];
+        float x, y, z, orientation;                         // WorldObject::m_position
+        float boundingRadius;
+        char unitFields[1200];
+        uint32 health;
+        char creatureFields[900];
+        GridRef gridRef;                                    // GridObject<T>::m_gridRef
+    };
+
+    struct CellLists
+    {
+        CellLists() : creatures(NULL), players(NULL), gameobjects(NULL) {}
+
+        GridRef* creatures;
+        GridRef* players;
+        GridRef* gameobjects;
+    };
+
+    /// Same arrays as CellPositionIndex.
+    struct CellArrays
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> reach;
+        std::vector<uint16> typeMask;
+        std::vector<BenchObject*> objects;
+    };
+
+    struct SyntheticMap
+    {
+        int cellsPerSide;
+        std::vector<CellLists> lists;
+        std::vector<CellArrays> arrays;
+        std::vector<BenchObject*> objects;
+    };
+
+    void Link(GridRef*& head, BenchObject* obj)
+    {
+        obj->gridRef.source = obj;
+        obj->gridRef.prev = NULL;
+        obj->gridRef.next = head;
+        if (head)
+        {
+            head->prev = &obj->gridRef;
+        }
+        head = &obj->gridRef;
+    }
+
+    void BuildMap(SyntheticMap& map, int objectCount, int cellsPerSide)
+    {
+        std::mt19937 rng(5875);
+        std::uniform_real_distribution<float> coord(0.0f, cellsPerSide * SIZE_OF_GRID_CELL);
+
+        map.cellsPerSide = cellsPerSide;
+        map.lists.assign(cellsPerSide * cellsPerSide, CellLists());
+        map.arrays.assign(cellsPerSide * cellsPerSide, CellArrays());
+
+        // allocate with other memory in between and in an order unrelated to the position
+        std::vector<char*> padding;
+        for (int i = 0; i < objectCount; ++i)
+        {
+            map.objects.push_back(new BenchObject());
+            padding.push_back(new char[64 + rng() % 512]);
+        }
+        std::shuffle(map.objects.begin(), map.objects.end(), rng);
+
+        for (int i = 0; i < objectCount; ++i)
+        {
+            BenchObject* obj = map.objects[i];
+            obj->x = coord(rng);
+            obj->y = coord(rng);
+            obj->boundingRadius = 0.4f + (rng() % 10) * 0.1f;
+            obj->health = 100 + rng() % 1000;
+
+            uint32 kind = rng() % 10;
+            obj->typeMask = kind < 8 ? TYPEMASK_UNIT : kind < 9 ? uint16(TYPEMASK_UNIT | TYPEMASK_PLAYER) : TYPEMASK_GAMEOBJECT;
+
+            int cell = int(obj->y / SIZE_OF_GRID_CELL) * cellsPerSide + int(obj->x / SIZE_OF_GRID_CELL);
+            CellLists& lists = map.lists[cell];
+            Link(kind < 8 ? lists.creatures : kind < 9 ? lists.players : lists.gameobjects, obj);
+
+            CellArrays& arrays = map.arrays[cell];
+            arrays.x.push_back(obj->x);
+            arrays.y.push_back(obj->y);
+            arrays.reach.push_back(obj->boundingRadius);
+            arrays.typeMask.push_back(obj->typeMask);
+            arrays.objects.push_back(obj);
+        }
+
+        for (size_t i = 0; i < padding.size(); ++i)
+        {
+            delete[] padding[i];
+        }
+    }
+
+    /// Visitor of the query, touches every match like a spell target check would.
+    struct TargetCounter
+    {
+        TargetCounter() : count(0), sum(0) {}
+
+        void operator()(BenchObject* obj)
+        {
+            ++count;
+            sum += obj->health;
+        }
+
+        uint64 count;
+        uint64 sum;
+    };
+
+    template<class F>
+    void WalkList(GridRef const* ref, float x, float y, float radius, F& func)
+    {
+        for (; ref; ref = ref->next)
+        {
+            BenchObject* obj = ref->source;
+            float const dx = obj->x - x;
+            float const dy = obj->y - y;
+            float const reach = radius + obj->boundingRadius;
+            if (dx * dx + dy * dy <= reach * reach)
+            {
+                func(obj);
+            }
+        }
+    }
+
+    template<class F>
+    void Sweep(CellArrays const& cell, float x, float y, float radius, uint16 typeMask, F& func)
+    {
+        size_t const count = cell.objects.size();
+        for (size_t begin = 0; begin < count; begin += SWEEP_BLOCK)
+        {
+            size_t const end = std::min(count, begin + SWEEP_BLOCK);
+
+            uint8 hits[SWEEP_BLOCK];
+            for (size_t i = begin; i < end; ++i)
+            {
+                float const dx = cell.x[i] - x;
+                float const dy = cell.y[i] - y;
+                float const reach = radius + cell.reach[i];
+                hits[i - begin] = uint8(dx * dx + dy * dy <= reach * reach) & uint8((cell.typeMask[i] & typeMask) != 0);
+            }
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                if (hits[i - begin])
+                {
+                    func(cell.objects[i]);
+                }
+            }
+        }
+    }
+
+    template<bool UseIndex>
+    void Query(SyntheticMap const& map, float x, float y, float radius, TargetCounter& counter)
+    {
+        int const last = map.cellsPerSide - 1;
+        int const lowX = std::max(0, int((x - radius) / SIZE_OF_GRID_CELL));
+        int const highX = std::min(last, int((x + radius) / SIZE_OF_GRID_CELL));
+        int const lowY = std::max(0, int((y - radius) / SIZE_OF_GRID_CELL));
+        int const highY = std::min(last, int((y + radius) / SIZE_OF_GRID_CELL));
+
+        for (int cy = lowY; cy <= highY; ++cy)
+        {
+            for (int cx = lowX; cx <= highX; ++cx)
+            {
+                int const cell = cy * map.cellsPerSide + cx;
+                if (UseIndex)
+                {
+                    Sweep(map.arrays[cell], x, y, radius, TYPEMASK_UNIT, counter);
+                }
+                else
+                {
+                    // the unit visitor only walks the creature and player containers
+                    WalkList(map.lists[cell].creatures, x, y, radius, counter);
+                    WalkList(map.lists[cell].players, x, y, radius, counter);
+                }
+            }
+        }
+    }
+
+    template<bool UseIndex>
+    double Run(SyntheticMap const& map, std::vector<BenchObject*> const& centers, float radius, TargetCounter& counter)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < centers.size(); ++i)
+        {
+            Query<UseIndex>(map, centers[i]->x, centers[i]->y, radius, counter);
+        }
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    void Scenario(const char* name, int objectCount, int cellsPerSide, int queries)
+    {
+        SyntheticMap map;
+        BuildMap(map, objectCount, cellsPerSide);
+
+        std::mt19937 rng(6005);
+        std::vector<BenchObject*> centers;
+        for (int i = 0; i < queries; ++i)
+        {
+            centers.push_back(map.objects[rng() % map.objects.size()]);
+        }
+
+        printf("%s: %d objects on %dx%d cells, %.1f per cell\n", name, objectCount, cellsPerSide, cellsPerSide,
+               double(objectCount) / (cellsPerSide * cellsPerSide));
+
+        static const float radii[] = { 8.0f, 20.0f, 30.0f };
+        for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); ++r)
+        {
+            TargetCounter walked, swept;
+            double walkTime = 0, sweepTime = 0;
+
+            // alternate the paths so both run with the same cache state
+            for (int round = 0; round < 3; ++round)
+            {
+                walkTime += Run<false>(map, centers, radii[r], walked);
+                sweepTime += Run<true>(map, centers, radii[r], swept);
+            }
+
+            if (walked.count != swept.count || walked.sum != swept.sum)
+            {
+                printf("  results differ: %llu against %llu targets\n", walked.count, swept.count);
+            }
+
+            double const total = 3.0 * centers.size();
+            printf("  radius %4.1f  %6.1f targets  list walk %10.0f queries/s  index sweep %10.0f queries/s  %.2fx\n",
+                   radii[r], walked.count / total, total / walkTime, total / sweepTime, walkTime / sweepTime);
+        }
+
+        for (size_t i = 0; i < map.objects.size(); ++i)
+        {
+            delete map.objects[i];
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int objects = argc > 1 ? atoi(argv[1]) : 10000;
+    int queries = argc > 2 ? atoi(argv[2]) : 100000;
+
+    if (objects <= 0 || queries <= 0)
+    {
+        printf("Usage: %s [objects] [queries]\n", argv[0]);
+        return 1;
+    }
+
+    // one crowded grid, like a capital city, and 4x4 grids of open world
+    Scenario("crowded", objects, 16, queries);
+    Scenario("open world", objects, 64, queries);
+    return 0;
+}
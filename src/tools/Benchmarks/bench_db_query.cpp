@@ -0,0 +1,219 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file bench_db_query.cpp
+ * @brief Text protocol PQuery against binary protocol prepared statements.
+ *
+ * Runs two queries of the player login against a characters database,
+ * once with PQuery and once as a prepared statement, and reads every
+ * column with its typed getter:
+ * - the character row, one row of mostly numeric columns
+ * - the spell list, many rows of three integers
+ *
+ * Reports queries per second and the time spent reading the fields of
+ * the result, which is where the text protocol parses every value.
+ */
+
+#include "Database/DatabaseEnv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+DatabaseType CharacterDatabase;
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct QueryDef
+    {
+        const char* name;
+        const char* columns;
+        const char* table;
+        const char* types;                                  ///< getter per column: u uint32, f float, s string
+        SqlStatementID stmt;
+    };
+
+    QueryDef s_queries[] =
+    {
+        {
+            "characters row",
+            "`guid`, `account`, `name`, `race`, `class`, `gender`, `level`, `xp`, `money`, `playerBytes`, `playerBytes2`,"
+            "`position_x`, `position_y`, `position_z`, `map`, `orientation`, `totaltime`, `leveltime`, `rest_bonus`,"
+            "`logout_time`, `health`, `power1`, `power2`, `power3`, `power4`, `power5`",
+            "characters",
+            "uusuuuuuuuufffufuufuuuuuuu",
+            SqlStatementID()
+        },
+        {
+            "character_spell rows",
+            "`spell`, `active`, `disabled`",
+            "character_spell",
+            "uuu",
+            SqlStatementID()
+        }
+    };
+
+    struct Result
+    {
+        Result() : queries(0), rows(0), total(0), read(0) {}
+
+        uint32 queries;
+        uint64 rows;
+        double total;                                       ///< seconds for query and read
+        double read;                                        ///< seconds for reading the fields only
+    };
+
+    double Seconds(Clock::time_point from, Clock::time_point to)
+    {
+        return std::chrono::duration<double>(to - from).count();
+    }
+
+    /// Read every field with its typed getter, returns a checksum so nothing is optimized out.
+    uint64 ReadResult(QueryResult* result, const char* types, uint64& rows)
+    {
+        uint64 sum = 0;
+        do
+        {
+            Field* fields = result->Fetch();
+            for (uint32 i = 0; types[i]; ++i)
+            {
+                switch (types[i])
+                {
+                    case 'u': sum += fields[i].GetUInt32(); break;
+                    case 'f': sum += uint64(fields[i].GetFloat()); break;
+                    default:  sum += fields[i].GetCppString().size(); break;
+                }
+            }
+            ++rows;
+        }
+        while (result->NextRow());
+
+        return sum;
+    }
+
+    uint64 Measure(bool prepared, QueryDef& query, uint32 guid, uint32 iterations, Result& res)
+    {
+        std::string sql = std::string("SELECT ") + query.columns + " FROM `" + query.table + "` WHERE `guid` = ";
+        std::string stmtSql = sql + "?";
+        uint64 sum = 0;
+
+        Clock::time_point start = Clock::now();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            QueryResult* result;
+            if (prepared)
+            {
+                SqlStatement stmt = CharacterDatabase.CreateStatement(query.stmt, stmtSql.c_str());
+                stmt.addUInt32(guid);
+                result = stmt.Query();
+            }
+            else
+            {
+                result = CharacterDatabase.PQuery("%s%u", sql.c_str(), guid);
+            }
+
+            if (!result)
+            {
+                continue;
+            }
+
+            Clock::time_point readStart = Clock::now();
+            sum += ReadResult(result, query.types, res.rows);
+            res.read += Seconds(readStart, Clock::now());
+
+            delete result;
+            ++res.queries;
+        }
+        res.total += Seconds(start, Clock::now());
+
+        return sum;
+    }
+
+    void Report(const char* name, const Result& text, const Result& binary)
+    {
+        const Result* results[2] = { &text, &binary };
+        const char* paths[2] = { "PQuery (text)", "prepared (binary)" };
+
+        printf("%s\n", name);
+        for (int i = 0; i < 2; ++i)
+        {
+            const Result& r = *results[i];
+            if (!r.queries)
+            {
+                printf("  %-18s no rows, check the guid\n", paths[i]);
+                continue;
+            }
+
+            printf("  %-18s %9.0f queries/s %9.2f us/query %9.3f us/query reading %llu rows\n", paths[i],
+                   r.queries / r.total, r.total * 1e6 / r.queries, r.read * 1e6 / r.queries,
+                   (unsigned long long)(r.rows / r.queries));
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s \"host;port;user;password;characters\" <character guid> [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    uint32 guid = uint32(atoi(argv[2]));
+    uint32 iterations = argc > 3 ? uint32(atoi(argv[3])) : 10000;
+
+    if (!CharacterDatabase.Initialize(argv[1]))
+    {
+        printf("Cannot connect to the characters database\n");
+        return 1;
+    }
+
+    uint64 sum = 0;
+
+    for (size_t q = 0; q < sizeof(s_queries) / sizeof(s_queries[0]); ++q)
+    {
+        QueryDef& query = s_queries[q];
+        Result text, binary, warmup;
+
+        // warm up the statement and the server, then alternate so both paths see the same load
+        sum += Measure(true, query, guid, 100, warmup);
+        sum += Measure(false, query, guid, 100, warmup);
+
+        for (int round = 0; round < 4; ++round)
+        {
+            sum += Measure(false, query, guid, iterations / 4, text);
+            sum += Measure(true, query, guid, iterations / 4, binary);
+        }
+
+        Report(query.name, text, binary);
+    }
+
+    printf("checksum %llu\n", (unsigned long long)sum);
+
+    CharacterDatabase.HaltDelayThread();
+    return 0;
+}
@@ -0,0 +1,279 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file bench_event_churn.cpp
+ * @brief Event churn of a crowded map, timer wheel against the old multimap.
+ *
+ * Simulates the EventProcessor of every unit on a crowded map, updated
+ * once per map tick, with the events units really schedule:
+ * - relocation notifies, added when a unit moves and run once
+ * - spell casts, whose SpellEvent re-adds itself every tick until the
+ *   cast ends
+ * - delayed spell effects and timers of several seconds
+ * - despawns, which kill all pending events of the unit
+ *
+ * The same simulation runs on the current EventProcessor (timer wheel)
+ * and on MultimapEventProcessor, a copy of the std::multimap
+ * implementation it replaced. Both get the same random sequence.
+ */
+
+#include "Utilities/EventProcessor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// The EventProcessor before the timer wheel.
+    class MultimapEventProcessor
+    {
+        public:
+            MultimapEventProcessor() : m_time(0), m_aborting(false) {}
+            ~MultimapEventProcessor() { KillAllEvents(true); }
+
+            void Update(uint32 p_time)
+            {
+                m_time += p_time;
+
+                EventList::iterator i;
+                while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+                {
+                    BasicEvent* Event = i->second;
+                    m_events.erase(i);
+
+                    if (!Event->to_Abort)
+                    {
+                        if (Event->Execute(m_time, p_time))
+                        {
+                            delete Event;
+                        }
+                    }
+                    else
+                    {
+                        Event->Abort(m_time);
+                        delete Event;
+                    }
+                }
+            }
+
+            void KillAllEvents(bool force)
+            {
+                m_aborting = true;
+
+                for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+                {
+                    EventList::iterator i_old = i;
+                    ++i;
+
+                    i_old->second->to_Abort = true;
+                    i_old->second->Abort(m_time);
+                    if (force || i_old->second->IsDeletable())
+                    {
+                        delete i_old->second;
+
+                        if (!force)
+                        {
+                            m_events.erase(i_old);
+                        }
+                    }
+                }
+
+                if (force)
+                {
+                    m_events.clear();
+                }
+            }
+
+            void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true)
+            {
+                if (set_addtime)
+                {
+                    Event->m_addTime = m_time;
+                }
+
+                Event->m_execTime = e_time;
+                m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+            }
+
+            uint64 CalculateTime(uint64 t_offset) const { return m_time + t_offset; }
+
+        private:
+            typedef std::multimap<uint64, BasicEvent*> EventList;
+
+            uint64 m_time;
+            bool m_aborting;
+            EventList m_events;
+    };
+
+    struct Counters
+    {
+        Counters() : added(0), executed(0) {}
+
+        uint64 added;
+        uint64 executed;
+    };
+
+    /// Event run once, like RelocationNotifyEvent or a delayed spell effect.
+    class OneShotEvent : public BasicEvent
+    {
+        public:
+            explicit OneShotEvent(Counters& counters) : m_counters(counters) {}
+
+            bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+            {
+                ++m_counters.executed;
+                return true;
+            }
+
+        private:
+            Counters& m_counters;
+    };
+
+    /// Re-adds itself for the next tick until the cast ends, like SpellEvent.
+    template<class Processor>
+    class CastEvent : public BasicEvent
+    {
+        public:
+            CastEvent(Processor& events, Counters& counters, uint64 castEnd) : m_events(events), m_counters(counters), m_castEnd(castEnd) {}
+
+            bool Execute(uint64 e_time, uint32 /*p_time*/) override
+            {
+                ++m_counters.executed;
+                if (e_time >= m_castEnd)
+                {
+                    return true;
+                }
+
+                ++m_counters.added;
+                m_events.AddEvent(this, e_time + 1, false);
+                return false;
+            }
+
+        private:
+            Processor& m_events;
+            Counters& m_counters;
+            uint64 m_castEnd;
+    };
+
+    template<class Processor>
+    double Simulate(int units, int ticks, uint32 tickTime, Counters& counters)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        std::mt19937 rng(5875);
+        std::vector<Processor*> processors;
+        for (int i = 0; i < units; ++i)
+        {
+            processors.push_back(new Processor());
+        }
+
+        Clock::time_point start = Clock::now();
+        for (int tick = 0; tick < ticks; ++tick)
+        {
+            for (int i = 0; i < units; ++i)
+            {
+                Processor& events = *processors[i];
+                uint32 roll = rng() % 1000;
+
+                // a third of the units move, each move schedules an AI notify
+                if (roll < 330)
+                {
+                    events.AddEvent(new OneShotEvent(counters), events.CalculateTime(1000));
+                    ++counters.added;
+                }
+                // a cast of 1.5 to 3 seconds, with a delayed effect after it
+                if (roll < 40)
+                {
+                    uint64 castEnd = events.CalculateTime(1500 + rng() % 1500);
+                    events.AddEvent(new CastEvent<Processor>(events, counters, castEnd), events.CalculateTime(1));
+                    events.AddEvent(new OneShotEvent(counters), castEnd + rng() % 1000);
+                    counters.added += 2;
+                }
+                // timers of a few seconds up to a minute
+                if (roll < 20)
+                {
+                    events.AddEvent(new OneShotEvent(counters), events.CalculateTime(2000 + rng() % 58000));
+                    ++counters.added;
+                }
+                // a despawn throws away whatever is pending
+                if (roll == 999)
+                {
+                    events.KillAllEvents(false);
+                }
+
+                events.Update(tickTime);
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (int i = 0; i < units; ++i)
+        {
+            delete processors[i];
+        }
+        return seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int units = argc > 1 ? atoi(argv[1]) : 5000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 120;
+    uint32 tickTime = 100;
+
+    if (units <= 0 || seconds <= 0)
+    {
+        printf("Usage: %s [units] [simulated seconds]\n", argv[0]);
+        return 1;
+    }
+
+    int ticks = seconds * 1000 / tickTime;
+    printf("%d units, %d map ticks of %u ms\n", units, ticks, tickTime);
+
+    Counters wheelCount, multimapCount;
+    double multimapTime = Simulate<MultimapEventProcessor>(units, ticks, tickTime, multimapCount);
+    double wheelTime = Simulate<EventProcessor>(units, ticks, tickTime, wheelCount);
+
+    if (wheelCount.executed != multimapCount.executed)
+    {
+        printf("executed events differ: %llu against %llu\n", (unsigned long long)wheelCount.executed, (unsigned long long)multimapCount.executed);
+    }
+
+    const Counters* counts[2] = { &multimapCount, &wheelCount };
+    const double times[2] = { multimapTime, wheelTime };
+    const char* names[2] = { "std::multimap", "timer wheel" };
+    for (int i = 0; i < 2; ++i)
+    {
+        printf("%-14s %8.3f s  %10llu added  %10llu run  %7.1f ns per event  %7.1f us per tick\n", names[i], times[i],
+               (unsigned long long)counts[i]->added, (unsigned long long)counts[i]->executed,
+               times[i] * 1e9 / counts[i]->added, times[i] * 1e6 / ticks);
+    }
+
+    printf("speedup %.2fx\n", multimapTime / wheelTime);
+    return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file bench_guid_map.cpp
+ * @brief Player lookups from all map threads, ConcurrentGuidMap against the locked map.
+ *
+ * Fills a player map and lets every map thread look up players the way a
+ * channel or guild broadcast does: a member list is walked and each member
+ * is found by guid. Meanwhile one thread logs players in and out, like the
+ * world thread does.
+ *
+ * The same load runs on ConcurrentGuidMap and on LockedGuidMap, a copy of
+ * the HashMapHolder it replaced in ObjectAccessor, an unordered_map behind
+ * an ACE_RW_Thread_Mutex. The run is repeated with 1, 2, 4 ... up to the
+ * given number of threads, so the scaling of both shows.
+ */
+
+#include "ConcurrentGuidMap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    /// Stand-in for a Player, only what the maps and the broadcast touch.
+    struct BenchPlayer
+    {
+        explicit BenchPlayer(uint32 counter) : guid(HIGHGUID_PLAYER, counter), level(1 + counter % 60) {}
+
+        ObjectGuid const& GetObjectGuid() const { return guid; }
+
+        ObjectGuid guid;
+        uint32 level;
+    };
+
+    /// ObjectAccessor::HashMapHolder before ConcurrentGuidMap.
+    class LockedGuidMap
+    {
+        public:
+            void Insert(BenchPlayer* o)
+            {
+                ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock)
+                m_objectMap[o->GetObjectGuid()] = o;
+            }
+
+            void Remove(BenchPlayer* o)
+            {
+                ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_lock)
+                m_objectMap.erase(o->GetObjectGuid());
+            }
+
+            BenchPlayer* Find(ObjectGuid guid)
+            {
+                ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_lock, NULL)
+                std::unordered_map<ObjectGuid, BenchPlayer*>::const_iterator itr = m_objectMap.find(guid);
+                return itr != m_objectMap.end() ? itr->second : NULL;
+            }
+
+        private:
+            ACE_RW_Thread_Mutex m_lock;
+            std::unordered_map<ObjectGuid, BenchPlayer*> m_objectMap;
+    };
+
+    struct Options
+    {
+        uint32 players;                                     ///< online players
+        uint32 members;                                     ///< members of a channel, looked up per message
+        uint32 loginsPerSecond;                             ///< logins and logouts of the writer thread
+        double seconds;                                     ///< length of one run
+    };
+
+    /// Map thread: walks member lists of random channels until stopped.
+    template<class Map>
+    void Broadcast(Map& map, std::vector<ObjectGuid> const& guids, uint32 members, uint32 seed,
+                   std::atomic<bool> const& stop, uint64& lookups, uint64& levels)
+    {
+        std::mt19937 rng(seed);
+        uint64 count = 0, sum = 0;
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            // members of a channel are spread over the guid range
+            size_t first = rng() % guids.size();
+            for (uint32 i = 0; i < members; ++i)
+            {
+                if (BenchPlayer* player = map.Find(guids[(first + i * 97) % guids.size()]))
+                {
+                    sum += player->level;
+                }
+            }
+            count += members;
+        }
+
+        lookups = count;
+        levels = sum;
+    }
+
+    /// World thread: logs the players out and back in, one after the other.
+    template<class Map>
+    void LoginLogout(Map& map, std::vector<BenchPlayer*> const& players, uint32 perSecond,
+                     std::atomic<bool> const& stop, uint64& writes)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        Clock::time_point start = Clock::now();
+        size_t next = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            if (writes >= uint64(elapsed * perSecond))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            BenchPlayer* player = players[next++ % players.size()];
+            map.Remove(player);
+            map.Insert(player);
+            writes += 2;
+        }
+    }
+
+    template<class Map>
+    double Run(uint32 threads, Options const& options, std::vector<BenchPlayer*> const& players,
+               std::vector<ObjectGuid> const& guids, uint64& checksum)
+    {
+        Map map;
+        for (size_t i = 0; i < players.size(); ++i)
+        {
+            map.Insert(players[i]);
+        }
+
+        std::atomic<bool> stop(false);
+        std::vector<uint64> lookups(threads, 0), levels(threads, 0);
+        std::vector<std::thread> workers;
+        uint64 writes = 0;
+
+        for (uint32 i = 0; i < threads; ++i)
+        {
+            workers.push_back(std::thread(Broadcast<Map>, std::ref(map), std::cref(guids), options.members, 5875 + i,
+                                          std::cref(stop), std::ref(lookups[i]), std::ref(levels[i])));
+        }
+        if (options.loginsPerSecond)
+        {
+            workers.push_back(std::thread(LoginLogout<Map>, std::ref(map), std::cref(players), options.loginsPerSecond,
+                                          std::cref(stop), std::ref(writes)));
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+        stop.store(true);
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            workers[i].join();
+        }
+
+        uint64 total = 0;
+        for (uint32 i = 0; i < threads; ++i)
+        {
+            total += lookups[i];
+            checksum += levels[i];
+        }
+        return total / options.seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32 maxThreads = argc > 1 ? uint32(atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+
+    Options options;
+    options.players = argc > 2 ? uint32(atoi(argv[2])) : 3000;
+    options.members = 40;
+    options.loginsPerSecond = argc > 3 ? uint32(atoi(argv[3])) : 20;
+    options.seconds = 2.0;
+
+    if (!maxThreads || !options.players)
+    {
+        printf("Usage: %s [map threads] [players] [logins per second]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<BenchPlayer*> players;
+    std::vector<ObjectGuid> guids;
+    for (uint32 i = 1; i <= options.players; ++i)
+    {
+        players.push_back(new BenchPlayer(i));
+        guids.push_back(players.back()->GetObjectGuid());
+    }
+
+    // a tenth of the looked up members are offline
+    for (uint32 i = 1; i <= options.players / 10; ++i)
+    {
+        guids.push_back(ObjectGuid(HIGHGUID_PLAYER, options.players + i));
+    }
+
+    printf("%u players, %u members per message, %u logins per second, %.0f s per run\n",
+           options.players, options.members, options.loginsPerSecond, options.seconds);
+    printf("threads     locked map lookups/s   ConcurrentGuidMap lookups/s   speedup\n");
+
+    uint64 checksum = 0;
+    for (uint32 threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        double locked = Run<LockedGuidMap>(threads, options, players, guids, checksum);
+        double concurrent = Run<ConcurrentGuidMap<BenchPlayer> >(threads, options, players, guids, checksum);
+
+        printf("%7u   %22.0f   %27.0f   %6.2fx\n", threads, locked, concurrent, concurrent / locked);
+
+        if (threads == maxThreads)
+        {
+            break;
+        }
+    }
+
+    printf("checksum %llu\n", (unsigned long long)checksum);
+
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        delete players[i];
+    }
+    return 0;
+}
@@ -0,0 +1,343 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file bench_spell_lookup.cpp
+ * @brief SpellMgr lookup maps as std::map against FlatMap.
+ *
+ * Fills the static SpellMgr maps that are read per cast with entries of
+ * about the size of a 1.12 database, once as the old std::map and
+ * std::multimap and once frozen into FlatMap and FlatMultiMap. Then it
+ * replays a cast trace against both and reports casts per second.
+ *
+ * For every cast the replay does the lookups of a cast and its aura:
+ * threat, elixir, affect mask, proc item enchant and facing flags by
+ * spell, and the equal_range of the next ranks, learned spells and skill
+ * line abilities.
+ *
+ * The trace is a file of spell ids, one per line, for example cut from a
+ * server log. Without a file the benchmark makes one up: 2 million casts
+ * of 3000 spells with a skewed frequency, a third of them without entries.
+ */
+
+#include "Utilities/FlatMap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    typedef unsigned int uint32;
+    typedef unsigned long long uint64;
+
+    /// highest spell id of a 1.12 Spell.dbc
+    const uint32 MAX_SPELL_ID = 30000;
+
+    // values of the same size as the SpellMgr entries
+    struct ThreatEntry
+    {
+        int threat;
+        float multiplier;
+        float ap_bonus;
+    };
+
+    struct LearnSpellNode
+    {
+        uint32 spell;
+        bool autoLearned;
+    };
+
+    struct SkillLineAbility
+    {
+        uint32 skill;
+        uint32 spell;
+        uint32 racemask;
+        uint32 classmask;
+    };
+
+    /// The per-cast maps, either the std containers or the flat ones.
+    template<template<class, class> class Map, template<class, class> class MultiMap>
+    struct SpellStore
+    {
+        Map<uint32, ThreatEntry> threat;
+        Map<uint32, unsigned char> elixir;
+        Map<uint32, uint64> affect;
+        Map<uint32, float> procItemEnchant;
+        Map<uint32, uint32> facingFlags;
+        MultiMap<uint32, uint32> chainNext;
+        MultiMap<uint32, LearnSpellNode> learnSpell;
+        MultiMap<uint32, SkillLineAbility const*> skillLineAbility;
+    };
+
+    template<class K, class V> using StdMap = std::map<K, V>;
+    template<class K, class V> using StdMultiMap = std::multimap<K, V>;
+
+    typedef SpellStore<StdMap, StdMultiMap> OldStore;
+    typedef SpellStore<FlatMap, FlatMultiMap> NewStore;
+
+    uint32 RandomSpell(std::mt19937& rng)
+    {
+        return 1 + rng() % MAX_SPELL_ID;
+    }
+
+    /// Allocations of a query row, which the load functions make between two map inserts.
+    void Scatter(std::vector<std::vector<char> >& rows, std::mt19937& rng)
+    {
+        rows.push_back(std::vector<char>(32 + rng() % 224));
+    }
+
+    /// Fill the old store like the SpellMgr load functions would.
+    void FillStore(OldStore& store, std::vector<SkillLineAbility>& abilities)
+    {
+        std::mt19937 rng(5875);
+
+        // without these the tree nodes would sit next to each other, which they don't in mangosd
+        std::vector<std::vector<char> > rows;
+
+        for (int i = 0; i < 400; ++i)
+        {
+            ThreatEntry entry = { int(rng() % 500), 1.0f, 0.0f };
+            store.threat[RandomSpell(rng)] = entry;
+            Scatter(rows, rng);
+        }
+        for (int i = 0; i < 300; ++i)
+        {
+            store.elixir[RandomSpell(rng)] = (unsigned char)(rng() % 3 + 1);
+            Scatter(rows, rng);
+            store.facingFlags[RandomSpell(rng)] = rng() % 2 + 1;
+            Scatter(rows, rng);
+        }
+        for (int i = 0; i < 500; ++i)
+        {
+            store.affect[RandomSpell(rng)] = (uint64(rng()) << 32) | rng();
+            Scatter(rows, rng);
+        }
+        for (int i = 0; i < 20; ++i)
+        {
+            store.procItemEnchant[RandomSpell(rng)] = 2.0f;
+            Scatter(rows, rng);
+        }
+        for (int i = 0; i < 3000; ++i)
+        {
+            store.chainNext.insert(std::make_pair(RandomSpell(rng), RandomSpell(rng)));
+            Scatter(rows, rng);
+        }
+        for (int i = 0; i < 1500; ++i)
+        {
+            LearnSpellNode node = { RandomSpell(rng), false };
+            store.learnSpell.insert(std::make_pair(RandomSpell(rng), node));
+            Scatter(rows, rng);
+        }
+
+        abilities.resize(5000);
+        for (size_t i = 0; i < abilities.size(); ++i)
+        {
+            SkillLineAbility ability = { uint32(rng() % 800), RandomSpell(rng), 0xFF, 0x7FF };
+            abilities[i] = ability;
+            store.skillLineAbility.insert(std::make_pair(ability.spell, &abilities[i]));
+            Scatter(rows, rng);
+        }
+    }
+
+    void FreezeStore(OldStore const& source, NewStore& store)
+    {
+        store.threat.Assign(source.threat);
+        store.elixir.Assign(source.elixir);
+        store.affect.Assign(source.affect);
+        store.procItemEnchant.Assign(source.procItemEnchant);
+        store.facingFlags.Assign(source.facingFlags);
+        store.chainNext.Assign(source.chainNext);
+        store.learnSpell.Assign(source.learnSpell);
+        store.skillLineAbility.Assign(source.skillLineAbility);
+    }
+
+    std::vector<uint32> MakeTrace(OldStore const& store)
+    {
+        // spells that have entries, the ones a trace mostly hits
+        std::vector<uint32> known;
+        for (StdMultiMap<uint32, SkillLineAbility const*>::const_iterator itr = store.skillLineAbility.begin(); itr != store.skillLineAbility.end(); ++itr)
+        {
+            known.push_back(itr->first);
+        }
+        for (StdMap<uint32, ThreatEntry>::const_iterator itr = store.threat.begin(); itr != store.threat.end(); ++itr)
+        {
+            known.push_back(itr->first);
+        }
+
+        std::mt19937 rng(6005);
+        std::vector<uint32> pool;
+        for (int i = 0; i < 2000; ++i)
+        {
+            pool.push_back(known[rng() % known.size()]);
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.push_back(RandomSpell(rng));
+        }
+
+        // a few spells are cast far more often than the rest
+        std::vector<double> weights;
+        for (size_t i = 0; i < pool.size(); ++i)
+        {
+            weights.push_back(1.0 / (i % 1000 + 1));
+        }
+        std::shuffle(pool.begin(), pool.end(), rng);
+        std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+
+        std::vector<uint32> trace(2000000);
+        for (size_t i = 0; i < trace.size(); ++i)
+        {
+            trace[i] = pool[pick(rng)];
+        }
+        return trace;
+    }
+
+    bool LoadTrace(const char* file, std::vector<uint32>& trace)
+    {
+        std::ifstream in(file);
+        uint32 spell;
+        while (in >> spell)
+        {
+            trace.push_back(spell);
+        }
+        return !trace.empty();
+    }
+
+    template<class Store>
+    uint64 Replay(Store const& store, std::vector<uint32> const& trace)
+    {
+        uint64 sum = 0;
+        for (size_t i = 0; i < trace.size(); ++i)
+        {
+            uint32 spell = trace[i];
+
+            auto threat = store.threat.find(spell);
+            if (threat != store.threat.end())
+            {
+                sum += threat->second.threat;
+            }
+
+            auto elixir = store.elixir.find(spell);
+            if (elixir != store.elixir.end())
+            {
+                sum += elixir->second;
+            }
+
+            auto affect = store.affect.find(spell);
+            if (affect != store.affect.end())
+            {
+                sum += affect->second & 0xFF;
+            }
+
+            auto enchant = store.procItemEnchant.find(spell);
+            if (enchant != store.procItemEnchant.end())
+            {
+                sum += uint64(enchant->second);
+            }
+
+            auto facing = store.facingFlags.find(spell);
+            if (facing != store.facingFlags.end())
+            {
+                sum += facing->second;
+            }
+
+            auto next = store.chainNext.equal_range(spell);
+            for (auto itr = next.first; itr != next.second; ++itr)
+            {
+                sum += itr->second;
+            }
+
+            auto learn = store.learnSpell.equal_range(spell);
+            for (auto itr = learn.first; itr != learn.second; ++itr)
+            {
+                sum += itr->second.spell;
+            }
+
+            auto skill = store.skillLineAbility.equal_range(spell);
+            for (auto itr = skill.first; itr != skill.second; ++itr)
+            {
+                sum += itr->second->skill;
+            }
+        }
+        return sum;
+    }
+
+    template<class Store>
+    double Measure(const char* name, Store const& store, std::vector<uint32> const& trace, int rounds)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        double best = 0;
+        uint64 sum = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            Clock::time_point start = Clock::now();
+            sum += Replay(store, trace);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (!round || seconds < best)
+            {
+                best = seconds;
+            }
+        }
+
+        printf("%-22s %8.1f ns/cast %12.0f casts/s   (checksum %llu)\n", name, best * 1e9 / trace.size(), trace.size() / best, sum);
+        return best;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    OldStore oldStore;
+    std::vector<SkillLineAbility> abilities;
+    FillStore(oldStore, abilities);
+
+    NewStore newStore;
+    FreezeStore(oldStore, newStore);
+
+    std::vector<uint32> trace;
+    if (argc > 1)
+    {
+        if (!LoadTrace(argv[1], trace))
+        {
+            printf("Cannot read spell ids from %s\n", argv[1]);
+            return 1;
+        }
+    }
+    else
+    {
+        trace = MakeTrace(oldStore);
+    }
+
+    printf("%zu casts, best of 5 replays\n", trace.size());
+
+    double oldTime = Measure("std::map/multimap", oldStore, trace, 5);
+    double newTime = Measure("FlatMap/FlatMultiMap", newStore, trace, 5);
+
+    printf("speedup %.2fx\n", oldTime / newTime);
+    return 0;
+}
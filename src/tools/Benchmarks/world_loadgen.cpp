@@ -0,0 +1,707 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2025 MaNGOS <https://www.getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/**
+ * @file world_loadgen.cpp
+ * @brief Load generator for the world socket layer.
+ *
+ * Opens many fake client sessions against a local mangosd. Every session
+ * answers the auth challenge with a session key known in advance, so no
+ * realmd login is needed. Authenticated sessions then ping the server.
+ * Once per second the tool prints how many sessions are connected,
+ * authenticated or queued, the connect-to-auth latency and the ping round trip.
+ *
+ * The accounts are LOADGEN1 .. LOADGENn, with the session key set in the
+ * realmd database. Run with --sql to print the statements that create them.
+ *
+ * Linux only, all sessions are driven by one epoll loop.
+ */
+
+#include "Auth/BigNumber.h"
+#include "Auth/Sha1.h"
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // opcodes and values of the 1.12 protocol, see Opcodes.h and SharedDefines.h
+    const uint16 CMSG_PING           = 0x1DC;
+    const uint16 SMSG_PONG           = 0x1DD;
+    const uint16 SMSG_AUTH_CHALLENGE = 0x1EC;
+    const uint16 CMSG_AUTH_SESSION   = 0x1ED;
+    const uint16 SMSG_AUTH_RESPONSE  = 0x1EE;
+
+    const uint8 AUTH_OK              = 0x0C;
+    const uint8 AUTH_WAIT_QUEUE      = 0x1B;
+
+    const uint32 CLIENT_BUILD        = 5875;
+    const size_t SESSION_KEY_LENGTH  = 40;
+
+    /// any 40 byte number works, it only has to match the sessionkey column
+    const char* DEFAULT_SESSION_KEY =
+        "4C4F414447454E4C4F414447454E4C4F414447454E4C4F414447454E4C4F414447454E4C4F414447";
+
+    struct Options
+    {
+        Options() : host("127.0.0.1"), port(8085), sessions(1000), connectRate(200),
+            duration(60), pingInterval(30), account("LOADGEN"), sessionKey(DEFAULT_SESSION_KEY), printSql(false) {}
+
+        std::string host;
+        int port;
+        int sessions;
+        int connectRate;                                    ///< new connections per second
+        int duration;                                       ///< seconds, counted from the first connect
+        int pingInterval;                                   ///< seconds, below 27 the server counts overspeed pings
+        std::string account;
+        std::string sessionKey;
+        bool printSql;
+    };
+
+    enum SessionState
+    {
+        STATE_IDLE,                                         ///< not connected yet
+        STATE_CONNECTING,
+        STATE_CHALLENGE,                                    ///< waiting for SMSG_AUTH_CHALLENGE
+        STATE_AUTH,                                         ///< waiting for SMSG_AUTH_RESPONSE
+        STATE_ONLINE,
+        STATE_QUEUED,
+        STATE_FAILED,
+        STATE_CLOSED                                        ///< closed by the server after the login
+    };
+
+    /// The header cipher of the 1.12 client, the counterpart of AuthCrypt.
+    struct HeaderCrypt
+    {
+        HeaderCrypt() : enabled(false), sendI(0), sendJ(0), recvI(0), recvJ(0) {}
+
+        void Encrypt(uint8* data, size_t len)
+        {
+            if (!enabled)
+            {
+                return;
+            }
+
+            for (size_t t = 0; t < len; ++t)
+            {
+                sendI %= key.size();
+                uint8 x = (data[t] ^ key[sendI]) + sendJ;
+                ++sendI;
+                data[t] = sendJ = x;
+            }
+        }
+
+        void Decrypt(uint8* data, size_t len)
+        {
+            if (!enabled)
+            {
+                return;
+            }
+
+            for (size_t t = 0; t < len; ++t)
+            {
+                recvI %= key.size();
+                uint8 x = (data[t] - recvJ) ^ key[recvI];
+                ++recvI;
+                recvJ = data[t];
+                data[t] = x;
+            }
+        }
+
+        bool enabled;
+        std::vector<uint8> key;
+        size_t sendI;
+        uint8 sendJ;
+        size_t recvI;
+        uint8 recvJ;
+    };
+
+    struct Session
+    {
+        Session() : fd(-1), state(STATE_IDLE), headerDone(false), packetSize(0), opcode(0),
+            connectTime(0), nextPing(0), pingSent(0), pingSeq(0) {}
+
+        int fd;
+        SessionState state;
+        std::string account;
+        HeaderCrypt crypt;
+        std::vector<uint8> input;
+        bool headerDone;                                    ///< header of the packet in input already decrypted
+        uint16 packetSize;
+        uint16 opcode;
+        uint64 connectTime;
+        uint64 nextPing;
+        uint64 pingSent;                                    ///< 0 while no ping is outstanding
+        uint32 pingSeq;
+    };
+
+    struct Stats
+    {
+        Stats() : connected(0), online(0), queued(0), failed(0), closed(0), pongs(0) {}
+
+        int connected;
+        int online;
+        int queued;
+        int failed;
+        int closed;
+        uint64 pongs;
+        std::vector<uint64> authLatency;                    ///< microseconds, reset every report
+        std::vector<uint64> pingLatency;                    ///< microseconds, reset every report
+    };
+
+    uint64 NowMicro()
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return uint64(tv.tv_sec) * 1000000 + tv.tv_usec;
+    }
+
+    void Usage(const char* prog)
+    {
+        printf("Usage: %s [options]\n"
+               "  -h <host>      world server address (127.0.0.1)\n"
+               "  -p <port>      world server port (8085)\n"
+               "  -n <count>     sessions to open (1000)\n"
+               "  -c <rate>      new connections per second (200)\n"
+               "  -t <seconds>   run time (60)\n"
+               "  -i <seconds>   ping interval per session (30)\n"
+               "  -a <prefix>    account name prefix (LOADGEN)\n"
+               "  -k <hex>       session key of the accounts, 80 hex digits\n"
+               "  --sql          print the SQL creating the accounts and exit\n", prog);
+    }
+
+    bool ParseArgs(int argc, char** argv, Options& opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+
+            if (arg == "--sql")
+            {
+                opt.printSql = true;
+                continue;
+            }
+
+            if (arg.size() != 2 || arg[0] != '-' || i + 1 >= argc)
+            {
+                return false;
+            }
+
+            const char* value = argv[++i];
+            switch (arg[1])
+            {
+                case 'h': opt.host = value; break;
+                case 'p': opt.port = atoi(value); break;
+                case 'n': opt.sessions = atoi(value); break;
+                case 'c': opt.connectRate = atoi(value); break;
+                case 't': opt.duration = atoi(value); break;
+                case 'i': opt.pingInterval = atoi(value); break;
+                case 'a': opt.account = value; break;
+                case 'k': opt.sessionKey = value; break;
+                default:
+                    return false;
+            }
+        }
+
+        return opt.sessions > 0 && opt.connectRate > 0 && opt.duration > 0 && opt.pingInterval > 0 &&
+            opt.sessionKey.size() == SESSION_KEY_LENGTH * 2;
+    }
+
+    void PrintSql(const Options& opt)
+    {
+        printf("-- accounts for world_loadgen, run against the realmd database\n");
+        for (int i = 1; i <= opt.sessions; ++i)
+        {
+            printf("INSERT INTO `account` (`username`, `sha_pass_hash`, `sessionkey`, `v`, `s`) "
+                   "VALUES ('%s%d', '', '%s', '0', '0') ON DUPLICATE KEY UPDATE `sessionkey` = VALUES(`sessionkey`);\n",
+                   opt.account.c_str(), i, opt.sessionKey.c_str());
+        }
+    }
+
+    uint64 Percentile(std::vector<uint64>& values, int percent)
+    {
+        if (values.empty())
+        {
+            return 0;
+        }
+
+        size_t n = (values.size() - 1) * percent / 100;
+        std::nth_element(values.begin(), values.begin() + n, values.end());
+        return values[n];
+    }
+
+    class LoadGenerator
+    {
+        public:
+            explicit LoadGenerator(const Options& opt) : m_Options(opt), m_Epoll(-1), m_Sessions(opt.sessions)
+            {
+                BigNumber K;
+                K.SetHexStr(opt.sessionKey.c_str());
+                const uint8* key = K.AsByteArray(SESSION_KEY_LENGTH);
+                m_Key.assign(key, key + SESSION_KEY_LENGTH);
+
+                memset(&m_Address, 0, sizeof(m_Address));
+                m_Address.sin_family = AF_INET;
+                m_Address.sin_port = htons(uint16(opt.port));
+                inet_pton(AF_INET, opt.host.c_str(), &m_Address.sin_addr);
+
+                char name[64];
+                for (int i = 0; i < opt.sessions; ++i)
+                {
+                    snprintf(name, sizeof(name), "%s%d", opt.account.c_str(), i + 1);
+                    m_Sessions[i].account = name;
+                }
+            }
+
+            ~LoadGenerator()
+            {
+                for (size_t i = 0; i < m_Sessions.size(); ++i)
+                {
+                    if (m_Sessions[i].fd != -1)
+                    {
+                        close(m_Sessions[i].fd);
+                    }
+                }
+
+                if (m_Epoll != -1)
+                {
+                    close(m_Epoll);
+                }
+            }
+
+            int Run()
+            {
+                m_Epoll = epoll_create1(0);
+                if (m_Epoll == -1)
+                {
+                    perror("epoll_create1");
+                    return 1;
+                }
+
+                const uint64 start = NowMicro();
+                const uint64 end = start + uint64(m_Options.duration) * 1000000;
+                uint64 nextReport = start + 1000000;
+                size_t nextSession = 0;
+
+                std::vector<epoll_event> events(1024);
+
+                printf("   time  connected     online     queued     failed     closed   auth p50/p99 ms   ping p50/p99 ms\n");
+
+                for (uint64 now = start; now < end; now = NowMicro())
+                {
+                    // open connections at the configured rate
+                    size_t due = std::min(m_Sessions.size(), size_t((now - start) * m_Options.connectRate / 1000000) + 1);
+                    for (; nextSession < due; ++nextSession)
+                    {
+                        Connect(m_Sessions[nextSession], now);
+                    }
+
+                    int n = epoll_wait(m_Epoll, &events[0], int(events.size()), 10);
+                    if (n == -1 && errno != EINTR)
+                    {
+                        perror("epoll_wait");
+                        return 1;
+                    }
+
+                    now = NowMicro();
+                    for (int i = 0; i < n; ++i)
+                    {
+                        Session& session = m_Sessions[events[i].data.u32];
+                        if (events[i].events & EPOLLOUT)
+                        {
+                            OnConnected(session, now);
+                        }
+                        if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+                        {
+                            OnReadable(session, now);
+                        }
+                    }
+
+                    for (size_t i = 0; i < nextSession; ++i)
+                    {
+                        Session& session = m_Sessions[i];
+                        if ((session.state == STATE_ONLINE || session.state == STATE_QUEUED) && !session.pingSent && session.nextPing <= now)
+                        {
+                            SendPing(session, now);
+                        }
+                    }
+
+                    if (now >= nextReport)
+                    {
+                        Report(now - start);
+                        nextReport += 1000000;
+                    }
+                }
+
+                return 0;
+            }
+
+        private:
+            void Connect(Session& session, uint64 now)
+            {
+                session.fd = socket(AF_INET, SOCK_STREAM, 0);
+                if (session.fd == -1)
+                {
+                    Fail(session);
+                    return;
+                }
+
+                int one = 1;
+                setsockopt(session.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                fcntl(session.fd, F_SETFL, fcntl(session.fd, F_GETFL) | O_NONBLOCK);
+
+                session.connectTime = now;
+                session.state = STATE_CONNECTING;
+
+                if (connect(session.fd, (sockaddr*)&m_Address, sizeof(m_Address)) == -1 && errno != EINPROGRESS)
+                {
+                    Fail(session);
+                    return;
+                }
+
+                epoll_event ev;
+                ev.events = EPOLLIN | EPOLLOUT;
+                ev.data.u32 = uint32(&session - &m_Sessions[0]);
+                epoll_ctl(m_Epoll, EPOLL_CTL_ADD, session.fd, &ev);
+            }
+
+            void OnConnected(Session& session, uint64 /*now*/)
+            {
+                if (session.state != STATE_CONNECTING)
+                {
+                    return;
+                }
+
+                int error = 0;
+                socklen_t len = sizeof(error);
+                if (getsockopt(session.fd, SOL_SOCKET, SO_ERROR, &error, &len) == -1 || error)
+                {
+                    Fail(session);
+                    return;
+                }
+
+                // writes are a few bytes each, they never need to wait for EPOLLOUT again
+                epoll_event ev;
+                ev.events = EPOLLIN;
+                ev.data.u32 = uint32(&session - &m_Sessions[0]);
+                epoll_ctl(m_Epoll, EPOLL_CTL_MOD, session.fd, &ev);
+
+                session.state = STATE_CHALLENGE;
+                ++m_Stats.connected;
+            }
+
+            void OnReadable(Session& session, uint64 now)
+            {
+                if (session.fd == -1)
+                {
+                    return;
+                }
+
+                uint8 buffer[4096];
+                for (;;)
+                {
+                    ssize_t n = recv(session.fd, buffer, sizeof(buffer), 0);
+                    if (n > 0)
+                    {
+                        session.input.insert(session.input.end(), buffer, buffer + n);
+                        continue;
+                    }
+
+                    if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    {
+                        break;
+                    }
+
+                    Close(session);
+                    return;
+                }
+
+                // server header: uint16 size (big endian, counts the opcode), uint16 opcode
+                size_t pos = 0;
+                while (session.fd != -1)
+                {
+                    if (!session.headerDone)
+                    {
+                        if (session.input.size() - pos < 4)
+                        {
+                            break;
+                        }
+
+                        session.crypt.Decrypt(&session.input[pos], 4);
+                        session.packetSize = uint16((session.input[pos] << 8) | session.input[pos + 1]) - 2;
+                        session.opcode = uint16(session.input[pos + 2] | (session.input[pos + 3] << 8));
+                        session.headerDone = true;
+                    }
+
+                    if (session.input.size() - pos < size_t(4) + session.packetSize)
+                    {
+                        break;
+                    }
+
+                    HandlePacket(session, &session.input[pos + 4], session.packetSize, now);
+                    pos += 4 + session.packetSize;
+                    session.headerDone = false;
+                }
+
+                if (session.fd != -1)
+                {
+                    session.input.erase(session.input.begin(), session.input.begin() + pos);
+                }
+            }
+
+            void HandlePacket(Session& session, const uint8* data, size_t size, uint64 now)
+            {
+                switch (session.opcode)
+                {
+                    case SMSG_AUTH_CHALLENGE:
+                    {
+                        if (session.state != STATE_CHALLENGE || size < 4)
+                        {
+                            Fail(session);
+                            return;
+                        }
+
+                        uint32 serverSeed;
+                        memcpy(&serverSeed, data, 4);
+                        SendAuthSession(session, serverSeed);
+                        break;
+                    }
+                    case SMSG_AUTH_RESPONSE:
+                    {
+                        // a rejected login comes with a plain header, which decrypts to garbage
+                        // and leaves the session waiting until the server closes it
+                        if (session.state != STATE_AUTH || size < 1 || (data[0] != AUTH_OK && data[0] != AUTH_WAIT_QUEUE))
+                        {
+                            Fail(session);
+                            return;
+                        }
+
+                        if (data[0] == AUTH_OK)
+                        {
+                            session.state = STATE_ONLINE;
+                            ++m_Stats.online;
+                        }
+                        else
+                        {
+                            session.state = STATE_QUEUED;
+                            ++m_Stats.queued;
+                        }
+
+                        m_Stats.authLatency.push_back(now - session.connectTime);
+                        // spread the pings of all sessions over the interval
+                        session.nextPing = now + uint64(rand() % (m_Options.pingInterval * 1000)) * 1000;
+                        break;
+                    }
+                    case SMSG_PONG:
+                    {
+                        if (session.pingSent)
+                        {
+                            m_Stats.pingLatency.push_back(now - session.pingSent);
+                            ++m_Stats.pongs;
+                            session.pingSent = 0;
+                            session.nextPing = now + uint64(m_Options.pingInterval) * 1000000;
+                        }
+                        break;
+                    }
+                    default:
+                        // everything else the server sends after the login is ignored
+                        break;
+                }
+            }
+
+            void SendAuthSession(Session& session, uint32 serverSeed)
+            {
+                uint32 clientSeed = uint32(rand());
+                uint8 t[4] = { 0, 0, 0, 0 };
+
+                BigNumber K;
+                K.SetBinary(&m_Key[0], int(m_Key.size()));
+
+                // same digest WorldSocket::HandleAuthSession checks
+                Sha1Hash sha;
+                sha.UpdateData(session.account);
+                sha.UpdateData(t, 4);
+                sha.UpdateData((uint8*)&clientSeed, 4);
+                sha.UpdateData((uint8*)&serverSeed, 4);
+                sha.UpdateBigNumbers(&K, NULL);
+                sha.Finalize();
+
+                std::vector<uint8> payload;
+                Append(payload, CLIENT_BUILD);
+                Append(payload, uint32(0));
+                payload.insert(payload.end(), session.account.begin(), session.account.end());
+                payload.push_back(0);
+                Append(payload, clientSeed);
+                payload.insert(payload.end(), sha.GetDigest(), sha.GetDigest() + SHA_DIGEST_LENGTH);
+
+                session.state = STATE_AUTH;
+                SendPacket(session, CMSG_AUTH_SESSION, payload);
+
+                // the server encrypts every header after its SMSG_AUTH_RESPONSE, and expects ours encrypted from then on
+                session.crypt.key = m_Key;
+                session.crypt.enabled = true;
+            }
+
+            void SendPing(Session& session, uint64 now)
+            {
+                std::vector<uint8> payload;
+                Append(payload, ++session.pingSeq);
+                Append(payload, uint32(0));                 // latency, unknown to a fake client
+
+                session.pingSent = now;
+                SendPacket(session, CMSG_PING, payload);
+            }
+
+            void SendPacket(Session& session, uint16 opcode, const std::vector<uint8>& payload)
+            {
+                // client header: uint16 size (big endian, counts the opcode), uint32 opcode
+                std::vector<uint8> packet(6 + payload.size());
+                uint16 size = uint16(payload.size() + 4);
+                packet[0] = uint8(size >> 8);
+                packet[1] = uint8(size);
+                packet[2] = uint8(opcode);
+                packet[3] = uint8(opcode >> 8);
+                packet[4] = 0;
+                packet[5] = 0;
+                session.crypt.Encrypt(&packet[0], 6);
+
+                if (!payload.empty())
+                {
+                    memcpy(&packet[6], &payload[0], payload.size());
+                }
+
+                if (send(session.fd, &packet[0], packet.size(), MSG_NOSIGNAL) != ssize_t(packet.size()))
+                {
+                    Fail(session);
+                }
+            }
+
+            static void Append(std::vector<uint8>& buffer, uint32 value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    buffer.push_back(uint8(value >> (i * 8)));
+                }
+            }
+
+            void Fail(Session& session)
+            {
+                ++m_Stats.failed;
+                Drop(session, STATE_FAILED);
+            }
+
+            void Close(Session& session)
+            {
+                // the server closed the connection, before the login that counts as a failure
+                if (session.state != STATE_ONLINE && session.state != STATE_QUEUED)
+                {
+                    Fail(session);
+                    return;
+                }
+
+                ++m_Stats.closed;
+                Drop(session, STATE_CLOSED);
+            }
+
+            void Drop(Session& session, SessionState state)
+            {
+                if (session.state == STATE_ONLINE)
+                {
+                    --m_Stats.online;
+                }
+                else if (session.state == STATE_QUEUED)
+                {
+                    --m_Stats.queued;
+                }
+
+                if (session.state != STATE_CONNECTING && session.state != STATE_IDLE && session.fd != -1)
+                {
+                    --m_Stats.connected;
+                }
+
+                if (session.fd != -1)
+                {
+                    close(session.fd);
+                    session.fd = -1;
+                }
+
+                session.state = state;
+                session.input.clear();
+            }
+
+            void Report(uint64 elapsed)
+            {
+                printf("%6.1fs %10d %10d %10d %10d %10d %8.2f/%-8.2f %8.2f/%-8.2f\n",
+                       elapsed / 1000000.0, m_Stats.connected, m_Stats.online, m_Stats.queued, m_Stats.failed, m_Stats.closed,
+                       Percentile(m_Stats.authLatency, 50) / 1000.0, Percentile(m_Stats.authLatency, 99) / 1000.0,
+                       Percentile(m_Stats.pingLatency, 50) / 1000.0, Percentile(m_Stats.pingLatency, 99) / 1000.0);
+                fflush(stdout);
+
+                m_Stats.authLatency.clear();
+                m_Stats.pingLatency.clear();
+            }
+
+            const Options& m_Options;
+            int m_Epoll;
+            sockaddr_in m_Address;
+            std::vector<uint8> m_Key;
+            std::vector<Session> m_Sessions;
+            Stats m_Stats;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!ParseArgs(argc, argv, opt))
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    if (opt.printSql)
+    {
+        PrintSql(opt);
+        return 0;
+    }
+
+    srand(unsigned(NowMicro()));
+
+    LoadGenerator generator(opt);
+    return generator.Run();
+}